@@ -0,0 +1,298 @@
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "ecs/entityregistry.h"
+
+/*
+ * ECS benchmarks at 10k, 100k and 1M entities. Run headless, for example in CI:
+ *
+ *     ecsbenchmarks --benchmark_out=ecs_benchmarks.json --benchmark_out_format=json
+ */
+
+struct BenchPosition : public IceFairy::Component {
+    BenchPosition(float x = 0.0f, float y = 0.0f, float z = 0.0f) : x(x), y(y), z(z) { }
+
+    float x;
+    float y;
+    float z;
+};
+
+struct BenchVelocity : public IceFairy::Component {
+    BenchVelocity(float x = 1.0f, float y = 0.0f, float z = 0.0f) : x(x), y(y), z(z) { }
+
+    float x;
+    float y;
+    float z;
+};
+
+struct BenchMass : public IceFairy::Component {
+    BenchMass(float mass = 1.0f) : mass(mass) { }
+
+    float mass;
+};
+
+struct BenchDrag : public IceFairy::Component {
+    BenchDrag(float drag = 0.01f) : drag(drag) { }
+
+    float drag;
+};
+
+struct BenchDormantTag : public IceFairy::Component { };
+
+namespace IceFairy {
+    template <>
+    class JobSystem<BenchPosition> {
+    public:
+        void Execute(BenchPosition& position) {
+            position.x += 1.0f;
+        }
+    };
+
+    template <>
+    class JobSystem<BenchPosition, const BenchVelocity> {
+    public:
+        void Execute(BenchPosition& position, const BenchVelocity& velocity) {
+            position.x += velocity.x;
+            position.y += velocity.y;
+            position.z += velocity.z;
+        }
+    };
+
+    template <>
+    class JobSystem<BenchVelocity, const BenchPosition, const BenchMass, const BenchDrag> {
+    public:
+        void Execute(BenchVelocity& velocity, const BenchPosition& position, const BenchMass& mass, const BenchDrag& drag) {
+            float scale = 1.0f - drag.drag / mass.mass;
+
+            velocity.x = velocity.x * scale - position.x * 0.001f;
+            velocity.y = velocity.y * scale - position.y * 0.001f;
+            velocity.z = velocity.z * scale - position.z * 0.001f;
+        }
+    };
+}
+
+namespace {
+    const int64_t SMALL = 10000;
+    const int64_t MEDIUM = 100000;
+    const int64_t LARGE = 1000000;
+
+    // Every entity has all four components, so each system visits all of them
+    std::vector<IceFairy::EntityId> AddBodies(IceFairy::EntityRegistry& registry, size_t count) {
+        return registry.AddEntities<BenchPosition, BenchVelocity, BenchMass, BenchDrag>(count,
+            [](size_t i) { return BenchPosition((float) i, 0.0f, 0.0f); },
+            [](size_t) { return BenchVelocity(); },
+            [](size_t) { return BenchMass(); },
+            [](size_t) { return BenchDrag(); });
+    }
+
+    std::vector<IceFairy::EntityId> Shuffled(std::vector<IceFairy::EntityId> ids) {
+        std::mt19937 random(42);
+
+        std::shuffle(ids.begin(), ids.end(), random);
+        return ids;
+    }
+
+    void SetEntitiesProcessed(benchmark::State& state) {
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+}
+
+static void BM_CreateDestroyEntities(benchmark::State& state) {
+    size_t count = (size_t) state.range(0);
+    IceFairy::EntityRegistry registry;
+    std::vector<IceFairy::EntityId> ids(count);
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < count; i++) {
+            auto entity = registry.AddEntity();
+
+            entity.AddComponent<BenchPosition>((float) i);
+            entity.AddComponent<BenchVelocity>();
+            ids[i] = entity.GetId();
+        }
+
+        for (auto id : ids) {
+            registry.RemoveEntity(id);
+        }
+    }
+
+    SetEntitiesProcessed(state);
+}
+
+static void BM_CreateDestroyEntitiesBulk(benchmark::State& state) {
+    size_t count = (size_t) state.range(0);
+    IceFairy::EntityRegistry registry;
+
+    for (auto _ : state) {
+        auto ids = AddBodies(registry, count);
+
+        for (auto id : ids) {
+            registry.RemoveEntity(id);
+        }
+    }
+
+    SetEntitiesProcessed(state);
+}
+
+static void BM_AddRemoveComponent(benchmark::State& state) {
+    IceFairy::EntityRegistry registry;
+    auto ids = registry.AddEntities<BenchPosition>((size_t) state.range(0), [](size_t i) { return BenchPosition((float) i); });
+
+    for (auto _ : state) {
+        for (auto id : ids) {
+            registry.AddComponent<BenchVelocity>(id);
+        }
+
+        for (auto id : ids) {
+            registry.RemoveComponent<BenchVelocity>(id);
+        }
+    }
+
+    SetEntitiesProcessed(state);
+}
+
+static void BM_AddRemoveTag(benchmark::State& state) {
+    IceFairy::EntityRegistry registry;
+    auto ids = AddBodies(registry, (size_t) state.range(0));
+
+    for (auto _ : state) {
+        for (auto id : ids) {
+            registry.AddComponent<BenchDormantTag>(id);
+        }
+
+        for (auto id : ids) {
+            registry.RemoveComponent<BenchDormantTag>(id);
+        }
+    }
+
+    SetEntitiesProcessed(state);
+}
+
+template<typename... Ts>
+static void ScheduleSystem(benchmark::State& state, IceFairy::EntityRegistry::ExecutionMode mode) {
+    IceFairy::EntityRegistry registry;
+    auto system = std::make_shared<IceFairy::JobSystem<Ts...>>();
+
+    AddBodies(registry, (size_t) state.range(0));
+
+    for (auto _ : state) {
+        registry.Schedule(system, mode);
+        benchmark::ClobberMemory();
+    }
+
+    SetEntitiesProcessed(state);
+}
+
+static void BM_Schedule1Component(benchmark::State& state) {
+    ScheduleSystem<BenchPosition>(state, IceFairy::EntityRegistry::EXECUTION_SERIAL);
+}
+
+static void BM_Schedule2Components(benchmark::State& state) {
+    ScheduleSystem<BenchPosition, const BenchVelocity>(state, IceFairy::EntityRegistry::EXECUTION_SERIAL);
+}
+
+static void BM_Schedule4Components(benchmark::State& state) {
+    ScheduleSystem<BenchVelocity, const BenchPosition, const BenchMass, const BenchDrag>(state, IceFairy::EntityRegistry::EXECUTION_SERIAL);
+}
+
+static void BM_Schedule4ComponentsParallel(benchmark::State& state) {
+    ScheduleSystem<BenchVelocity, const BenchPosition, const BenchMass, const BenchDrag>(state, IceFairy::EntityRegistry::EXECUTION_PARALLEL);
+}
+
+static void BM_RandomAccess(benchmark::State& state) {
+    IceFairy::EntityRegistry registry;
+    auto ids = Shuffled(AddBodies(registry, (size_t) state.range(0)));
+
+    for (auto _ : state) {
+        float sum = 0.0f;
+
+        for (auto id : ids) {
+            sum += registry.Get<const BenchPosition>(id).x;
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    SetEntitiesProcessed(state);
+}
+
+static void BM_RandomAccessTryGet(benchmark::State& state) {
+    IceFairy::EntityRegistry registry;
+    auto ids = Shuffled(AddBodies(registry, (size_t) state.range(0)));
+
+    for (auto _ : state) {
+        float sum = 0.0f;
+
+        for (auto id : ids) {
+            // Nothing has the tag, so this measures the miss path
+            if (registry.TryGet<BenchDormantTag>(id) == nullptr) {
+                sum += registry.TryGet<const BenchPosition>(id)->x;
+            }
+        }
+
+        benchmark::DoNotOptimize(sum);
+    }
+
+    SetEntitiesProcessed(state);
+}
+
+// Every iteration a tenth of the entities die and are replaced, and a tenth change archetype
+static void BM_StructuralChurn(benchmark::State& state) {
+    size_t count = (size_t) state.range(0);
+    IceFairy::EntityRegistry registry;
+    auto ids = AddBodies(registry, count);
+    auto system = std::make_shared<IceFairy::JobSystem<BenchPosition, const BenchVelocity>>();
+    std::mt19937 random(42);
+    std::uniform_int_distribution<size_t> pick(0, count - 1);
+    size_t numChanges = std::max<size_t>(count / 10, 1);
+
+    for (auto _ : state) {
+        for (size_t i = 0; i < numChanges; i++) {
+            auto& id = ids[pick(random)];
+
+            registry.RemoveEntity(id);
+
+            auto entity = registry.AddEntity();
+            entity.AddComponent<BenchPosition>();
+            entity.AddComponent<BenchVelocity>();
+            entity.AddComponent<BenchMass>();
+            entity.AddComponent<BenchDrag>();
+            id = entity.GetId();
+        }
+
+        for (size_t i = 0; i < numChanges; i++) {
+            auto entity = registry.GetEntity(ids[pick(random)]);
+
+            if (entity.HasComponent<BenchDrag>()) {
+                entity.RemoveComponent<BenchDrag>();
+            }
+            else {
+                entity.AddComponent<BenchDrag>();
+            }
+        }
+
+        registry.Schedule(system);
+    }
+
+    SetEntitiesProcessed(state);
+}
+
+#define ECS_BENCHMARK(function) BENCHMARK(function)->Arg(SMALL)->Arg(MEDIUM)->Arg(LARGE)->Unit(benchmark::kMillisecond)
+
+ECS_BENCHMARK(BM_CreateDestroyEntities);
+ECS_BENCHMARK(BM_CreateDestroyEntitiesBulk);
+ECS_BENCHMARK(BM_AddRemoveComponent);
+ECS_BENCHMARK(BM_AddRemoveTag);
+ECS_BENCHMARK(BM_Schedule1Component);
+ECS_BENCHMARK(BM_Schedule2Components);
+ECS_BENCHMARK(BM_Schedule4Components);
+ECS_BENCHMARK(BM_Schedule4ComponentsParallel);
+ECS_BENCHMARK(BM_RandomAccess);
+ECS_BENCHMARK(BM_RandomAccessTryGet);
+ECS_BENCHMARK(BM_StructuralChurn);
+
+BENCHMARK_MAIN();
@@ -86,6 +86,10 @@ void _SceneNode::ApplyZRotation(const float& degrees) {
     ApplyTransformationMatrix(Matrix4f::Rotate(degrees, 0, 0, 1));
 }
 
+void _SceneNode::ApplyRotation(const Quaternionf& rotation) {
+    ApplyTransformationMatrix(Matrix4f::Rotate(rotation));
+}
+
 void _SceneNode::ApplyTransformationMatrix(const Matrix4f& matrix, bool updateRealPositions) {
 	relativeTransformationMatrix = matrix * relativeTransformationMatrix;
     relativePosition = (relativeTransformationMatrix * Vector4f(0.0f, 0.0f, 0.0f, 1.0f)).ToVector3();
@@ -6,6 +6,7 @@
 
 #include "math/vector.h"
 #include "math/matrix.h"
+#include "math/quaternion.h"
 #include "sceneobject.h"
 #include "lighting/pointlight.h"
 
@@ -92,6 +93,11 @@ namespace IceFairy {
          * \param degrees The amount to rotate the SceneNode by.
          */
         void                        ApplyZRotation(const float& degrees);
+        /*! \brief Applies a rotation to this SceneNode.
+         *
+         * \param rotation The rotation to apply, which may be several rotations composed together.
+         */
+        void                        ApplyRotation(const Quaternionf& rotation);
         /*! \brief Applies a transformation matrix to this SceneNode.
          *
          * \param transformationMatrix The transformation to apply.
@@ -47,7 +47,7 @@ CubeObject::CubeObject(float size) {
         IceFairy::Vector3f( sz,  sz, -sz),
     };
 
-    IceFairy::Vector3f normals[24] = {
+    static constexpr IceFairy::Vector3f normals[24] = {
         // Bottom
         IceFairy::Vector3f(0.0f, 0.0f, -1.0f),
         IceFairy::Vector3f(0.0f, 0.0f, -1.0f),
@@ -80,7 +80,7 @@ CubeObject::CubeObject(float size) {
         IceFairy::Vector3f(0.0f, 1.0f, 0.0f),
     };
 
-    IceFairy::Vector2f texcoords[24] = {
+    static constexpr IceFairy::Vector2f texcoords[24] = {
         IceFairy::Vector2f(1.0f, 0.0f),
         IceFairy::Vector2f(1.0f, 1.0f),
         IceFairy::Vector2f(0.0f, 1.0f),
@@ -1,11 +1,14 @@
 #include "application.h"
 
+#include "ecs/systems/vertexobjectsystem.h"
+
 using namespace IceFairy;
 
 Application::Application(int argc, char** argv) :
 	argc(argc),
 	argv(argv) {
 	entityRegistry = std::make_shared<EntityRegistry>();
+	entityRegistry->AddInitialiser(AddVertexObjectSystems);
 }
 
 void Application::Initialise() {
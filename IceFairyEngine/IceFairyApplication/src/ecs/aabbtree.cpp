@@ -0,0 +1,259 @@
+#include "aabbtree.h"
+
+IceFairy::AABBTree::AABBTree(float margin) :
+	root(NULL_NODE),
+	freeList(NULL_NODE),
+	numLeaves(0),
+	margin(margin) {
+}
+
+int32_t IceFairy::AABBTree::Insert(const AABB& bounds, uint32_t value) {
+	int32_t leaf = AllocateNode();
+	auto& node = nodes[leaf];
+
+	node.bounds = bounds.Expand(margin);
+	node.value = value;
+	node.height = 0;
+
+	InsertLeaf(leaf);
+	numLeaves++;
+
+	return leaf;
+}
+
+void IceFairy::AABBTree::Remove(int32_t leaf) {
+	RemoveLeaf(leaf);
+	FreeNode(leaf);
+	numLeaves--;
+}
+
+bool IceFairy::AABBTree::Move(int32_t leaf, const AABB& bounds) {
+	if (nodes[leaf].bounds.Contains(bounds)) {
+		return false;
+	}
+
+	RemoveLeaf(leaf);
+	nodes[leaf].bounds = bounds.Expand(margin);
+	InsertLeaf(leaf);
+
+	return true;
+}
+
+void IceFairy::AABBTree::Clear(void) {
+	nodes.clear();
+	root = NULL_NODE;
+	freeList = NULL_NODE;
+	numLeaves = 0;
+}
+
+const IceFairy::AABB& IceFairy::AABBTree::GetBounds(int32_t leaf) const {
+	return nodes[leaf].bounds;
+}
+
+uint32_t IceFairy::AABBTree::GetValue(int32_t leaf) const {
+	return nodes[leaf].value;
+}
+
+int32_t IceFairy::AABBTree::GetHeight(void) const {
+	return root == NULL_NODE ? 0 : nodes[root].height;
+}
+
+size_t IceFairy::AABBTree::GetLeafCount(void) const {
+	return numLeaves;
+}
+
+int32_t IceFairy::AABBTree::AllocateNode(void) {
+	int32_t index;
+
+	if (freeList != NULL_NODE) {
+		index = freeList;
+		freeList = nodes[index].parent;
+	}
+	else {
+		index = (int32_t) nodes.size();
+		nodes.emplace_back();
+	}
+
+	auto& node = nodes[index];
+	node.parent = NULL_NODE;
+	node.left = NULL_NODE;
+	node.right = NULL_NODE;
+	node.height = 0;
+	node.value = 0;
+
+	return index;
+}
+
+void IceFairy::AABBTree::FreeNode(int32_t index) {
+	nodes[index].parent = freeList;
+	nodes[index].height = -1;
+	freeList = index;
+}
+
+void IceFairy::AABBTree::InsertLeaf(int32_t leaf) {
+	if (root == NULL_NODE) {
+		root = leaf;
+		nodes[root].parent = NULL_NODE;
+		return;
+	}
+
+	AABB leafBounds = nodes[leaf].bounds;
+	int32_t index = root;
+
+	// Walk down to the sibling which adds the least surface area to the tree
+	while (!nodes[index].IsLeaf()) {
+		const Node& node = nodes[index];
+		float area = node.bounds.GetHalfArea();
+		float combinedArea = AABB::Union(node.bounds, leafBounds).GetHalfArea();
+
+		// Cost of making a new parent for this node and the leaf
+		float cost = 2.0f * combinedArea;
+		// Minimum cost of pushing the leaf further down
+		float inheritanceCost = 2.0f * (combinedArea - area);
+
+		auto childCost = [&](int32_t child) {
+			float grownArea = AABB::Union(leafBounds, nodes[child].bounds).GetHalfArea();
+
+			if (nodes[child].IsLeaf()) {
+				return grownArea + inheritanceCost;
+			}
+			return grownArea - nodes[child].bounds.GetHalfArea() + inheritanceCost;
+		};
+
+		float leftCost = childCost(node.left);
+		float rightCost = childCost(node.right);
+
+		if (cost < leftCost && cost < rightCost) {
+			break;
+		}
+
+		index = leftCost < rightCost ? node.left : node.right;
+	}
+
+	int32_t sibling = index;
+	int32_t oldParent = nodes[sibling].parent;
+	int32_t newParent = AllocateNode();
+
+	nodes[newParent].parent = oldParent;
+	nodes[newParent].bounds = AABB::Union(leafBounds, nodes[sibling].bounds);
+	nodes[newParent].height = nodes[sibling].height + 1;
+	nodes[newParent].left = sibling;
+	nodes[newParent].right = leaf;
+	nodes[sibling].parent = newParent;
+	nodes[leaf].parent = newParent;
+
+	if (oldParent == NULL_NODE) {
+		root = newParent;
+	}
+	else if (nodes[oldParent].left == sibling) {
+		nodes[oldParent].left = newParent;
+	}
+	else {
+		nodes[oldParent].right = newParent;
+	}
+
+	FixUpwards(nodes[leaf].parent);
+}
+
+void IceFairy::AABBTree::RemoveLeaf(int32_t leaf) {
+	if (leaf == root) {
+		root = NULL_NODE;
+		return;
+	}
+
+	int32_t parent = nodes[leaf].parent;
+	int32_t grandParent = nodes[parent].parent;
+	int32_t sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+
+	// The sibling takes the parent's place
+	if (grandParent == NULL_NODE) {
+		root = sibling;
+		nodes[sibling].parent = NULL_NODE;
+		FreeNode(parent);
+		return;
+	}
+
+	if (nodes[grandParent].left == parent) {
+		nodes[grandParent].left = sibling;
+	}
+	else {
+		nodes[grandParent].right = sibling;
+	}
+	nodes[sibling].parent = grandParent;
+	FreeNode(parent);
+
+	FixUpwards(grandParent);
+}
+
+void IceFairy::AABBTree::FixUpwards(int32_t index) {
+	while (index != NULL_NODE) {
+		index = Balance(index);
+
+		auto& node = nodes[index];
+		node.height = 1 + std::max(nodes[node.left].height, nodes[node.right].height);
+		node.bounds = AABB::Union(nodes[node.left].bounds, nodes[node.right].bounds);
+
+		index = node.parent;
+	}
+}
+
+int32_t IceFairy::AABBTree::Balance(int32_t a) {
+	if (nodes[a].IsLeaf() || nodes[a].height < 2) {
+		return a;
+	}
+
+	int32_t b = nodes[a].left;
+	int32_t c = nodes[a].right;
+	int32_t balance = nodes[c].height - nodes[b].height;
+
+	if (balance >= -1 && balance <= 1) {
+		return a;
+	}
+
+	// Rotates the taller child up into a's place, a takes the shorter of its grandchildren
+	auto rotate = [this, a](int32_t up, int32_t down, bool upIsRight) {
+		Node& upNode = nodes[up];
+		int32_t f = upNode.left;
+		int32_t g = upNode.right;
+
+		upNode.left = a;
+		upNode.parent = nodes[a].parent;
+		nodes[a].parent = up;
+
+		if (upNode.parent == NULL_NODE) {
+			root = up;
+		}
+		else if (nodes[upNode.parent].left == a) {
+			nodes[upNode.parent].left = up;
+		}
+		else {
+			nodes[upNode.parent].right = up;
+		}
+
+		// The taller grandchild stays with up, the other replaces up under a
+		int32_t keep = nodes[f].height > nodes[g].height ? f : g;
+		int32_t give = keep == f ? g : f;
+
+		upNode.right = keep;
+		if (upIsRight) {
+			nodes[a].right = give;
+		}
+		else {
+			nodes[a].left = give;
+		}
+		nodes[give].parent = a;
+
+		nodes[a].bounds = AABB::Union(nodes[down].bounds, nodes[give].bounds);
+		nodes[a].height = 1 + std::max(nodes[down].height, nodes[give].height);
+		upNode.bounds = AABB::Union(nodes[a].bounds, nodes[keep].bounds);
+		upNode.height = 1 + std::max(nodes[a].height, nodes[keep].height);
+
+		return up;
+	};
+
+	if (balance > 1) {
+		return rotate(c, b, true);
+	}
+
+	return rotate(b, c, false);
+}
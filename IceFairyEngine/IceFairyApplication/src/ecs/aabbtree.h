@@ -0,0 +1,258 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <limits>
+
+#include "math/vector.h"
+
+namespace IceFairy {
+
+	/*! \brief Axis aligned bounding box. */
+	struct AABB {
+		Vector3f min;
+		Vector3f max;
+
+		AABB(void) {
+		}
+
+		AABB(const Vector3f& min, const Vector3f& max) :
+			min(min),
+			max(max) {
+		}
+
+		/*! \returns The box centred on \p centre reaching \p halfExtents along each axis. */
+		static AABB FromCentre(const Vector3f& centre, const Vector3f& halfExtents) {
+			return AABB(centre - halfExtents, centre + halfExtents);
+		}
+
+		/*! \returns The smallest box containing both \p a and \p b. */
+		static AABB Union(const AABB& a, const AABB& b) {
+			return AABB(
+				Vector3f(std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y), std::min(a.min.z, b.min.z)),
+				Vector3f(std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y), std::max(a.max.z, b.max.z)));
+		}
+
+		AABB Expand(float margin) const {
+			return AABB(min - Vector3f(margin), max + Vector3f(margin));
+		}
+
+		bool Overlaps(const AABB& other) const {
+			return min.x <= other.max.x && max.x >= other.min.x
+				&& min.y <= other.max.y && max.y >= other.min.y
+				&& min.z <= other.max.z && max.z >= other.min.z;
+		}
+
+		bool Contains(const AABB& other) const {
+			return min.x <= other.min.x && max.x >= other.max.x
+				&& min.y <= other.min.y && max.y >= other.max.y
+				&& min.z <= other.min.z && max.z >= other.max.z;
+		}
+
+		/*! \returns The squared distance from \p point to the closest point in the box, 0 if inside. */
+		float DistanceSQ(const Vector3f& point) const {
+			float dx = std::max(std::max(min.x - point.x, 0.0f), point.x - max.x);
+			float dy = std::max(std::max(min.y - point.y, 0.0f), point.y - max.y);
+			float dz = std::max(std::max(min.z - point.z, 0.0f), point.z - max.z);
+
+			return dx * dx + dy * dy + dz * dz;
+		}
+
+		/*! \brief Intersects the ray \p origin + t * \p direction with the box, for t in [0, \p maxDistance].
+		 *
+		 * \param inverseDirection 1 / \p direction on each axis.
+		 * \param distance Set to the t the ray enters the box at, 0 if it starts inside.
+		 */
+		bool Raycast(const Vector3f& origin, const Vector3f& inverseDirection, float maxDistance, float& distance) const {
+			float t1 = (min.x - origin.x) * inverseDirection.x;
+			float t2 = (max.x - origin.x) * inverseDirection.x;
+			float enter = std::min(t1, t2);
+			float exit = std::max(t1, t2);
+
+			t1 = (min.y - origin.y) * inverseDirection.y;
+			t2 = (max.y - origin.y) * inverseDirection.y;
+			enter = std::max(enter, std::min(t1, t2));
+			exit = std::min(exit, std::max(t1, t2));
+
+			t1 = (min.z - origin.z) * inverseDirection.z;
+			t2 = (max.z - origin.z) * inverseDirection.z;
+			enter = std::max(enter, std::min(t1, t2));
+			exit = std::min(exit, std::max(t1, t2));
+
+			distance = std::max(enter, 0.0f);
+			return exit >= distance && enter <= maxDistance;
+		}
+
+		/*! \returns Half the surface area, which is all the tree's cost heuristic needs. */
+		float GetHalfArea(void) const {
+			float dx = max.x - min.x;
+			float dy = max.y - min.y;
+			float dz = max.z - min.z;
+
+			return dx * dy + dy * dz + dz * dx;
+		}
+	};
+
+	/*! \brief Dynamic bounding volume hierarchy of boxes.
+	 *
+	 * Every leaf holds a caller supplied value and a box enlarged by a margin, so objects can
+	 * move a little without the tree changing at all. Leaves are inserted next to the sibling
+	 * which grows the tree's total surface area the least, and the tree is kept balanced with
+	 * rotations, after the dynamic tree in Box2D.\n
+	 * Queries don't modify the tree, so any number of threads may query it at once as long as
+	 * none of them changes it.
+	 */
+	class AABBTree {
+	public:
+		static constexpr int32_t NULL_NODE = -1;
+
+		/*! \param margin How far every leaf's box is enlarged beyond the box it was given. */
+		AABBTree(float margin = 0.1f);
+
+		/*! \brief Adds a leaf for \p bounds holding \p value and returns it. */
+		int32_t Insert(const AABB& bounds, uint32_t value);
+		void Remove(int32_t leaf);
+		/*! \brief Moves \p leaf to \p bounds.
+		 *
+		 * \returns Whether the tree changed, it doesn't while \p bounds stays in the enlarged box.
+		 */
+		bool Move(int32_t leaf, const AABB& bounds);
+		void Clear(void);
+
+		/*! \brief Calls \p function with the value of every leaf whose enlarged box overlaps \p bounds. */
+		template<typename F>
+		void Query(const AABB& bounds, F&& function) const {
+			Traverse([&bounds](const AABB& nodeBounds) { return nodeBounds.Overlaps(bounds); }, function);
+		}
+
+		/*! \brief Calls \p function with the value of every leaf whose enlarged box is within \p radius of \p centre. */
+		template<typename F>
+		void QuerySphere(const Vector3f& centre, float radius, F&& function) const {
+			float radiusSQ = radius * radius;
+
+			Traverse([&centre, radiusSQ](const AABB& nodeBounds) { return nodeBounds.DistanceSQ(centre) <= radiusSQ; }, function);
+		}
+
+		/*! \brief Walks the leaves whose enlarged box the ray hits, nearest subtrees first.
+		 *
+		 * \p function is called as \c function(value, maxDistance) and returns the new maximum
+		 * distance, usually the distance to a closer hit, which prunes every farther subtree.
+		 */
+		template<typename F>
+		void Raycast(const Vector3f& origin, const Vector3f& direction, float maxDistance, F&& function) const {
+			if (root == NULL_NODE) {
+				return;
+			}
+
+			Vector3f inverseDirection(1.0f / direction.x, 1.0f / direction.y, 1.0f / direction.z);
+			int32_t stack[MAX_STACK_DEPTH];
+			int numStacked = 0;
+			float distance;
+
+			if (!nodes[root].bounds.Raycast(origin, inverseDirection, maxDistance, distance)) {
+				return;
+			}
+			stack[numStacked++] = root;
+
+			while (numStacked > 0) {
+				const Node& node = nodes[stack[--numStacked]];
+
+				if (!node.bounds.Raycast(origin, inverseDirection, maxDistance, distance)) {
+					continue;
+				}
+
+				if (node.IsLeaf()) {
+					maxDistance = function(node.value, maxDistance);
+					continue;
+				}
+
+				float leftDistance;
+				float rightDistance;
+				bool hitsLeft = nodes[node.left].bounds.Raycast(origin, inverseDirection, maxDistance, leftDistance);
+				bool hitsRight = nodes[node.right].bounds.Raycast(origin, inverseDirection, maxDistance, rightDistance);
+
+				// Pushed farthest first so the nearer child is visited first
+				if (hitsLeft && hitsRight && leftDistance < rightDistance) {
+					stack[numStacked++] = node.right;
+					stack[numStacked++] = node.left;
+				}
+				else {
+					if (hitsLeft) {
+						stack[numStacked++] = node.left;
+					}
+					if (hitsRight) {
+						stack[numStacked++] = node.right;
+					}
+				}
+			}
+		}
+
+		const AABB& GetBounds(int32_t leaf) const;
+		uint32_t GetValue(int32_t leaf) const;
+		/*! \returns The number of levels below the root, 0 for an empty tree or a single leaf. */
+		int32_t GetHeight(void) const;
+		size_t GetLeafCount(void) const;
+
+	private:
+		//! Balancing keeps the height near log2 of the leaf count, far below this
+		static constexpr int MAX_STACK_DEPTH = 256;
+
+		struct Node {
+			AABB bounds;
+			//! Doubles as the next free node while the node is unused
+			int32_t parent;
+			int32_t left;
+			int32_t right;
+			int32_t height;
+			uint32_t value;
+
+			bool IsLeaf(void) const {
+				return left == NULL_NODE;
+			}
+		};
+
+		template<typename Overlaps, typename F>
+		void Traverse(const Overlaps& overlaps, F& function) const {
+			if (root == NULL_NODE) {
+				return;
+			}
+
+			int32_t stack[MAX_STACK_DEPTH];
+			int numStacked = 0;
+			stack[numStacked++] = root;
+
+			while (numStacked > 0) {
+				const Node& node = nodes[stack[--numStacked]];
+
+				if (!overlaps(node.bounds)) {
+					continue;
+				}
+
+				if (node.IsLeaf()) {
+					function(node.value);
+				}
+				else {
+					stack[numStacked++] = node.left;
+					stack[numStacked++] = node.right;
+				}
+			}
+		}
+
+		int32_t AllocateNode(void);
+		void FreeNode(int32_t index);
+		void InsertLeaf(int32_t leaf);
+		void RemoveLeaf(int32_t leaf);
+		/*! \brief Refits and rebalances every ancestor of \p index. */
+		void FixUpwards(int32_t index);
+		/*! \brief Rotates the subtree at \p index if its children's heights differ by more than one. */
+		int32_t Balance(int32_t index);
+
+		std::vector<Node> nodes;
+		int32_t root;
+		int32_t freeList;
+		size_t numLeaves;
+		float margin;
+	};
+
+}
@@ -0,0 +1,128 @@
+#include "archetype.h"
+
+IceFairy::Archetype::Archetype(const ComponentMask& mask, ChunkAllocator& allocator) :
+	mask(mask) {
+	columnIndices.fill(-1);
+	addEdges.fill(nullptr);
+	removeEdges.fill(nullptr);
+
+	for (ComponentTypeId id = 0; id < ICE_FAIRY_MAX_COMPONENT_TYPES; id++) {
+		// Tags only live in the mask
+		if (mask.test(id) && !ComponentTypes::GetInfo(id).IsTag()) {
+			columnIndices[id] = (int) columns.size();
+			columns.emplace_back(ComponentTypes::GetInfo(id), allocator);
+		}
+	}
+}
+
+size_t IceFairy::Archetype::AddEntity(EntityId entityId) {
+	entities.push_back(entityId);
+	return entities.size() - 1;
+}
+
+size_t IceFairy::Archetype::AddEntities(const EntityId* entityIds, size_t count) {
+	size_t first = entities.size();
+
+	entities.insert(entities.end(), entityIds, entityIds + count);
+	return first;
+}
+
+void IceFairy::Archetype::Truncate(size_t newSize) {
+	for (auto& column : columns) {
+		if (column.GetSize() > newSize) {
+			column.Truncate(newSize);
+		}
+	}
+
+	entities.resize(newSize);
+}
+
+void IceFairy::Archetype::RemoveEntity(size_t row) {
+	for (auto& column : columns) {
+		column.SwapRemove(row);
+	}
+
+	SwapRemoveEntity(row);
+}
+
+void IceFairy::Archetype::MoveEntity(size_t row, Archetype& target) {
+	target.AddEntity(entities[row]);
+
+	for (auto& column : columns) {
+		auto targetColumn = target.GetColumn(column.GetInfo().id);
+
+		if (targetColumn != nullptr) {
+			column.MoveRowTo(row, *targetColumn);
+		}
+		else {
+			column.SwapRemove(row);
+		}
+	}
+
+	SwapRemoveEntity(row);
+}
+
+bool IceFairy::Archetype::HasComponent(ComponentTypeId id) const {
+	return mask.test(id);
+}
+
+bool IceFairy::Archetype::HasComponents(const ComponentMask& components) const {
+	return (mask & components) == components;
+}
+
+IceFairy::ComponentColumn* IceFairy::Archetype::GetColumn(ComponentTypeId id) {
+	return columnIndices[id] != -1 ? &columns[columnIndices[id]] : nullptr;
+}
+
+const IceFairy::ComponentMask& IceFairy::Archetype::GetMask(void) const {
+	return mask;
+}
+
+const std::vector<IceFairy::EntityId>& IceFairy::Archetype::GetEntities(void) const {
+	return entities;
+}
+
+size_t IceFairy::Archetype::GetSize(void) const {
+	return entities.size();
+}
+
+size_t IceFairy::Archetype::GetUsedBytes(void) const {
+	size_t bytes = 0;
+
+	for (auto& column : columns) {
+		bytes += column.GetSize() * column.GetInfo().size;
+	}
+
+	return bytes;
+}
+
+size_t IceFairy::Archetype::GetReservedBytes(void) const {
+	size_t bytes = 0;
+
+	for (auto& column : columns) {
+		bytes += column.GetReservedBytes();
+	}
+
+	return bytes;
+}
+
+IceFairy::Archetype* IceFairy::Archetype::GetAddEdge(ComponentTypeId id) const {
+	return addEdges[id];
+}
+
+IceFairy::Archetype* IceFairy::Archetype::GetRemoveEdge(ComponentTypeId id) const {
+	return removeEdges[id];
+}
+
+void IceFairy::Archetype::SetAddEdge(ComponentTypeId id, Archetype* archetype) {
+	addEdges[id] = archetype;
+}
+
+void IceFairy::Archetype::SetRemoveEdge(ComponentTypeId id, Archetype* archetype) {
+	removeEdges[id] = archetype;
+}
+
+void IceFairy::Archetype::SwapRemoveEntity(size_t row) {
+	entities[row] = entities.back();
+	entities.pop_back();
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <vector>
+#include <array>
+
+#include "componentcolumn.h"
+#include "componenttypes.h"
+#include "entityid.h"
+
+namespace IceFairy {
+
+	/*! \brief Table of every entity which has exactly the same set of component types.
+	 *
+	 * Each component type gets its own \ref ComponentColumn, so row \c i of every column belongs
+	 * to \c GetEntities()[i]. Systems walk the columns linearly instead of chasing a pointer per
+	 * component per entity.\n
+	 * Tag components have no column, see \ref IsTagComponent.
+	 */
+	class Archetype {
+	public:
+		/*! \param mask The component types stored by this archetype.
+		 * \param allocator Provides the memory of every column.
+		 */
+		Archetype(const ComponentMask& mask, ChunkAllocator& allocator = ChunkAllocator::GetShared());
+
+		/*! \brief Appends a row for \p entityId. The caller must push a value onto every column. */
+		size_t AddEntity(EntityId entityId);
+		/*! \brief Appends a row for each of the \p count entities at \p entityIds and returns the first.
+		 *
+		 * As with \ref AddEntity the caller must fill every column.
+		 */
+		size_t AddEntities(const EntityId* entityIds, size_t count);
+		/*! \brief Destroys every row from \p newSize onwards, including any columns already filled. */
+		void Truncate(size_t newSize);
+		/*! \brief Destroys the row at \p row.
+		 *
+		 * The last row is moved into \p row, so the caller must update that entity's row if
+		 * \p row is still less than \ref GetSize.
+		 */
+		void RemoveEntity(size_t row);
+		/*! \brief Moves the row at \p row into \p target.
+		 *
+		 * Components shared by both archetypes are moved, any others are destroyed. Columns in
+		 * \p target which this archetype does not have are left for the caller to fill. As with
+		 * \ref RemoveEntity the last row is moved into \p row.
+		 */
+		void MoveEntity(size_t row, Archetype& target);
+
+		bool HasComponent(ComponentTypeId id) const;
+		/*! \returns Whether this archetype has every component in \p mask. */
+		bool HasComponents(const ComponentMask& mask) const;
+		/*! \returns The column of component \p id, null if the archetype lacks it or it is a tag. */
+		ComponentColumn* GetColumn(ComponentTypeId id);
+
+		const ComponentMask& GetMask(void) const;
+		const std::vector<EntityId>& GetEntities(void) const;
+		size_t GetSize(void) const;
+		/*! \returns The bytes of component data held by the rows. */
+		size_t GetUsedBytes(void) const;
+		/*! \returns The bytes the columns have taken from their allocator. */
+		size_t GetReservedBytes(void) const;
+
+		Archetype* GetAddEdge(ComponentTypeId id) const;
+		Archetype* GetRemoveEdge(ComponentTypeId id) const;
+		void SetAddEdge(ComponentTypeId id, Archetype* archetype);
+		void SetRemoveEdge(ComponentTypeId id, Archetype* archetype);
+
+	private:
+		void SwapRemoveEntity(size_t row);
+
+		ComponentMask mask;
+		std::vector<ComponentColumn> columns;
+		std::array<int, ICE_FAIRY_MAX_COMPONENT_TYPES> columnIndices;
+		std::vector<EntityId> entities;
+
+		std::array<Archetype*, ICE_FAIRY_MAX_COMPONENT_TYPES> addEdges;
+		std::array<Archetype*, ICE_FAIRY_MAX_COMPONENT_TYPES> removeEdges;
+	};
+
+}
@@ -0,0 +1,118 @@
+#include "chunkallocator.h"
+
+#include <new>
+#include <algorithm>
+
+IceFairy::ChunkAllocator::ChunkAllocator() :
+	stats { 0, 0, 0, 0 } {
+}
+
+IceFairy::ChunkAllocator::~ChunkAllocator() {
+	Trim();
+}
+
+void* IceFairy::ChunkAllocator::Allocate(size_t numChunks, size_t alignment) {
+	numChunks = GetChunksFor(numChunks * CHUNK_SIZE);
+
+	// Over-aligned blocks can't be shared with everyone else, so they bypass the free lists
+	if (alignment > CHUNK_ALIGNMENT) {
+		std::lock_guard<std::mutex> lock(mutex);
+		stats.numChunksInUse += numChunks;
+		stats.numSystemAllocations++;
+		return AllocateFromSystem(numChunks, alignment);
+	}
+
+	size_t sizeClass = GetSizeClass(numChunks);
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		stats.numChunksInUse += numChunks;
+
+		if (sizeClass < freeBlocks.size() && !freeBlocks[sizeClass].empty()) {
+			void* block = freeBlocks[sizeClass].back();
+			freeBlocks[sizeClass].pop_back();
+
+			stats.numChunksFree -= numChunks;
+			stats.numReuses++;
+			return block;
+		}
+
+		stats.numSystemAllocations++;
+	}
+
+	return AllocateFromSystem(numChunks, CHUNK_ALIGNMENT);
+}
+
+void IceFairy::ChunkAllocator::Free(void* block, size_t numChunks, size_t alignment) {
+	if (block == nullptr) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	stats.numChunksInUse -= numChunks;
+
+	if (alignment > CHUNK_ALIGNMENT) {
+		FreeToSystem(block, numChunks, alignment);
+		return;
+	}
+
+	size_t sizeClass = GetSizeClass(numChunks);
+	if (sizeClass >= freeBlocks.size()) {
+		freeBlocks.resize(sizeClass + 1);
+	}
+
+	freeBlocks[sizeClass].push_back(block);
+	stats.numChunksFree += numChunks;
+}
+
+void IceFairy::ChunkAllocator::Trim(void) {
+	std::lock_guard<std::mutex> lock(mutex);
+
+	for (size_t sizeClass = 0; sizeClass < freeBlocks.size(); sizeClass++) {
+		for (auto block : freeBlocks[sizeClass]) {
+			FreeToSystem(block, (size_t) 1 << sizeClass, CHUNK_ALIGNMENT);
+		}
+
+		freeBlocks[sizeClass].clear();
+	}
+
+	stats.numChunksFree = 0;
+}
+
+IceFairy::ChunkAllocator::Stats IceFairy::ChunkAllocator::GetStats(void) const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return stats;
+}
+
+size_t IceFairy::ChunkAllocator::GetChunksFor(size_t bytes) {
+	size_t numChunks = 1;
+
+	while (numChunks * CHUNK_SIZE < bytes) {
+		numChunks *= 2;
+	}
+
+	return numChunks;
+}
+
+IceFairy::ChunkAllocator& IceFairy::ChunkAllocator::GetShared(void) {
+	static ChunkAllocator allocator;
+	return allocator;
+}
+
+size_t IceFairy::ChunkAllocator::GetSizeClass(size_t numChunks) {
+	size_t sizeClass = 0;
+
+	while (((size_t) 1 << sizeClass) < numChunks) {
+		sizeClass++;
+	}
+
+	return sizeClass;
+}
+
+void* IceFairy::ChunkAllocator::AllocateFromSystem(size_t numChunks, size_t alignment) {
+	return ::operator new(numChunks * CHUNK_SIZE, std::align_val_t(std::max(alignment, CHUNK_ALIGNMENT)));
+}
+
+void IceFairy::ChunkAllocator::FreeToSystem(void* block, size_t numChunks, size_t alignment) {
+	::operator delete(block, numChunks * CHUNK_SIZE, std::align_val_t(std::max(alignment, CHUNK_ALIGNMENT)));
+}
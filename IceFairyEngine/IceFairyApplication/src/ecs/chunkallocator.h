@@ -0,0 +1,71 @@
+#pragma once
+
+#include <vector>
+#include <mutex>
+#include <cstddef>
+
+#ifndef ICE_FAIRY_COMPONENT_CHUNK_SIZE
+#define ICE_FAIRY_COMPONENT_CHUNK_SIZE (16 * 1024)
+#endif
+
+namespace IceFairy {
+
+	/*! \brief Hands out component memory in fixed-size chunks and recycles them.
+	 *
+	 * Blocks are always a power of two number of contiguous chunks. Freed blocks are kept on a
+	 * free list per size and handed straight back out to the next column needing that size, so
+	 * a long running session settles into reusing the same few blocks rather than fragmenting
+	 * the heap.\n
+	 * Blocks must be freed before the allocator is destroyed. Safe to use from several threads.
+	 */
+	class ChunkAllocator {
+	public:
+		static constexpr size_t CHUNK_SIZE = ICE_FAIRY_COMPONENT_CHUNK_SIZE;
+		//! Blocks are aligned to at least a cache line
+		static constexpr size_t CHUNK_ALIGNMENT = 64;
+
+		struct Stats {
+			//! Chunks in blocks currently handed out
+			size_t numChunksInUse;
+			//! Chunks in blocks waiting on a free list
+			size_t numChunksFree;
+			//! Blocks which had to be allocated from the system
+			size_t numSystemAllocations;
+			//! Blocks which were served from a free list
+			size_t numReuses;
+		};
+
+		ChunkAllocator();
+		~ChunkAllocator();
+
+		ChunkAllocator(const ChunkAllocator&) = delete;
+		ChunkAllocator& operator=(const ChunkAllocator&) = delete;
+
+		/*! \brief Returns a block of at least \p numChunks chunks, aligned to \p alignment.
+		 *
+		 * \p numChunks is rounded up to a power of two, the rounded count must be passed to \ref Free.
+		 */
+		void* Allocate(size_t numChunks, size_t alignment = CHUNK_ALIGNMENT);
+		void Free(void* block, size_t numChunks, size_t alignment = CHUNK_ALIGNMENT);
+		/*! \brief Returns every block on the free lists to the system. */
+		void Trim(void);
+
+		Stats GetStats(void) const;
+
+		/*! \returns The smallest power of two number of chunks holding \p bytes. */
+		static size_t GetChunksFor(size_t bytes);
+		/*! \returns The allocator used by columns which aren't given one. */
+		static ChunkAllocator& GetShared(void);
+
+	private:
+		static size_t GetSizeClass(size_t numChunks);
+		static void* AllocateFromSystem(size_t numChunks, size_t alignment);
+		static void FreeToSystem(void* block, size_t numChunks, size_t alignment);
+
+		mutable std::mutex mutex;
+		//! Free blocks of 2^i chunks, indexed by i
+		std::vector<std::vector<void*>> freeBlocks;
+		Stats stats;
+	};
+
+}
@@ -0,0 +1,240 @@
+#include "componentcolumn.h"
+
+#include <algorithm>
+#include <cstring>
+
+IceFairy::ComponentColumn::ComponentColumn(const ComponentInfo& info, ChunkAllocator& allocator) :
+	info(info),
+	allocator(&allocator),
+	data(nullptr),
+	size(0),
+	capacity(0),
+	numChunks(0),
+	lastAddedTick(0),
+	lastChangedTick(0) {
+}
+
+IceFairy::ComponentColumn::ComponentColumn(ComponentColumn&& other) noexcept :
+	info(other.info),
+	allocator(other.allocator),
+	data(other.data),
+	size(other.size),
+	capacity(other.capacity),
+	numChunks(other.numChunks),
+	addedTicks(std::move(other.addedTicks)),
+	changedTicks(std::move(other.changedTicks)),
+	lastAddedTick(other.lastAddedTick),
+	lastChangedTick(other.lastChangedTick.load()) {
+	other.data = nullptr;
+	other.size = 0;
+	other.capacity = 0;
+	other.numChunks = 0;
+}
+
+IceFairy::ComponentColumn::~ComponentColumn() {
+	Clear();
+	Release();
+}
+
+void IceFairy::ComponentColumn::PushBack(void* component, Tick tick) {
+	if (size == capacity) {
+		Reserve(size + 1);
+	}
+
+	info.moveConstruct(data + size * info.size, component);
+	addedTicks.push_back(tick);
+	changedTicks.push_back(tick);
+	size++;
+
+	UpdateLastTicks(tick, tick);
+}
+
+void* IceFairy::ComponentColumn::AppendUninitialised(size_t count, Tick tick) {
+	if (size + count > capacity) {
+		Reserve(size + count);
+	}
+
+	void* first = Get(size);
+
+	addedTicks.insert(addedTicks.end(), count, tick);
+	changedTicks.insert(changedTicks.end(), count, tick);
+	size += count;
+
+	UpdateLastTicks(tick, tick);
+	return first;
+}
+
+void IceFairy::ComponentColumn::AppendCopies(const void* component, size_t count, Tick tick) {
+	if (count == 0) {
+		return;
+	}
+
+	auto first = static_cast<unsigned char*>(AppendUninitialised(count, tick));
+
+	if (info.isTriviallyCopyable) {
+		std::memcpy(first, component, info.size);
+
+		// Copy the rows written so far onto the end, doubling them every time
+		for (size_t numCopied = 1; numCopied < count; ) {
+			size_t numToCopy = std::min(numCopied, count - numCopied);
+
+			std::memcpy(first + numCopied * info.size, first, numToCopy * info.size);
+			numCopied += numToCopy;
+		}
+		return;
+	}
+
+	size_t numConstructed = 0;
+
+	try {
+		for (; numConstructed < count; numConstructed++) {
+			info.copyConstruct(first + numConstructed * info.size, component);
+		}
+	}
+	catch (...) {
+		for (size_t i = 0; i < numConstructed; i++) {
+			info.destroy(first + i * info.size);
+		}
+
+		DiscardUninitialised(count);
+		throw;
+	}
+}
+
+void IceFairy::ComponentColumn::DiscardUninitialised(size_t count) {
+	size -= count;
+	addedTicks.resize(size);
+	changedTicks.resize(size);
+
+	if (size == 0) {
+		Release();
+	}
+}
+
+void IceFairy::ComponentColumn::Truncate(size_t newSize) {
+	for (size_t i = newSize; i < size; i++) {
+		info.destroy(Get(i));
+	}
+
+	DiscardUninitialised(size - newSize);
+}
+
+void IceFairy::ComponentColumn::SwapRemove(size_t row) {
+	size_t last = size - 1;
+
+	info.destroy(Get(row));
+
+	if (row != last) {
+		info.moveConstruct(Get(row), Get(last));
+		info.destroy(Get(last));
+		addedTicks[row] = addedTicks[last];
+		changedTicks[row] = changedTicks[last];
+	}
+
+	addedTicks.pop_back();
+	changedTicks.pop_back();
+	size--;
+
+	// Lets archetypes which empty out hand their chunks to the ones which are filling up
+	if (size == 0) {
+		Release();
+	}
+}
+
+void IceFairy::ComponentColumn::MoveRowTo(size_t row, ComponentColumn& target) {
+	target.PushBack(Get(row), addedTicks[row]);
+	target.changedTicks.back() = changedTicks[row];
+	target.UpdateLastTicks(addedTicks[row], changedTicks[row]);
+
+	SwapRemove(row);
+}
+
+void IceFairy::ComponentColumn::Clear(void) {
+	for (size_t i = 0; i < size; i++) {
+		info.destroy(Get(i));
+	}
+
+	size = 0;
+	addedTicks.clear();
+	changedTicks.clear();
+}
+
+void* IceFairy::ComponentColumn::Get(size_t row) {
+	return data + row * info.size;
+}
+
+void IceFairy::ComponentColumn::MarkChanged(size_t row, Tick tick) {
+	changedTicks[row] = tick;
+	MarkColumnChanged(tick);
+}
+
+void IceFairy::ComponentColumn::MarkColumnChanged(Tick tick) {
+	lastChangedTick.store(tick, std::memory_order_relaxed);
+}
+
+IceFairy::Tick IceFairy::ComponentColumn::GetAddedTick(size_t row) const {
+	return addedTicks[row];
+}
+
+IceFairy::Tick IceFairy::ComponentColumn::GetChangedTick(size_t row) const {
+	return changedTicks[row];
+}
+
+IceFairy::Tick IceFairy::ComponentColumn::GetLastAddedTick(void) const {
+	return lastAddedTick;
+}
+
+IceFairy::Tick IceFairy::ComponentColumn::GetLastChangedTick(void) const {
+	return lastChangedTick.load(std::memory_order_relaxed);
+}
+
+size_t IceFairy::ComponentColumn::GetSize(void) const {
+	return size;
+}
+
+size_t IceFairy::ComponentColumn::GetCapacity(void) const {
+	return capacity;
+}
+
+size_t IceFairy::ComponentColumn::GetReservedBytes(void) const {
+	return numChunks * ChunkAllocator::CHUNK_SIZE;
+}
+
+const IceFairy::ComponentInfo& IceFairy::ComponentColumn::GetInfo(void) const {
+	return info;
+}
+
+void IceFairy::ComponentColumn::UpdateLastTicks(Tick added, Tick changed) {
+	// Rows moved in from other columns bring older ticks with them
+	if (IsNewerTick(added, lastAddedTick)) {
+		lastAddedTick = added;
+	}
+
+	if (IsNewerTick(changed, lastChangedTick.load(std::memory_order_relaxed))) {
+		lastChangedTick.store(changed, std::memory_order_relaxed);
+	}
+}
+
+void IceFairy::ComponentColumn::Release(void) {
+	allocator->Free(data, numChunks, info.alignment);
+
+	data = nullptr;
+	capacity = 0;
+	numChunks = 0;
+}
+
+void IceFairy::ComponentColumn::Reserve(size_t newCapacity) {
+	size_t newNumChunks = ChunkAllocator::GetChunksFor(newCapacity * info.size);
+	auto newData = static_cast<unsigned char*>(allocator->Allocate(newNumChunks, info.alignment));
+
+	for (size_t i = 0; i < size; i++) {
+		info.moveConstruct(newData + i * info.size, Get(i));
+		info.destroy(Get(i));
+	}
+
+	allocator->Free(data, numChunks, info.alignment);
+
+	data = newData;
+	numChunks = newNumChunks;
+	capacity = numChunks * ChunkAllocator::CHUNK_SIZE / info.size;
+}
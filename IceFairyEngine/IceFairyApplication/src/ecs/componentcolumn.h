@@ -0,0 +1,240 @@
+#pragma once
+
+#include <typeinfo>
+#include <string>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <cstddef>
+#include <vector>
+#include <atomic>
+#include <functional>
+#include <type_traits>
+
+#include "chunkallocator.h"
+
+namespace IceFairy {
+
+	typedef uint32_t ComponentTypeId;
+	/*! \brief Point in time a component was added or changed, see \ref EntityRegistry::GetTick. */
+	typedef uint32_t Tick;
+
+	/*! \returns Whether \p tick is later than \p since, allowing for ticks wrapping around. */
+	inline bool IsNewerTick(Tick tick, Tick since) {
+		return (int32_t) (tick - since) > 0;
+	}
+
+	class ComponentColumn;
+
+	/*! \brief Whether \p T is a tag, a component with no data such as \c Static or \c Hidden.
+	 *
+	 * Tags only exist in an entity's component mask and are given no column, every entity with
+	 * a tag shares the one instance returned by \ref ComponentInfo::GetTag. Empty types with
+	 * their own constructors or destructor are still stored, as running those may matter.
+	 */
+	template<typename T>
+	struct IsTagComponent : std::integral_constant<bool,
+		std::is_empty<typename std::remove_const<T>::type>::value
+		&& std::is_trivial<typename std::remove_const<T>::type>::value> {
+	};
+
+	/*! \brief Type-erased description of a component type.
+	 *
+	 * Holds everything a \ref ComponentColumn needs to construct, move and destroy values of a
+	 * component type it only knows by size, and a \ref WorldSnapshot needs to save and load it.
+	 */
+	struct ComponentInfo {
+		//! Assigned by \ref ComponentTypes when the type is registered
+		ComponentTypeId id;
+		std::string name;
+		size_t size;
+		size_t alignment;
+		void (*moveConstruct)(void* destination, void* source);
+		void (*destroy)(void* component);
+		//! Null for types which can't be copied
+		void (*copyConstruct)(void* destination, const void* source);
+		//! Whether the component can be saved and loaded as raw bytes
+		bool isTriviallyCopyable;
+		//! The instance shared by every entity with a tag, null for components with data
+		void* tag;
+		//! Appends a component to a buffer, set by \ref ComponentTypes::SetSerializer
+		std::function<void(const void* component, std::vector<unsigned char>& buffer)> save;
+		//! Appends a component read from \p size bytes at \p data onto the end of a column
+		std::function<void(ComponentColumn& column, const unsigned char* data, size_t size, Tick tick)> load;
+
+		template<typename T>
+		static ComponentInfo Create(void) {
+			return ComponentInfo {
+				0,
+				typeid(T).name(),
+				sizeof(T),
+				alignof(T),
+				[](void* destination, void* source) { new (destination) T(std::move(*static_cast<T*>(source))); },
+				[](void* component) { static_cast<T*>(component)->~T(); },
+				GetCopyConstruct<T>(),
+				std::is_trivially_copyable<T>::value,
+				GetTag<T>(),
+				nullptr,
+				nullptr
+			};
+		}
+
+		bool IsTag(void) const {
+			return tag != nullptr;
+		}
+
+		/*! \returns The instance shared by every entity with tag \p T, null if \p T has data. */
+		template<typename T>
+		static T* GetTag(void) {
+			if constexpr (IsTagComponent<T>::value) {
+				static typename std::remove_const<T>::type instance;
+				return &instance;
+			}
+			else {
+				return nullptr;
+			}
+		}
+
+		/*! \returns The rows of \p T in \p column, or the shared instance of a tag, which has no column. */
+		template<typename T>
+		static T* GetData(ComponentColumn* column);
+
+		/*! \returns Row \p row of the data returned by \ref GetData. */
+		template<typename T>
+		static T& GetRow(T* data, size_t row) {
+			if constexpr (IsTagComponent<T>::value) {
+				return *data;
+			}
+			else {
+				return data[row];
+			}
+		}
+
+	private:
+		template<typename T>
+		static auto GetCopyConstruct(void) -> void (*)(void*, const void*) {
+			if constexpr (std::is_copy_constructible<T>::value) {
+				return [](void* destination, const void* source) { new (destination) T(*static_cast<const T*>(source)); };
+			}
+			else {
+				return nullptr;
+			}
+		}
+	};
+
+	/*! \brief Contiguous, type-erased array of a single component type.
+	 *
+	 * Rows are packed with no holes: removing a row moves the last row into its place.\n
+	 * Every row also records the tick it was added at and the tick it last changed at, and the
+	 * column keeps the latest of each so unchanged columns can be skipped without a row scan.\n
+	 * Memory comes from a \ref ChunkAllocator in whole chunks, and is given back to it as soon
+	 * as the column empties.
+	 */
+	class ComponentColumn {
+	public:
+		ComponentColumn(const ComponentInfo& info, ChunkAllocator& allocator = ChunkAllocator::GetShared());
+		ComponentColumn(ComponentColumn&& other) noexcept;
+		~ComponentColumn();
+
+		ComponentColumn(const ComponentColumn&) = delete;
+		ComponentColumn& operator=(const ComponentColumn&) = delete;
+
+		/*! \brief Appends a row by moving \p component into the column, marking it added at \p tick. */
+		void PushBack(void* component, Tick tick = 0);
+		/*! \brief Destroys the row at \p row, moving the last row into its place. */
+		void SwapRemove(size_t row);
+		/*! \brief Appends \p count rows added at \p tick and returns the first.
+		 *
+		 * The rows are left uninitialised, the caller must construct a component in every one
+		 * before the column is used again.
+		 */
+		void* AppendUninitialised(size_t count, Tick tick);
+		/*! \brief Appends \p count copies of \p component added at \p tick.
+		 *
+		 * Trivially copyable components are copied with a few \c memcpy calls, each doubling the
+		 * number of rows written. If a copy throws the column is left as it was.
+		 */
+		void AppendCopies(const void* component, size_t count, Tick tick);
+		/*! \brief Removes the last \p count rows without destroying them, undoing \ref AppendUninitialised. */
+		void DiscardUninitialised(size_t count);
+		/*! \brief Destroys every row from \p newSize onwards. */
+		void Truncate(size_t newSize);
+		/*! \brief Moves the row at \p row onto the end of \p target, then swap removes it from this column.
+		 *
+		 * The row keeps its ticks.
+		 */
+		void MoveRowTo(size_t row, ComponentColumn& target);
+		/*! \brief Destroys every row, keeping the allocated capacity. */
+		void Clear(void);
+
+		void* Get(size_t row);
+
+		template<typename T>
+		T* Get(size_t row) {
+			return static_cast<T*>(Get(row));
+		}
+
+		template<typename T>
+		T* Data(void) {
+			return reinterpret_cast<T*>(data);
+		}
+
+		/*! \brief Records that the row at \p row changed at \p tick, the newest tick in the column. */
+		void MarkChanged(size_t row, Tick tick);
+		/*! \brief Records that some rows changed at \p tick after being written through \ref GetChangedTicks.
+		 *
+		 * Safe to call concurrently as long as every caller passes the same tick.
+		 */
+		void MarkColumnChanged(Tick tick);
+
+		const Tick* GetAddedTicks(void) const {
+			return addedTicks.data();
+		}
+
+		Tick* GetChangedTicks(void) {
+			return changedTicks.data();
+		}
+
+		Tick GetAddedTick(size_t row) const;
+		Tick GetChangedTick(size_t row) const;
+		/*! \returns The latest tick any row was added at. */
+		Tick GetLastAddedTick(void) const;
+		/*! \returns The latest tick any row changed at. */
+		Tick GetLastChangedTick(void) const;
+
+		size_t GetSize(void) const;
+		/*! \returns The number of rows which fit before the column has to grow. */
+		size_t GetCapacity(void) const;
+		/*! \returns The number of bytes taken from the allocator. */
+		size_t GetReservedBytes(void) const;
+		const ComponentInfo& GetInfo(void) const;
+
+	private:
+		void Release(void);
+		void UpdateLastTicks(Tick added, Tick changed);
+		void Reserve(size_t newCapacity);
+
+		ComponentInfo info;
+		ChunkAllocator* allocator;
+		unsigned char* data;
+		size_t size;
+		size_t capacity;
+		size_t numChunks;
+
+		std::vector<Tick> addedTicks;
+		std::vector<Tick> changedTicks;
+		Tick lastAddedTick;
+		std::atomic<Tick> lastChangedTick;
+	};
+
+	template<typename T>
+	T* ComponentInfo::GetData(ComponentColumn* column) {
+		if constexpr (IsTagComponent<T>::value) {
+			return GetTag<T>();
+		}
+		else {
+			return column->template Data<T>();
+		}
+	}
+
+}
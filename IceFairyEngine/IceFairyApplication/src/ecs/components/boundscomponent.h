@@ -0,0 +1,16 @@
+#pragma once
+
+#include "../component.h"
+#include "math/vector.h"
+
+namespace IceFairy {
+	/*! \brief Box around an entity's \ref PositionComponent, used by the \ref SpatialIndex. */
+	struct BoundsComponent : public Component {
+		BoundsComponent(const Vector3f& halfExtents = Vector3f()) :
+			halfExtents(halfExtents) {
+		}
+
+		//! How far the box reaches from the position along each axis
+		Vector3f halfExtents;
+	};
+}
\ No newline at end of file
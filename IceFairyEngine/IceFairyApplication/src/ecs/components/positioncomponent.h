@@ -0,0 +1,15 @@
+#pragma once
+
+#include "../component.h"
+#include "math/vector.h"
+
+namespace IceFairy {
+	/*! \brief Where an entity is in the world. */
+	struct PositionComponent : public Component {
+		PositionComponent(const Vector3f& position = Vector3f()) :
+			position(position) {
+		}
+
+		Vector3f position;
+	};
+}
\ No newline at end of file
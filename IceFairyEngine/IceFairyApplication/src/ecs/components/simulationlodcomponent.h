@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstdint>
+
+#include "../component.h"
+#include "../entityid.h"
+
+namespace IceFairy {
+	/*! \brief How often systems scheduled with \ref EntityRegistry::RATE_LOD update an entity. */
+	enum SimulationLOD : uint8_t {
+		//! Every step
+		LOD_FULL = 0,
+		//! Every 2nd step
+		LOD_HALF,
+		//! Every 4th step
+		LOD_QUARTER,
+		//! Every 8th step
+		LOD_EIGHTH
+	};
+
+	/*! \brief Lowers how often an entity is simulated, for example while it is far away,
+	 * offscreen or idle.
+	 *
+	 * Entities of the same level are spread evenly across the steps by their slot index, so
+	 * with \ref LOD_QUARTER a quarter of them update each step rather than all of them every
+	 * fourth step. A system updating one less often should scale by \ref GetPeriod, which it
+	 * can read by taking this component as \c const.
+	 */
+	struct SimulationLODComponent : public Component {
+		SimulationLODComponent(SimulationLOD lod = LOD_FULL) :
+			lod(lod) {
+		}
+
+		/*! \returns The number of steps between updates. */
+		uint32_t GetPeriod(void) const {
+			return 1u << lod;
+		}
+
+		/*! \returns Whether entity \p id is updated at \p step. */
+		bool IsDue(EntityId id, uint64_t step) const {
+			return ((step + id.index) & (GetPeriod() - 1)) == 0;
+		}
+
+		SimulationLOD lod;
+	};
+}
@@ -1,16 +1,23 @@
 #include "vertexobjectcomponent.h"
 
+IceFairy::VertexObjectComponent::VertexObjectComponent(std::shared_ptr<const Mesh> mesh) :
+	mesh(std::move(mesh)) {
+}
+
 IceFairy::VertexObjectComponent::VertexObjectComponent(
 	const std::vector<unsigned int>& indices,
 	const std::vector<Vertex>& vertices) :
-	indices(std::move(indices)),
-	vertices(std::move(vertices)) {
+	mesh(std::make_shared<const Mesh>(Mesh { indices, vertices })) {
+}
+
+const std::shared_ptr<const IceFairy::Mesh>& IceFairy::VertexObjectComponent::GetMesh(void) const {
+	return mesh;
 }
 
-std::vector<unsigned int>& IceFairy::VertexObjectComponent::GetIndicies(void) {
-	return indices;
+const std::vector<unsigned int>& IceFairy::VertexObjectComponent::GetIndicies(void) const {
+	return mesh->indices;
 }
 
-std::vector<IceFairy::Vertex>& IceFairy::VertexObjectComponent::GetVertices(void) {
-	return vertices;
+const std::vector<IceFairy::Vertex>& IceFairy::VertexObjectComponent::GetVertices(void) const {
+	return mesh->vertices;
 }
\ No newline at end of file
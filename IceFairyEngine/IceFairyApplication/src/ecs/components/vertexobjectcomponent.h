@@ -1,20 +1,35 @@
 #pragma once
 
+#include <memory>
+
 #include "../component.h"
 #include "vulkan/vertexobject.h"
 
 namespace IceFairy {
+	/*! \brief Geometry which never changes once created, shared by every component drawing it. */
+	struct Mesh {
+		std::vector<unsigned int> indices;
+		std::vector<Vertex> vertices;
+	};
+
+	/*! \brief Draws a \ref Mesh.
+	 *
+	 * Only a handle to the mesh is stored, so copying the component, for example when
+	 * instantiating a \ref Prefab, never copies the geometry.
+	 */
 	class VertexObjectComponent : public Component {
 	public:
+		VertexObjectComponent(std::shared_ptr<const Mesh> mesh);
+		/*! \brief Creates a mesh of its own from \p indices and \p vertices. */
 		VertexObjectComponent(
 			const std::vector<unsigned int>& indices,
 			const std::vector<Vertex>& vertices);
 
-		std::vector<unsigned int>& GetIndicies(void);
-		std::vector<Vertex>& GetVertices(void);
+		const std::shared_ptr<const Mesh>& GetMesh(void) const;
+		const std::vector<unsigned int>& GetIndicies(void) const;
+		const std::vector<Vertex>& GetVertices(void) const;
 
 	private:
-		std::vector<unsigned int> indices;
-		std::vector<Vertex> vertices;
+		std::shared_ptr<const Mesh> mesh;
 	};
 }
\ No newline at end of file
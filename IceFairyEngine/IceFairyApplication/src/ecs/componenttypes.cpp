@@ -0,0 +1,44 @@
+#include "componenttypes.h"
+
+std::deque<IceFairy::ComponentInfo> IceFairy::ComponentTypes::infos;
+std::mutex IceFairy::ComponentTypes::mutex;
+
+bool IceFairy::ComponentTypes::FindId(const std::string& name, ComponentTypeId& id) {
+	std::lock_guard<std::mutex> lock(mutex);
+
+	for (auto& info : infos) {
+		if (info.name == name) {
+			id = info.id;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+const IceFairy::ComponentInfo& IceFairy::ComponentTypes::GetInfo(ComponentTypeId id) {
+	std::lock_guard<std::mutex> lock(mutex);
+	return infos[id];
+}
+
+const std::string& IceFairy::ComponentTypes::GetName(ComponentTypeId id) {
+	return GetInfo(id).name;
+}
+
+size_t IceFairy::ComponentTypes::GetCount(void) {
+	std::lock_guard<std::mutex> lock(mutex);
+	return infos.size();
+}
+
+IceFairy::ComponentTypeId IceFairy::ComponentTypes::Register(ComponentInfo info) {
+	std::lock_guard<std::mutex> lock(mutex);
+
+	if (infos.size() >= ICE_FAIRY_MAX_COMPONENT_TYPES) {
+		throw ComponentTypeLimitException(info.name);
+	}
+
+	info.id = (ComponentTypeId) infos.size();
+	infos.push_back(info);
+
+	return info.id;
+}
@@ -1,12 +1,93 @@
 #pragma once
 
-#include <typeindex>
-#include <unordered_map>
+#include <bitset>
+#include <deque>
+#include <mutex>
+#include <type_traits>
 
-#include "components/vertexobjectcomponent.h"
+#include "componentcolumn.h"
+#include "core/utilities/icexception.h"
+
+#ifndef ICE_FAIRY_MAX_COMPONENT_TYPES
+#define ICE_FAIRY_MAX_COMPONENT_TYPES 64
+#endif
 
 namespace IceFairy {
-	static std::unordered_map<std::type_index, std::string> COMPONENT_TYPE_NAMES = {
-		{ typeid(VertexObjectComponent), "VertexObjectComponent" }
+
+	typedef std::bitset<ICE_FAIRY_MAX_COMPONENT_TYPES> ComponentMask;
+
+	class ComponentTypeLimitException : public ICException {
+	public:
+		ComponentTypeLimitException(const std::string& name)
+			: ICException("Cannot register component type '" + name + "', raise ICE_FAIRY_MAX_COMPONENT_TYPES above "
+				+ std::to_string(ICE_FAIRY_MAX_COMPONENT_TYPES)) {
+		}
 	};
-}
\ No newline at end of file
+
+	/*! \brief Hands out dense ids to component types.
+	 *
+	 * Every component type is given the next free id the first time \ref GetId is instantiated
+	 * and called for it, after which the id is a template static, so looking it up costs nothing.
+	 * An entity's component set is then a single \ref ComponentMask.\n
+	 * \c const qualified types share the id of the unqualified type.
+	 */
+	class ComponentTypes {
+	public:
+		template<typename T>
+		static ComponentTypeId GetId(void) {
+			if constexpr (std::is_const<T>::value) {
+				return GetId<typename std::remove_const<T>::type>();
+			}
+			else {
+				static const ComponentTypeId id = Register(ComponentInfo::Create<T>());
+				return id;
+			}
+		}
+
+		template<typename... Ts>
+		static ComponentMask GetMask(void) {
+			ComponentMask mask;
+			(mask.set(GetId<Ts>()), ...);
+			return mask;
+		}
+
+		/*! \brief Sets how components of type \p T which aren't trivially copyable are saved and loaded.
+		 *
+		 * \param save Appends a component to the buffer.
+		 * \param load Returns the component saved in the \p size bytes at \p data.
+		 */
+		template<typename T>
+		static void SetSerializer(std::function<void(const T&, std::vector<unsigned char>&)> save,
+				std::function<T(const unsigned char* data, size_t size)> load) {
+			auto id = GetId<T>();
+			std::lock_guard<std::mutex> lock(mutex);
+			auto& info = infos[id];
+
+			info.save = [save](const void* component, std::vector<unsigned char>& buffer) {
+				save(*static_cast<const T*>(component), buffer);
+			};
+			info.load = [load](ComponentColumn& column, const unsigned char* data, size_t size, Tick tick) {
+				T component = load(data, size);
+				column.PushBack(&component, tick);
+			};
+		}
+
+		/*! \brief Finds the registered type named \p name.
+		 *
+		 * \returns Whether the type has been registered.
+		 */
+		static bool FindId(const std::string& name, ComponentTypeId& id);
+
+		static const ComponentInfo& GetInfo(ComponentTypeId id);
+		static const std::string& GetName(ComponentTypeId id);
+		static size_t GetCount(void);
+
+	private:
+		static ComponentTypeId Register(ComponentInfo info);
+
+		// A deque so references returned by GetInfo survive later registrations
+		static std::deque<ComponentInfo> infos;
+		static std::mutex mutex;
+	};
+
+}
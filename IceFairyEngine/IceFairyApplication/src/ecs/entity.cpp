@@ -1,13 +1,72 @@
 #include "entity.h"
+#include "entityregistry.h"
 
-IceFairy::Entity::Entity(int id) :
+IceFairy::Entity::Entity(EntityId id, EntityRegistry* registry) :
+	registry(registry),
 	id(id) {
 }
 
-std::shared_ptr<IceFairy::Component> IceFairy::Entity::GetComponent(const std::type_index& type) {
-	if (components.find(type) == components.end()) {
-		throw EntityException(id, "Couldn't find component type '" + COMPONENT_TYPE_NAMES[type] + "'");
+void* IceFairy::Entity::GetComponent(ComponentTypeId type) {
+	auto& slot = registry->GetSlot(id);
+	auto column = slot.archetype->GetColumn(type);
+
+	if (column == nullptr && slot.archetype->HasComponent(type)) {
+		return ComponentTypes::GetInfo(type).tag;
+	}
+
+	if (column == nullptr) {
+		throw EntityException(id, "Couldn't find component type '" + ComponentTypes::GetName(type) + "'");
+	}
+
+	return column->Get(slot.row);
+}
+
+const IceFairy::ComponentMask& IceFairy::Entity::GetComponentMask(void) const {
+	return registry->GetSlot(id).archetype->GetMask();
+}
+
+void IceFairy::Entity::MarkChanged(ComponentTypeId type) {
+	registry->MarkChanged(id, type);
+}
+
+IceFairy::Tick IceFairy::Entity::GetAddedTick(ComponentTypeId type) const {
+	auto& slot = registry->GetSlot(id);
+	auto column = slot.archetype->GetColumn(type);
+
+	if (column == nullptr && slot.archetype->HasComponent(type)) {
+		throw EntityException(id, "Tag component type '" + ComponentTypes::GetName(type) + "' has no ticks");
+	}
+
+	if (column == nullptr) {
+		throw EntityException(id, "Couldn't find component type '" + ComponentTypes::GetName(type) + "'");
 	}
 
-	return components[type];
+	return column->GetAddedTick(slot.row);
+}
+
+IceFairy::Tick IceFairy::Entity::GetChangedTick(ComponentTypeId type) const {
+	auto& slot = registry->GetSlot(id);
+	auto column = slot.archetype->GetColumn(type);
+
+	if (column == nullptr && slot.archetype->HasComponent(type)) {
+		throw EntityException(id, "Tag component type '" + ComponentTypes::GetName(type) + "' has no ticks");
+	}
+
+	if (column == nullptr) {
+		throw EntityException(id, "Couldn't find component type '" + ComponentTypes::GetName(type) + "'");
+	}
+
+	return column->GetChangedTick(slot.row);
+}
+
+bool IceFairy::Entity::IsAlive(void) const {
+	return registry->IsAlive(id);
+}
+
+void IceFairy::Entity::Destroy(void) {
+	registry->RemoveEntity(id);
+}
+
+IceFairy::EntityId IceFairy::Entity::GetId(void) const {
+	return id;
 }
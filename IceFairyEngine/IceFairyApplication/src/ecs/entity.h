@@ -1,53 +1,102 @@
 #pragma once
 
-#include <unordered_map>
-#include <typeindex>
 #include <string>
 
 #include "component.h"
 #include "componenttypes.h"
-#include "components/vertexobjectcomponent.h"
+#include "entityid.h"
 #include "core/utilities/icexception.h"
 
-// TODO: Sub-entities
 // TODO: Components should have no logic, only data. Construct systems which can take multiple components and filter out entities based off of them
 namespace IceFairy {
 
+	class EntityRegistry;
+
 	class EntityException : public ICException {
 	public:
-		EntityException(const int& entityId, const std::string& message)
-			: ICException("Entity[" + std::to_string(entityId) + "] encountered an error: " + message) {
+		EntityException(const EntityId& entityId, const std::string& message)
+			: ICException("Entity[" + entityId.Str() + "] encountered an error: " + message) {
 		}
 	};
 
-
+	/*! \brief Lightweight, copyable handle to an entity in an \ref EntityRegistry.
+	 *
+	 * The entity does not own its components, they live in the columns of its current
+	 * \ref Archetype. Adding or removing a component moves the entity to another archetype, which
+	 * invalidates any references previously returned by \ref GetComponent.\n
+	 * Using a handle after its entity has been destroyed throws an \ref EntityException.
+	 */
 	class Entity {
 	public:
-		Entity(int id);
+		Entity(EntityId id, EntityRegistry* registry);
 
-		// TODO: Check is_base_of_v
+		// Defined in entityregistry.h
 		template<typename T, typename... Args, typename std::enable_if<std::is_base_of<Component, T>::value>::type* = nullptr>
-		std::shared_ptr<T> AddComponent(Args&&... args) {
-			auto component = std::make_shared<T>(std::forward<Args>(args)...);
-			components[typeid(T)] = component;
-			return component;
+		T& AddComponent(Args&&... args);
+
+		template<typename T, typename std::enable_if<std::is_base_of<Component, T>::value>::type* = nullptr>
+		void RemoveComponent(void);
+
+		/*! \brief Records that \p T was changed, for systems filtering on \ref EntityRegistry::FILTER_CHANGED. */
+		template<typename T, typename std::enable_if<std::is_base_of<Component, T>::value>::type* = nullptr>
+		inline void MarkChanged(void) {
+			MarkChanged(ComponentTypes::GetId<T>());
 		}
 
+		/*! \returns Whether \p T was added after the tick \p since. */
 		template<typename T, typename std::enable_if<std::is_base_of<Component, T>::value>::type* = nullptr>
-		inline std::shared_ptr<T> GetComponent(void) {
-			return std::static_pointer_cast<T>(GetComponent(typeid(T)));
+		inline bool IsAddedSince(Tick since) const {
+			return IsNewerTick(GetAddedTick(ComponentTypes::GetId<T>()), since);
 		}
 
+		/*! \returns Whether \p T was added or changed after the tick \p since. */
+		template<typename T, typename std::enable_if<std::is_base_of<Component, T>::value>::type* = nullptr>
+		inline bool IsChangedSince(Tick since) const {
+			return IsNewerTick(GetChangedTick(ComponentTypes::GetId<T>()), since);
+		}
+
+		/*! \throws EntityException if the entity doesn't have \p T. */
+		template<typename T, typename std::enable_if<std::is_base_of<Component, T>::value>::type* = nullptr>
+		inline T& GetComponent(void) {
+			return *static_cast<T*>(GetComponent(ComponentTypes::GetId<T>()));
+		}
+
+		// Defined in entityregistry.h
+		/*! \returns The entity's \p T, or null if it has none. Never throws. */
+		template<typename T, typename std::enable_if<std::is_base_of<Component, T>::value>::type* = nullptr>
+		T* TryGet(void) noexcept;
+		/*! \brief Returns the entity's \p T, which it must have, without checking or throwing. */
+		template<typename T, typename std::enable_if<std::is_base_of<Component, T>::value>::type* = nullptr>
+		T& Get(void) noexcept;
+
 		template<typename T, typename std::enable_if<std::is_base_of<Component, T>::value>::type* = nullptr>
 		inline bool HasComponent(void) const {
-			return components.find(typeid(T)) != components.end();
+			return GetComponentMask().test(ComponentTypes::GetId<T>());
 		}
 
-		std::shared_ptr<Component> GetComponent(const std::type_index& type);
+		/*! \returns Whether this entity has every one of the components \p Ts. */
+		template<typename... Ts>
+		inline bool HasComponents(void) const {
+			auto mask = ComponentTypes::GetMask<Ts...>();
+			return (GetComponentMask() & mask) == mask;
+		}
+
+		void* GetComponent(ComponentTypeId type);
+		const ComponentMask& GetComponentMask(void) const;
+		void MarkChanged(ComponentTypeId type);
+		Tick GetAddedTick(ComponentTypeId type) const;
+		Tick GetChangedTick(ComponentTypeId type) const;
+
+		/*! \returns Whether this handle still refers to a live entity. */
+		bool IsAlive(void) const;
+		/*! \brief Destroys the entity and all of its components. */
+		void Destroy(void);
+
+		EntityId GetId(void) const;
 
 	private:
-		std::unordered_map<std::type_index, std::shared_ptr<Component>> components;
-		int id;
+		EntityRegistry* registry;
+		EntityId id;
 	};
 
-}
\ No newline at end of file
+}
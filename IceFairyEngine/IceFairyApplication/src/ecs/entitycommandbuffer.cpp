@@ -0,0 +1,60 @@
+#include "entitycommandbuffer.h"
+
+IceFairy::EntityCommandBuffer::EntityCommandBuffer() :
+	numSpawned(0) {
+}
+
+IceFairy::DeferredEntity IceFairy::EntityCommandBuffer::Spawn(void) {
+	DeferredEntity entity { numSpawned++ };
+
+	commands.push_back({ COMMAND_SPAWN, EntityId { entity.index, 0 }, true, 0, 0 });
+	return entity;
+}
+
+void IceFairy::EntityCommandBuffer::Destroy(EntityId id) {
+	commands.push_back({ COMMAND_DESTROY, id, false, 0, 0 });
+}
+
+void IceFairy::EntityCommandBuffer::Destroy(DeferredEntity entity) {
+	commands.push_back({ COMMAND_DESTROY, EntityId { entity.index, 0 }, true, 0, 0 });
+}
+
+bool IceFairy::EntityCommandBuffer::IsEmpty(void) const {
+	return commands.empty();
+}
+
+size_t IceFairy::EntityCommandBuffer::GetSize(void) const {
+	return commands.size();
+}
+
+void IceFairy::EntityCommandBuffer::Clear(void) {
+	commands.clear();
+	numSpawned = 0;
+
+	for (auto& column : columns) {
+		if (column != nullptr) {
+			column->Clear();
+		}
+	}
+}
+
+void* IceFairy::EntityCommandBuffer::GetComponent(const Command& command) {
+	// Only components with data are given a column
+	if (command.componentType >= columns.size() || columns[command.componentType] == nullptr) {
+		return nullptr;
+	}
+
+	return columns[command.componentType]->Get(command.row);
+}
+
+IceFairy::ComponentColumn& IceFairy::EntityCommandBuffer::GetColumn(ComponentTypeId type) {
+	if (type >= columns.size()) {
+		columns.resize(type + 1);
+	}
+
+	if (columns[type] == nullptr) {
+		columns[type] = std::make_unique<ComponentColumn>(ComponentTypes::GetInfo(type));
+	}
+
+	return *columns[type];
+}
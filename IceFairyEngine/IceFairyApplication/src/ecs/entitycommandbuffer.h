@@ -0,0 +1,129 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <utility>
+
+#include "componentcolumn.h"
+#include "componenttypes.h"
+#include "entityid.h"
+
+namespace IceFairy {
+
+	class EntityRegistry;
+
+	/*! \brief Handle to an entity spawned by an \ref EntityCommandBuffer which doesn't exist yet.
+	 *
+	 * Only meaningful to the buffer which returned it, and only until that buffer is played back.
+	 */
+	struct DeferredEntity {
+		uint32_t index;
+	};
+
+	/*! \brief Records structural changes to apply to an \ref EntityRegistry later.
+	 *
+	 * Entities and components can't be added or removed while systems iterate over them, so
+	 * systems record those changes here instead. The registry applies them in one batch with
+	 * \ref EntityRegistry::Playback, in the order they were recorded.\n
+	 * Entities spawned here are created with all of their components at once, in the archetype
+	 * they end up in.\n
+	 * Commands targeting an entity which has been destroyed by the time they are played back
+	 * are skipped.\n
+	 * A buffer must only be written by one thread at a time, parallel systems should use
+	 * \ref EntityRegistry::GetCommandBuffer, which gives every worker thread its own buffer.
+	 *
+	 * Sample usage:
+	 * \code{.cpp}
+	 * auto& commands = registry.GetCommandBuffer();
+	 * auto bullet = commands.Spawn();
+	 *
+	 * commands.AddComponent<Position>(bullet, 0.0f, 0.0f);
+	 * commands.Destroy(target);
+	 * \endcode
+	 */
+	class EntityCommandBuffer {
+	public:
+		EntityCommandBuffer();
+
+		EntityCommandBuffer(EntityCommandBuffer&&) = default;
+		EntityCommandBuffer& operator=(EntityCommandBuffer&&) = default;
+
+		/*! \brief Records the creation of an entity with no components. */
+		DeferredEntity Spawn(void);
+		void Destroy(EntityId id);
+		void Destroy(DeferredEntity entity);
+
+		template<typename T, typename... Args>
+		void AddComponent(EntityId id, Args&&... args) {
+			AddComponentCommand<T>(id, false, std::forward<Args>(args)...);
+		}
+
+		template<typename T, typename... Args>
+		void AddComponent(DeferredEntity entity, Args&&... args) {
+			AddComponentCommand<T>(EntityId { entity.index, 0 }, true, std::forward<Args>(args)...);
+		}
+
+		template<typename T>
+		void RemoveComponent(EntityId id) {
+			commands.push_back({ COMMAND_REMOVE_COMPONENT, id, false, ComponentTypes::GetId<T>(), 0 });
+		}
+
+		template<typename T>
+		void RemoveComponent(DeferredEntity entity) {
+			commands.push_back({ COMMAND_REMOVE_COMPONENT, EntityId { entity.index, 0 }, true, ComponentTypes::GetId<T>(), 0 });
+		}
+
+		bool IsEmpty(void) const;
+		size_t GetSize(void) const;
+		/*! \brief Discards every recorded command. */
+		void Clear(void);
+
+	private:
+		friend class EntityRegistry;
+
+		enum CommandType {
+			COMMAND_SPAWN,
+			COMMAND_DESTROY,
+			COMMAND_ADD_COMPONENT,
+			COMMAND_REMOVE_COMPONENT
+		};
+
+		struct Command {
+			CommandType type;
+			//! The spawn index rather than an entity when deferred is set
+			EntityId entity;
+			bool deferred;
+			ComponentTypeId componentType;
+			//! Row in the component type's column holding the component to add
+			uint32_t row;
+		};
+
+		template<typename T, typename... Args>
+		void AddComponentCommand(EntityId id, bool deferred, Args&&... args) {
+			auto type = ComponentTypes::GetId<T>();
+
+			// Tags have no data to keep
+			if constexpr (IsTagComponent<T>::value) {
+				commands.push_back({ COMMAND_ADD_COMPONENT, id, deferred, type, 0 });
+			}
+			else {
+				T component(std::forward<Args>(args)...);
+				auto& column = GetColumn(type);
+
+				commands.push_back({ COMMAND_ADD_COMPONENT, id, deferred, type, (uint32_t) column.GetSize() });
+				column.PushBack(&component);
+			}
+		}
+
+		ComponentColumn& GetColumn(ComponentTypeId type);
+		/*! \returns The component an add command adds, null for a tag. */
+		void* GetComponent(const Command& command);
+
+		std::vector<Command> commands;
+		//! Components waiting to be added, indexed by component type
+		std::vector<std::unique_ptr<ComponentColumn>> columns;
+		uint32_t numSpawned;
+	};
+
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <functional>
+
+namespace IceFairy {
+
+	/*! \brief Generational handle to an entity.
+	 *
+	 * \c index points at the entity's slot in the \ref EntityRegistry and \c generation is bumped
+	 * every time that slot is freed, so a handle to a destroyed entity never matches the entity
+	 * which reuses its slot.
+	 */
+	struct EntityId {
+		uint32_t index;
+		uint32_t generation;
+
+		/*! \returns The handle packed into 64 bits, generation in the high half. */
+		uint64_t GetValue(void) const {
+			return ((uint64_t) generation << 32) | index;
+		}
+
+		static EntityId FromValue(uint64_t value) {
+			return EntityId { (uint32_t) value, (uint32_t) (value >> 32) };
+		}
+
+		std::string Str(void) const {
+			return std::to_string(index) + ":" + std::to_string(generation);
+		}
+
+		bool operator==(const EntityId& other) const {
+			return index == other.index && generation == other.generation;
+		}
+
+		bool operator!=(const EntityId& other) const {
+			return !(*this == other);
+		}
+	};
+
+}
+
+namespace std {
+	template<> struct hash<IceFairy::EntityId> {
+		size_t operator()(const IceFairy::EntityId& id) const {
+			return hash<uint64_t>()(id.GetValue());
+		}
+	};
+}
@@ -1,39 +1,666 @@
 #include "entityregistry.h"
 
-IceFairy::EntityRegistry::EntityRegistry() {
+IceFairy::EntityRegistry::EntityRegistry() :
+	commandBuffers(1),
+	numIterating(0),
+	tick(1),
+	step(0),
+	loop(*this),
+	numWorkers(ThreadPool::GetDefaultWorkerCount()),
+	chunkSize(1024) {
+	emptyArchetype = GetArchetype(ComponentMask());
 }
 
 IceFairy::EntityRegistry::~EntityRegistry() {
 }
 
-std::shared_ptr<IceFairy::Entity> IceFairy::EntityRegistry::AddEntity(void) {
-	static int id = 0;
-	entities[id] = std::make_shared<Entity>(id++);
-	return entities[id];
+IceFairy::Entity IceFairy::EntityRegistry::AddEntity(void) {
+	CheckNotIterating("add an entity");
+
+	uint32_t index;
+
+	if (!freeSlots.empty()) {
+		index = freeSlots.back();
+		freeSlots.pop_back();
+	}
+	else {
+		index = (uint32_t) slots.size();
+		slots.push_back({ nullptr, 0, 0 });
+	}
+
+	auto& slot = slots[index];
+	EntityId id { index, slot.generation };
+
+	slot.archetype = emptyArchetype;
+	slot.row = (uint32_t) emptyArchetype->AddEntity(id);
+	NotifyEntityMoved(id, nullptr, emptyArchetype);
+
+	return Entity(id, this);
 }
 
-std::shared_ptr<IceFairy::Entity> IceFairy::EntityRegistry::GetEntity(int id) {
-	if (entities.find(id) == entities.end()) {
-		throw EntityRegistryException("Cannot find entity with id '" + std::to_string(id) + "'");
+IceFairy::Entity IceFairy::EntityRegistry::GetEntity(EntityId id) {
+	if (!IsAlive(id)) {
+		throw EntityRegistryException("Cannot find entity with id '" + id.Str() + "'");
 	}
 
-	return entities[id];
+	return Entity(id, this);
+}
+
+void IceFairy::EntityRegistry::RemoveEntity(EntityId id) {
+	if (!IsAlive(id)) {
+		throw EntityRegistryException("Cannot remove entity with id '" + id.Str() + "'");
+	}
+
+	CheckNotIterating("remove an entity");
+
+	if (transforms.Contains(id)) {
+		std::vector<EntityId> descendants;
+		transforms.GetDescendants(id, descendants);
+		transforms.Remove(id);
+
+		for (auto descendant : descendants) {
+			RemoveEntity(descendant);
+		}
+	}
+
+	auto& slot = slots[id.index];
+	auto archetype = slot.archetype;
+
+	archetype->RemoveEntity(slot.row);
+	UpdateMovedEntity(archetype, slot.row);
+	NotifyEntityMoved(id, archetype, nullptr);
+
+	slot.archetype = nullptr;
+	slot.generation++;
+	freeSlots.push_back(id.index);
+}
+
+IceFairy::Prefab IceFairy::EntityRegistry::CreatePrefab(EntityId id) {
+	if (!IsAlive(id)) {
+		throw EntityRegistryException("Cannot create a prefab from entity with id '" + id.Str() + "'");
+	}
+
+	auto& slot = slots[id.index];
+	Prefab prefab;
+
+	for (ComponentTypeId type = 0; type < ComponentTypes::GetCount(); type++) {
+		if (slot.archetype->HasComponent(type)) {
+			auto column = slot.archetype->GetColumn(type);
+
+			prefab.SetCopy(type, column != nullptr ? column->Get(slot.row) : ComponentTypes::GetInfo(type).tag);
+		}
+	}
+
+	return prefab;
+}
+
+std::vector<IceFairy::EntityId> IceFairy::EntityRegistry::Instantiate(const Prefab& prefab, size_t count) {
+	CheckNotIterating("instantiate a prefab");
+
+	auto archetype = GetArchetype(prefab.GetMask());
+	auto ids = AllocateEntities(count);
+	size_t firstRow = archetype->AddEntities(ids.data(), count);
+
+	try {
+		for (auto& component : prefab.components) {
+			auto column = archetype->GetColumn(component.type);
+
+			// Tags are already in the archetype's mask
+			if (column != nullptr) {
+				column->AppendCopies(component.data, count, GetTick());
+			}
+		}
+	}
+	catch (...) {
+		archetype->Truncate(firstRow);
+		FreeEntities(ids);
+		throw;
+	}
+
+	AssignEntities(ids, archetype, firstRow);
+	return ids;
+}
+
+bool IceFairy::EntityRegistry::IsAlive(EntityId id) const {
+	return id.index < slots.size()
+		&& slots[id.index].generation == id.generation
+		&& slots[id.index].archetype != nullptr;
+}
+
+size_t IceFairy::EntityRegistry::GetEntityCount(void) const {
+	return slots.size() - freeSlots.size();
 }
 
 void IceFairy::EntityRegistry::AddRegisteredModule(std::shared_ptr<Module> module) {
 	registeredModules[typeid(*module)] = module;
 }
 
+const IceFairy::ChunkAllocator& IceFairy::EntityRegistry::GetAllocator(void) const {
+	return allocator;
+}
+
+float IceFairy::EntityRegistry::GetOccupancy(void) const {
+	size_t usedBytes = 0;
+	size_t reservedBytes = 0;
+
+	for (auto& archetype : archetypes) {
+		usedBytes += archetype->GetUsedBytes();
+		reservedBytes += archetype->GetReservedBytes();
+	}
+
+	return reservedBytes == 0 ? 1.0f : (float) usedBytes / reservedBytes;
+}
+
+IceFairy::TransformHierarchy& IceFairy::EntityRegistry::GetTransforms(void) {
+	return transforms;
+}
+
+void IceFairy::EntityRegistry::UpdateTransforms(void) {
+	transforms.Update(&GetThreadPool(), chunkSize);
+}
+
+void IceFairy::EntityRegistry::AddInitialiser(std::function<void(EntityRegistry&)> initialiser) {
+	initialisers.push_back(std::move(initialiser));
+}
+
 void IceFairy::EntityRegistry::Initialise(void) {
-	if (IsModuleRegistered<VulkanModule>()) {
-		auto module = GetRegisteredModule<VulkanModule>();
+	for (auto& initialiser : initialisers) {
+		initialiser(*this);
+	}
+
+	// Uploads the geometry created before the modules are initialised
+	RunSystems();
+}
+
+void IceFairy::EntityRegistry::StartEntityLoop(const std::function<bool(void)>& isRunning) {
+	loop.Run(isRunning);
+}
+
+IceFairy::SimulationLoop& IceFairy::EntityRegistry::GetLoop(void) {
+	return loop;
+}
+
+void IceFairy::EntityRegistry::RunSystems(void) {
+	if (systemBatches.empty()) {
+		BuildSystemBatches();
+	}
+
+	auto& pool = GetThreadPool();
+
+	for (auto& batch : systemBatches) {
+		pool.ParallelFor(batch.size(), 1, [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; i++) {
+				systems[batch[i]].run();
+			}
+		});
+	}
+
+	FlushCommandBuffers();
+	DispatchEvents();
+
+	step++;
+}
+
+uint64_t IceFairy::EntityRegistry::GetStep(void) const {
+	return step;
+}
+
+IceFairy::Tick IceFairy::EntityRegistry::GetTick(void) const {
+	return tick.load();
+}
+
+IceFairy::Tick IceFairy::EntityRegistry::AdvanceTick(void) {
+	return tick.fetch_add(1);
+}
+
+IceFairy::EventBus& IceFairy::EntityRegistry::GetEvents(void) {
+	return events;
+}
+
+void IceFairy::EntityRegistry::DispatchEvents(void) {
+	for (auto& handler : eventHandlers) {
+		handler();
+	}
+}
+
+IceFairy::EntityCommandBuffer& IceFairy::EntityRegistry::GetCommandBuffer(void) {
+	// Workers of any other pool, e.g. another registry's, share the owning thread's buffer
+	if (threadPool == nullptr || ThreadPool::GetCurrentPool() != threadPool.get()) {
+		return commandBuffers[0];
+	}
+
+	size_t index = (size_t) (ThreadPool::GetCurrentWorkerIndex() + 1);
+
+	return index < commandBuffers.size() ? commandBuffers[index] : commandBuffers[0];
+}
+
+void IceFairy::EntityRegistry::FlushCommandBuffers(void) {
+	for (auto& buffer : commandBuffers) {
+		if (!buffer.IsEmpty()) {
+			Playback(buffer);
+		}
+	}
+}
+
+void IceFairy::EntityRegistry::Playback(EntityCommandBuffer& buffer) {
+	CheckNotIterating("play back a command buffer");
+
+	std::vector<SpawnedEntity> spawned(buffer.numSpawned);
+
+	for (auto& command : buffer.commands) {
+		if (command.deferred) {
+			auto& entity = spawned[command.entity.index];
+
+			// Commands recorded after the entity was destroyed are dropped, as for any other entity
+			if (command.type != EntityCommandBuffer::COMMAND_SPAWN && !entity.isAlive) {
+				continue;
+			}
+
+			auto type = command.componentType;
+			auto existing = std::find_if(entity.components.begin(), entity.components.end(),
+				[type](const std::pair<ComponentTypeId, void*>& component) { return component.first == type; });
+
+			switch (command.type) {
+			case EntityCommandBuffer::COMMAND_SPAWN:
+				entity.isAlive = true;
+				break;
+			case EntityCommandBuffer::COMMAND_DESTROY:
+				entity.isAlive = false;
+				break;
+			case EntityCommandBuffer::COMMAND_ADD_COMPONENT:
+				// A later add of the same type replaces the earlier one
+				if (existing != entity.components.end()) {
+					existing->second = buffer.GetComponent(command);
+				}
+				else {
+					entity.mask.set(type);
+					entity.components.push_back({ type, buffer.GetComponent(command) });
+				}
+				break;
+			case EntityCommandBuffer::COMMAND_REMOVE_COMPONENT:
+				if (existing != entity.components.end()) {
+					entity.mask.reset(type);
+					entity.components.erase(existing);
+				}
+				break;
+			default:
+				break;
+			}
+
+			continue;
+		}
+
+		// Several systems may have destroyed the same entity
+		if (!IsAlive(command.entity)) {
+			continue;
+		}
+
+		switch (command.type) {
+		case EntityCommandBuffer::COMMAND_DESTROY:
+			RemoveEntity(command.entity);
+			break;
+		case EntityCommandBuffer::COMMAND_ADD_COMPONENT:
+			AddComponent(command.entity, command.componentType, buffer.GetComponent(command));
+			break;
+		case EntityCommandBuffer::COMMAND_REMOVE_COMPONENT:
+			RemoveComponent(command.entity, command.componentType);
+			break;
+		default:
+			break;
+		}
+	}
+
+	// Grouped by their final set of components, in the order the first of each was spawned
+	std::vector<std::pair<ComponentMask, std::vector<SpawnedEntity*>>> groups;
+	std::unordered_map<ComponentMask, size_t> groupOfMask;
+
+	for (auto& entity : spawned) {
+		if (!entity.isAlive) {
+			continue;
+		}
+
+		auto inserted = groupOfMask.emplace(entity.mask, groups.size());
+		if (inserted.second) {
+			groups.push_back({ entity.mask, {} });
+		}
+
+		groups[inserted.first->second].second.push_back(&entity);
+	}
+
+	for (auto& [mask, entities] : groups) {
+		AddSpawnedEntities(mask, entities);
+	}
+
+	buffer.Clear();
+}
+
+void IceFairy::EntityRegistry::SetWorkerCount(unsigned int numWorkers) {
+	if (this->numWorkers != numWorkers) {
+		this->numWorkers = numWorkers;
+		threadPool.reset();
+	}
+}
+
+unsigned int IceFairy::EntityRegistry::GetWorkerCount(void) {
+	return numWorkers;
+}
+
+void IceFairy::EntityRegistry::SetChunkSize(size_t chunkSize) {
+	this->chunkSize = std::max<size_t>(chunkSize, 1);
+}
+
+void* IceFairy::EntityRegistry::AddComponent(EntityId id, ComponentTypeId type, void* component) {
+	auto& slot = GetSlot(id);
+	auto column = slot.archetype->GetColumn(type);
+
+	// A tag, which has no column, only needs to be in the mask
+	if (column == nullptr && slot.archetype->HasComponent(type)) {
+		return ComponentTypes::GetInfo(type).tag;
+	}
 
-		Schedule(std::make_shared<VertexObjectCreationJob>(module));
+	if (column != nullptr) {
+		auto& info = column->GetInfo();
+		void* existing = column->Get(slot.row);
+
+		info.destroy(existing);
+		info.moveConstruct(existing, component);
+		column->MarkChanged(slot.row, GetTick());
+		return existing;
+	}
+
+	auto target = GetAddEdge(slot.archetype, type);
+	auto targetColumn = target->GetColumn(type);
+
+	MoveEntity(slot, target);
+
+	if (targetColumn == nullptr) {
+		return ComponentTypes::GetInfo(type).tag;
+	}
+
+	targetColumn->PushBack(component, GetTick());
+	return targetColumn->Get(slot.row);
+}
+
+void IceFairy::EntityRegistry::RemoveComponent(EntityId id, ComponentTypeId type) {
+	auto& slot = GetSlot(id);
+
+	if (!slot.archetype->HasComponent(type)) {
+		return;
+	}
+
+	MoveEntity(slot, GetRemoveEdge(slot.archetype, type));
+}
+
+void IceFairy::EntityRegistry::MarkChanged(EntityId id, ComponentTypeId type) {
+	auto& slot = GetSlot(id);
+	auto column = slot.archetype->GetColumn(type);
+
+	if (column != nullptr) {
+		column->MarkChanged(slot.row, GetTick());
 	}
 }
 
-void IceFairy::EntityRegistry::StartEntityLoop(void) {
-	for (auto& [id, entity] : entities) {
-		// currently no-op
+void IceFairy::EntityRegistry::CheckNotIterating(const std::string& action) const {
+	if (numIterating.load() > 0) {
+		throw EntityRegistryException("Cannot " + action + " while a system is running, record it in an EntityCommandBuffer instead");
 	}
 }
+
+void IceFairy::EntityRegistry::CheckRateMode(ChangeFilter filter, RateMode rate) {
+	if (rate == RATE_LOD && filter != FILTER_NONE) {
+		throw EntityRegistryException("Cannot combine RATE_LOD with a change filter, entities skipped by their LOD would miss changes");
+	}
+}
+
+IceFairy::Archetype* IceFairy::EntityRegistry::GetArchetype(const ComponentMask& mask) {
+	auto it = archetypeLookup.find(mask);
+	if (it != archetypeLookup.end()) {
+		return it->second;
+	}
+
+	auto archetype = archetypes.emplace_back(std::make_unique<Archetype>(mask, allocator)).get();
+	archetypeLookup[mask] = archetype;
+
+	for (auto& [key, view] : views) {
+		view->OnArchetypeCreated(archetype);
+	}
+
+	return archetype;
+}
+
+IceFairy::Archetype* IceFairy::EntityRegistry::GetAddEdge(Archetype* source, ComponentTypeId type) {
+	auto target = source->GetAddEdge(type);
+
+	if (target == nullptr) {
+		target = GetArchetype(ComponentMask(source->GetMask()).set(type));
+
+		source->SetAddEdge(type, target);
+		target->SetRemoveEdge(type, source);
+	}
+
+	return target;
+}
+
+IceFairy::Archetype* IceFairy::EntityRegistry::GetRemoveEdge(Archetype* source, ComponentTypeId type) {
+	auto target = source->GetRemoveEdge(type);
+
+	if (target == nullptr) {
+		target = GetArchetype(ComponentMask(source->GetMask()).reset(type));
+
+		source->SetRemoveEdge(type, target);
+		target->SetAddEdge(type, source);
+	}
+
+	return target;
+}
+
+IceFairy::EntityRegistry::EntitySlot& IceFairy::EntityRegistry::GetSlot(EntityId id) {
+	if (!IsAlive(id)) {
+		throw EntityException(id, "Entity has been destroyed");
+	}
+
+	return slots[id.index];
+}
+
+void IceFairy::EntityRegistry::MoveEntity(EntitySlot& slot, Archetype* target) {
+	CheckNotIterating("add or remove a component");
+
+	auto source = slot.archetype;
+	auto id = source->GetEntities()[slot.row];
+	size_t row = target->GetSize();
+
+	source->MoveEntity(slot.row, *target);
+	UpdateMovedEntity(source, slot.row);
+
+	slot.archetype = target;
+	slot.row = (uint32_t) row;
+
+	NotifyEntityMoved(id, source, target);
+}
+
+std::vector<IceFairy::EntityId> IceFairy::EntityRegistry::AllocateEntities(size_t count) {
+	std::vector<EntityId> ids;
+	ids.reserve(count);
+
+	while (ids.size() < count && !freeSlots.empty()) {
+		uint32_t index = freeSlots.back();
+		freeSlots.pop_back();
+		ids.push_back({ index, slots[index].generation });
+	}
+
+	size_t numNew = count - ids.size();
+	uint32_t first = (uint32_t) slots.size();
+	slots.resize(slots.size() + numNew, { nullptr, 0, 0 });
+
+	for (uint32_t index = first; index < slots.size(); index++) {
+		ids.push_back({ index, 0 });
+	}
+
+	return ids;
+}
+
+void IceFairy::EntityRegistry::AssignEntities(const std::vector<EntityId>& ids, Archetype* archetype, size_t firstRow) {
+	for (size_t i = 0; i < ids.size(); i++) {
+		auto& slot = slots[ids[i].index];
+
+		slot.archetype = archetype;
+		slot.row = (uint32_t) (firstRow + i);
+		NotifyEntityMoved(ids[i], nullptr, archetype);
+	}
+}
+
+void IceFairy::EntityRegistry::FreeEntities(const std::vector<EntityId>& ids) {
+	// The ids were never handed out, so the generations are left as they are.
+	// Reversed so the slots are reused in the same order next time.
+	for (auto it = ids.rbegin(); it != ids.rend(); ++it) {
+		freeSlots.push_back(it->index);
+	}
+}
+
+void IceFairy::EntityRegistry::AddSpawnedEntities(const ComponentMask& mask, const std::vector<SpawnedEntity*>& entities) {
+	auto archetype = GetArchetype(mask);
+	auto ids = AllocateEntities(entities.size());
+	size_t firstRow = archetype->AddEntities(ids.data(), ids.size());
+
+	try {
+		for (ComponentTypeId type = 0; type < ComponentTypes::GetCount(); type++) {
+			auto column = mask.test(type) ? archetype->GetColumn(type) : nullptr;
+
+			// Tags are already in the archetype's mask
+			if (column == nullptr) {
+				continue;
+			}
+
+			for (auto entity : entities) {
+				for (auto& component : entity->components) {
+					if (component.first == type) {
+						column->PushBack(component.second, GetTick());
+						break;
+					}
+				}
+			}
+		}
+	}
+	catch (...) {
+		archetype->Truncate(firstRow);
+		FreeEntities(ids);
+		throw;
+	}
+
+	AssignEntities(ids, archetype, firstRow);
+}
+
+void IceFairy::EntityRegistry::UpdateMovedEntity(Archetype* archetype, size_t row) {
+	// The archetype's last row was swapped into the hole
+	if (row < archetype->GetSize()) {
+		slots[archetype->GetEntities()[row].index].row = (uint32_t) row;
+	}
+}
+
+std::shared_ptr<IceFairy::EntityViewBase> IceFairy::EntityRegistry::GetView(const ComponentMask& mask, const ComponentMask& exclude) {
+	ViewKey key { mask, exclude };
+	auto it = views.find(key);
+	if (it != views.end()) {
+		return it->second;
+	}
+
+	auto view = std::make_shared<EntityViewBase>(mask, exclude);
+
+	for (auto& archetype : archetypes) {
+		view->OnArchetypeCreated(archetype.get());
+
+		for (auto id : archetype->GetEntities()) {
+			view->OnEntityMoved(id, nullptr, archetype.get());
+		}
+	}
+
+	views[key] = view;
+	return view;
+}
+
+void IceFairy::EntityRegistry::NotifyEntityMoved(EntityId id, const Archetype* from, const Archetype* to) {
+	for (auto& [key, view] : views) {
+		view->OnEntityMoved(id, from, to);
+	}
+}
+
+bool IceFairy::EntityRegistry::ColumnsMatch(ComponentColumn* const* columns, size_t numColumns, const RowFilter& rows) {
+	for (size_t i = 0; i < numColumns; i++) {
+		// Tags have no ticks
+		if (columns[i] == nullptr) {
+			continue;
+		}
+
+		Tick last = rows.filter == FILTER_ADDED ? columns[i]->GetLastAddedTick() : columns[i]->GetLastChangedTick();
+
+		if (IsNewerTick(last, rows.since)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool IceFairy::EntityRegistry::RowMatches(ComponentColumn* const* columns, size_t numColumns, size_t row, const RowFilter& rows) {
+	for (size_t i = 0; i < numColumns; i++) {
+		if (columns[i] == nullptr) {
+			continue;
+		}
+
+		Tick tick = rows.filter == FILTER_ADDED ? columns[i]->GetAddedTick(row) : columns[i]->GetChangedTick(row);
+
+		if (IsNewerTick(tick, rows.since)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+std::vector<IceFairy::EntityRegistry::ArchetypeChunk> IceFairy::EntityRegistry::GetChunks(const EntityViewBase& view) {
+	std::vector<ArchetypeChunk> chunks;
+
+	for (auto archetype : view.GetArchetypes()) {
+		for (size_t begin = 0; begin < archetype->GetSize(); begin += chunkSize) {
+			chunks.push_back({ archetype, begin, std::min(begin + chunkSize, archetype->GetSize()) });
+		}
+	}
+
+	return chunks;
+}
+
+void IceFairy::EntityRegistry::BuildSystemBatches(void) {
+	std::vector<size_t> batchOf(systems.size());
+
+	for (size_t i = 0; i < systems.size(); i++) {
+		size_t batch = 0;
+
+		// Go after every earlier system this one depends on
+		for (size_t j = 0; j < i; j++) {
+			if (systems[i].access.Conflicts(systems[j].access)) {
+				batch = std::max(batch, batchOf[j] + 1);
+			}
+		}
+
+		batchOf[i] = batch;
+
+		if (batch == systemBatches.size()) {
+			systemBatches.emplace_back();
+		}
+		systemBatches[batch].push_back(i);
+	}
+}
+
+IceFairy::ThreadPool& IceFairy::EntityRegistry::GetThreadPool(void) {
+	// Created on first use so registries which never run in parallel don't spawn threads
+	if (threadPool == nullptr) {
+		threadPool = std::make_unique<ThreadPool>(numWorkers);
+
+		// Only ever grown, so commands recorded before a resize aren't lost
+		if (commandBuffers.size() < numWorkers + 1) {
+			commandBuffers.resize(numWorkers + 1);
+		}
+	}
+
+	return *threadPool;
+}
@@ -2,16 +2,32 @@
 
 #include <string>
 #include <unordered_map>
+#include <vector>
+#include <deque>
 #include <typeindex>
 #include <memory>
+#include <algorithm>
+#include <functional>
+#include <atomic>
+#include <array>
+#include <utility>
+#include <type_traits>
+#include <cstring>
 
 #include "core/utilities/icexception.h"
 #include "entity.h"
+#include "archetype.h"
+#include "entityview.h"
+#include "systemaccess.h"
+#include "entitycommandbuffer.h"
+#include "transformhierarchy.h"
+#include "prefab.h"
+#include "eventbus.h"
+#include "simulationloop.h"
+#include "components/simulationlodcomponent.h"
 #include "core/module.h"
-#include "vulkan/vulkanmodule.h"
-#include "components/vertexobjectcomponent.h"
+#include "core/utilities/threadpool.h"
 #include "jobsystem.h"
-#include "systems/vertexobjectsystem.h"
 
 namespace IceFairy {
 
@@ -22,30 +38,136 @@ namespace IceFairy {
 		}
 	};
 
+	/*! \brief Owns every entity and stores their components in archetype tables.
+	 *
+	 * Entities with the same set of component types share an \ref Archetype, which keeps one
+	 * contiguous \ref ComponentColumn per component type. \ref Schedule walks those columns
+	 * linearly for every archetype containing the types a system asks for.\n
+	 * Systems added with \ref AddSystem are run together by \ref RunSystems, which runs
+	 * systems whose component access doesn't overlap at the same time.\n
+	 * Entities and components can't be added or removed while a system runs, systems record
+	 * those changes in an \ref EntityCommandBuffer instead.
+	 */
 	class EntityRegistry {
 	public:
+		/*! \brief How \ref Schedule runs a system over its matching entities. */
+		enum ExecutionMode {
+			//! Run every entity on the calling thread
+			EXECUTION_SERIAL,
+			//! Split matching entities into chunks and run them across the thread pool
+			EXECUTION_PARALLEL
+		};
+
+		/*! \brief Which of its matching entities \ref Schedule runs a system over. */
+		enum ChangeFilter {
+			//! Every matching entity
+			FILTER_NONE,
+			//! Entities where any of the system's components was added since the given tick
+			FILTER_ADDED,
+			//! Entities where any of the system's components was added or changed since the given tick
+			FILTER_CHANGED
+		};
+
+		/*! \brief How often \ref Schedule runs a system over each of its matching entities. */
+		enum RateMode {
+			//! Every time the system runs
+			RATE_FULL,
+			//! As often as the entity's \ref SimulationLODComponent says, every time if it has none
+			RATE_LOD
+		};
+
 		EntityRegistry();
 		~EntityRegistry();
 
-		std::shared_ptr<Entity> AddEntity(void);
-		std::shared_ptr<Entity> GetEntity(int id);
+		/*! \brief Creates an entity with no components, reusing a free slot if there is one.
+		 *
+		 * \throws EntityRegistryException if called while a system is running.
+		 */
+		Entity AddEntity(void);
+		/*! \brief Creates \p count entities with the components \p Ts in one go.
+		 *
+		 * Every entity goes straight into the archetype for \p Ts, and each component column is
+		 * grown once and written in place, so spawning thousands of entities costs a handful of
+		 * allocations rather than an archetype move per component. Sample usage:
+		 * \code{.cpp}
+		 * std::vector<Position> positions = ...;
+		 *
+		 * auto ids = registry.AddEntities<Position, Velocity>(positions.size(), positions,
+		 *     [](size_t i) { return Velocity(0.0f, -1.0f); });
+		 * \endcode
+		 * There is one source per component type, which is either:
+		 * - a pointer to, or a contiguous container such as \c std::vector of, at least \p count
+		 *   components to copy. Trivially copyable components are copied with a single \c memcpy.
+		 * - a generator called as \c source(i) for the i-th entity, returning its component.
+		 *
+		 * Tags have no data, so the source of a tag is ignored and can be any value, such as an
+		 * instance of the tag.
+		 *
+		 * If a component throws while being constructed no entity is created.
+		 *
+		 * \returns The ids of the new entities, in the order of their components.
+		 * \throws EntityRegistryException if a container holds fewer than \p count components, or if
+		 * called while a system is running.
+		 */
+		template<typename... Ts, typename... Sources>
+		std::vector<EntityId> AddEntities(size_t count, Sources&&... sources) {
+			static_assert(sizeof...(Ts) == sizeof...(Sources), "AddEntities needs one source per component type");
 
-		void AddRegisteredModule(std::shared_ptr<Module> module);
+			CheckNotIterating("add entities");
+			(CheckSourceSize<Ts>(sources, count), ...);
 
-		void Initialise(void);
-		void StartEntityLoop(void);
+			auto archetype = GetArchetype(ComponentTypes::GetMask<Ts...>());
+			auto ids = AllocateEntities(count);
+			size_t firstRow = archetype->AddEntities(ids.data(), count);
 
-		// TODO: Multithreading and consider moving to a special JobSystem class
-		template<typename... Ts>
-		void Schedule(std::shared_ptr<JobSystem<Ts...>> system) {
-			for (auto &[id, entity] : entities) {
-				if ((entity->HasComponent<Ts>() && ...)) {
-					system->Execute(entity->GetComponent<Ts>()...);
-				}
+			try {
+				(FillColumn<Ts>(archetype->GetColumn(ComponentTypes::GetId<Ts>()), count, sources), ...);
+			}
+			catch (...) {
+				archetype->Truncate(firstRow);
+				FreeEntities(ids);
+				throw;
 			}
+
+			AssignEntities(ids, archetype, firstRow);
+			return ids;
 		}
+		/*! \brief Copies every component of the entity \p id into a new \ref Prefab.
+		 *
+		 * \throws EntityRegistryException if \p id has been destroyed or never existed.
+		 * \throws PrefabException if one of the components can't be copied.
+		 */
+		Prefab CreatePrefab(EntityId id);
+		/*! \brief Creates \p count entities with a copy of every component in \p prefab.
+		 *
+		 * As with \ref AddEntities the entities are placed straight into their archetype, each
+		 * column grows once, and trivially copyable components are copied in bulk. If a component
+		 * throws while being copied no entity is created.
+		 *
+		 * \returns The ids of the new entities.
+		 * \throws EntityRegistryException if called while a system is running.
+		 */
+		std::vector<EntityId> Instantiate(const Prefab& prefab, size_t count);
+		/*! \brief Returns a handle to the entity \p id.
+		 *
+		 * \throws EntityRegistryException if \p id has been destroyed or never existed.
+		 */
+		Entity GetEntity(EntityId id);
+		/*! \brief Destroys the entity \p id and frees its slot for reuse.
+		 *
+		 * Any children it has in the \ref TransformHierarchy are destroyed along with it.
+		 *
+		 * \throws EntityRegistryException if \p id has been destroyed or never existed, or if
+		 * called while a system is running.
+		 */
+		void RemoveEntity(EntityId id);
+		/*! \returns Whether \p id refers to a live entity, in constant time. */
+		bool IsAlive(EntityId id) const;
+		/*! \returns The number of live entities. */
+		size_t GetEntityCount(void) const;
+
+		void AddRegisteredModule(std::shared_ptr<Module> module);
 
-	private:
 		template<typename T>
 		bool IsModuleRegistered(void) {
 			return registeredModules.find(typeid(T)) != registeredModules.end();
@@ -56,8 +178,584 @@ namespace IceFairy {
 			return std::dynamic_pointer_cast<T>(registeredModules[typeid(T)]);
 		}
 
+		/*! \returns The allocator every archetype takes its component memory from. */
+		const ChunkAllocator& GetAllocator(void) const;
+		/*! \returns The fraction of reserved component memory holding live components, from 0 to 1. */
+		float GetOccupancy(void) const;
+
+		/*! \returns The transforms and parent/child relationships of the entities. */
+		TransformHierarchy& GetTransforms(void);
+		/*! \brief Recomputes the changed world transforms, splitting each depth level across the thread pool. */
+		void UpdateTransforms(void);
+
+		/*! \brief Adds a function \ref Initialise calls with the registry.
+		 *
+		 * Lets a module hook up the systems and event handlers it needs, for example
+		 * \ref AddVertexObjectSystems, without the registry itself depending on the module.
+		 */
+		void AddInitialiser(std::function<void(EntityRegistry&)> initialiser);
+		/*! \brief Runs every initialiser, then the systems once so anything created beforehand is picked up. */
+		void Initialise(void);
+		/*! \brief Runs the \ref SimulationLoop, stepping the systems at a fixed rate until \p isRunning returns false.
+		 *
+		 * For when nothing else owns the main loop, a render loop should call
+		 * \ref SimulationLoop::Frame itself once per frame instead.
+		 */
+		void StartEntityLoop(const std::function<bool(void)>& isRunning);
+		/*! \returns The loop which steps the systems at a fixed rate and runs time-sliced tasks. */
+		SimulationLoop& GetLoop(void);
+
+		/*! \brief Sets the number of worker threads used by \ref EXECUTION_PARALLEL.
+		 *
+		 * 0 makes parallel schedules fall back to running serially on the calling thread.
+		 */
+		void SetWorkerCount(unsigned int numWorkers);
+		unsigned int GetWorkerCount(void);
+		/*! \brief Sets the maximum number of entities given to a single parallel task. */
+		void SetChunkSize(size_t chunkSize);
+
+		/*! \returns The tick changes made outside of systems are recorded at.
+		 *
+		 * Every run of a system takes a tick of its own and marks the components it writes, the
+		 * non-\c const ones, as changed at it.
+		 */
+		Tick GetTick(void) const;
+		/*! \brief Ends the current tick and starts the next one.
+		 *
+		 * \returns The tick which just ended. Any change made afterwards is newer than it.
+		 */
+		Tick AdvanceTick(void);
+
+		// TODO: Consider moving to a special JobSystem class
+		/*! \brief Runs \p system over every entity which has all of the components \p Ts.
+		 *
+		 * With \ref EXECUTION_PARALLEL the system's \c Execute is called concurrently from
+		 * several threads, so it must be safe to do so.\n
+		 * \p filter skips entities whose components weren't added or changed after \p since,
+		 * archetypes with no such entity are skipped without visiting their rows.\n
+		 * With \ref RATE_LOD entities with a \ref SimulationLODComponent are only run on the
+		 * steps they are due at, counted by \ref GetStep.
+		 *
+		 * \returns The tick the system ran at, pass it as \p since to only see later changes.
+		 * \throws EntityRegistryException if \ref RATE_LOD is combined with a filter, as changes
+		 * made while an entity is skipped would never be seen.
+		 */
+		template<typename... Ts>
+		Tick Schedule(std::shared_ptr<JobSystem<Ts...>> system, ExecutionMode mode = EXECUTION_SERIAL,
+				ChangeFilter filter = FILTER_NONE, Tick since = 0, RateMode rate = RATE_FULL) {
+			return Schedule(system, Without<>(), mode, filter, since, rate);
+		}
+
+		/*! \brief Runs \p system over every entity which has all of the components \p Ts and none of \p Es. */
+		template<typename... Ts, typename... Es>
+		Tick Schedule(std::shared_ptr<JobSystem<Ts...>> system, Without<Es...> exclude, ExecutionMode mode = EXECUTION_SERIAL,
+				ChangeFilter filter = FILTER_NONE, Tick since = 0, RateMode rate = RATE_FULL) {
+			CheckRateMode(filter, rate);
+
+			auto& view = *GetView(ComponentTypes::GetMask<Ts...>(), exclude.GetMask());
+			IterationGuard guard(numIterating);
+			RowFilter rows { filter, since, AdvanceTick(), rate, step };
+
+			if (mode == EXECUTION_SERIAL) {
+				for (auto archetype : view.GetArchetypes()) {
+					ExecuteRows(*system, *archetype, 0, archetype->GetSize(), rows);
+				}
+				return rows.tick;
+			}
+
+			auto chunks = GetChunks(view);
+
+			GetThreadPool().ParallelFor(chunks.size(), 1, [&](size_t begin, size_t end) {
+				for (size_t i = begin; i < end; i++) {
+					auto& chunk = chunks[i];
+					ExecuteRows(*system, *chunk.archetype, chunk.begin, chunk.end, rows);
+				}
+			});
+
+			return rows.tick;
+		}
+
+		/*! \brief Adds \p system to the systems run by \ref RunSystems.
+		 *
+		 * The system's access is taken from \p Ts: a \c const component is only read, any other
+		 * component is written. Sample usage:
+		 * \code{.cpp}
+		 * // Writes Position, reads Velocity
+		 * registry.AddSystem(std::make_shared<JobSystem<Position, const Velocity>>());
+		 * \endcode
+		 * Systems must not add or remove entities or components while they run.\n
+		 * \p filter is applied relative to the system's previous run, so for example
+		 * \ref FILTER_CHANGED only visits entities changed since the system last ran.\n
+		 * With \ref RATE_LOD the system runs over distant or idle entities less often, see
+		 * \ref SimulationLODComponent.
+		 *
+		 * \throws EntityRegistryException if \ref RATE_LOD is combined with a filter.
+		 */
+		template<typename... Ts>
+		void AddSystem(std::shared_ptr<JobSystem<Ts...>> system, ExecutionMode mode = EXECUTION_SERIAL,
+				ChangeFilter filter = FILTER_NONE, RateMode rate = RATE_FULL) {
+			AddSystem(system, Without<>(), mode, filter, rate);
+		}
+
+		/*! \brief Adds \p system to be run over the entities with none of the components \p Es.
+		 *
+		 * Sample usage:
+		 * \code{.cpp}
+		 * registry.AddSystem(std::make_shared<JobSystem<Position, const Velocity>>(), Without<Static>());
+		 * \endcode
+		 */
+		template<typename... Ts, typename... Es>
+		void AddSystem(std::shared_ptr<JobSystem<Ts...>> system, Without<Es...> exclude, ExecutionMode mode = EXECUTION_SERIAL,
+				ChangeFilter filter = FILTER_NONE, RateMode rate = RATE_FULL) {
+			CheckRateMode(filter, rate);
+
+			// Built now, as views can't be created safely once systems run concurrently
+			GetView(ComponentTypes::GetMask<Ts...>(), exclude.GetMask());
+
+			auto access = SystemAccess::Create<Ts...>();
+
+			// Decides which entities run, so mustn't overlap a system writing it
+			if (rate == RATE_LOD) {
+				access.reads.set(ComponentTypes::GetId<SimulationLODComponent>());
+			}
+
+			systems.push_back({
+				access,
+				[this, system, exclude, mode, filter, rate, lastRun = Tick(0)]() mutable {
+					lastRun = Schedule(system, exclude, mode, filter, lastRun, rate);
+				}
+			});
+			systemBatches.clear();
+		}
+
+		/*! \brief Runs every system added with \ref AddSystem once.
+		 *
+		 * Systems are split into batches: a system goes in the batch after the last earlier
+		 * system it conflicts with, so systems touching the same components always run in the
+		 * order they were added. The systems in a batch run concurrently on the thread pool.\n
+		 * The command buffers are played back once every system has run, then the events the
+		 * systems emitted are dispatched to their handlers.
+		 */
+		void RunSystems(void);
+		/*! \returns The number of times \ref RunSystems has run, which decides the entities
+		 * \ref RATE_LOD systems update.
+		 */
+		uint64_t GetStep(void) const;
+
+		/*! \brief Returns the command buffer for the calling thread.
+		 *
+		 * Every worker thread of the registry's pool has its own buffer, so systems running with
+		 * \ref EXECUTION_PARALLEL can record commands without locking. Any other thread gets the
+		 * buffer of the thread owning the registry.
+		 */
+		EntityCommandBuffer& GetCommandBuffer(void);
+		/*! \brief Plays back and clears every buffer returned by \ref GetCommandBuffer. */
+		void FlushCommandBuffers(void);
+		/*! \brief Applies every command in \p buffer in the order they were recorded, then clears it.
+		 *
+		 * Spawned entities are gathered up first: each one's components are collected into its
+		 * final set, and every spawned entity with the same set is added to that archetype in
+		 * one go, as \ref Instantiate does, rather than moved through an archetype per component.
+		 *
+		 * \throws EntityRegistryException if called while a system is running.
+		 */
+		void Playback(EntityCommandBuffer& buffer);
+
+		/*! \returns The events systems emit for each other and for modules. */
+		EventBus& GetEvents(void);
+
+		/*! \brief Calls \p handler with every event of type \p E emitted since the last \ref DispatchEvents.
+		 *
+		 * Handlers run on the thread calling \ref RunSystems once every system has run and the
+		 * command buffers have been played back, so unlike systems they may freely add and
+		 * remove entities and call into modules which aren't thread-safe.\n
+		 * Every handler of a type sees every event of it, in the order the handlers were added.
+		 */
+		template<typename E>
+		void AddEventHandler(std::function<void(const E&)> handler) {
+			typedef std::vector<std::function<void(const E&)>> HandlerList;
+			auto& list = eventHandlerLists[std::type_index(typeid(E))];
+
+			// The queue can only be drained once, so the first handler of a type drains it for all of them
+			if (list == nullptr) {
+				auto handlers = std::make_shared<HandlerList>();
+				list = handlers;
+
+				eventHandlers.push_back([this, handlers]() {
+					events.Drain<E>([&handlers](const E& event) {
+						for (auto& handler : *handlers) {
+							handler(event);
+						}
+					});
+				});
+			}
+
+			std::static_pointer_cast<HandlerList>(list)->push_back(std::move(handler));
+		}
+
+		/*! \brief Drains every event type with a handler, in the order each type's first handler was added. */
+		void DispatchEvents(void);
+
+		/*! \brief Returns the cached view of every entity with all of the components \p Ts and
+		 * none of \p Es.
+		 *
+		 * The view is built the first time it is asked for and is then kept up to date as
+		 * components are added and removed, so later calls cost a single lookup.
+		 */
+		template<typename... Ts, typename... Es>
+		EntityView<Ts...> View(Without<Es...> exclude = Without<>()) {
+			return EntityView<Ts...>(GetView(ComponentTypes::GetMask<Ts...>(), exclude.GetMask()));
+		}
+
+		/*! \returns The \p T of entity \p id, or null if the entity has none or isn't alive.
+		 *
+		 * Costs a liveness check and a mask test, it never throws, so systems can probe for
+		 * optional components on the hot path.
+		 */
+		template<typename T>
+		T* TryGet(EntityId id) noexcept {
+			if (!IsAlive(id)) {
+				return nullptr;
+			}
+
+			auto& slot = slots[id.index];
+			auto type = ComponentTypes::GetId<T>();
+
+			if (!slot.archetype->HasComponent(type)) {
+				return nullptr;
+			}
+
+			return &ComponentInfo::GetRow(ComponentInfo::GetData<T>(slot.archetype->GetColumn(type)), slot.row);
+		}
+
+		/*! \brief Returns the \p T of entity \p id without checking it exists.
+		 *
+		 * Unlike \ref Entity::GetComponent a missing entity or component isn't reported, use
+		 * \ref TryGet unless the entity is known to have \p T.
+		 */
+		template<typename T>
+		T& Get(EntityId id) noexcept {
+			auto& slot = slots[id.index];
+			return ComponentInfo::GetRow(ComponentInfo::GetData<T>(slot.archetype->GetColumn(ComponentTypes::GetId<T>())), slot.row);
+		}
+
+		template<typename T, typename... Args>
+		T& AddComponent(EntityId id, Args&&... args) {
+			auto& slot = GetSlot(id);
+			auto type = ComponentTypes::GetId<T>();
+
+			if constexpr (IsTagComponent<T>::value) {
+				static_assert(sizeof...(Args) == 0, "Tag components have no data to construct");
+
+				// Only the mask changes, there is no component to store
+				if (!slot.archetype->HasComponent(type)) {
+					MoveEntity(slot, GetAddEdge(slot.archetype, type));
+				}
+
+				return *ComponentInfo::GetTag<T>();
+			}
+
+			auto column = slot.archetype->GetColumn(type);
+
+			if (column != nullptr) {
+				T& component = *column->template Get<T>(slot.row);
+				component = T(std::forward<Args>(args)...);
+				column->MarkChanged(slot.row, GetTick());
+				return component;
+			}
+
+			// Construct before moving rows so a throwing constructor leaves the entity untouched
+			T component(std::forward<Args>(args)...);
+			auto target = GetAddEdge(slot.archetype, type);
+			auto targetColumn = target->GetColumn(type);
+
+			MoveEntity(slot, target);
+			targetColumn->PushBack(&component, GetTick());
+
+			return *targetColumn->template Get<T>(slot.row);
+		}
+
+		template<typename T>
+		void RemoveComponent(EntityId id) {
+			RemoveComponent(id, ComponentTypes::GetId<T>());
+		}
+
+		/*! \brief Records that the entity's \p T was changed outside of a system. */
+		template<typename T>
+		void MarkChanged(EntityId id) {
+			MarkChanged(id, ComponentTypes::GetId<T>());
+		}
+
+	private:
+		friend class Entity;
+		friend class WorldSnapshot;
+
+		/*! \brief Where an entity's components live. A free slot has no archetype. */
+		struct EntitySlot {
+			Archetype* archetype;
+			uint32_t row;
+			uint32_t generation;
+		};
+
+		struct ArchetypeChunk {
+			Archetype* archetype;
+			size_t begin;
+			size_t end;
+		};
+
+		/*! \brief Marks the registry as iterating for as long as it lives. */
+		struct IterationGuard {
+			IterationGuard(std::atomic<int>& numIterating) : numIterating(numIterating) {
+				numIterating++;
+			}
+
+			~IterationGuard() {
+				numIterating--;
+			}
+
+			std::atomic<int>& numIterating;
+		};
+
+		struct RowFilter {
+			ChangeFilter filter;
+			Tick since;
+			//! The tick the system is running at
+			Tick tick;
+			RateMode rate;
+			uint64_t step;
+		};
+
+		struct ViewKey {
+			ComponentMask mask;
+			ComponentMask exclude;
+
+			bool operator==(const ViewKey& other) const {
+				return mask == other.mask && exclude == other.exclude;
+			}
+		};
+
+		struct ViewKeyHash {
+			size_t operator()(const ViewKey& key) const {
+				std::hash<ComponentMask> hash;
+				return hash(key.mask) * 31 + hash(key.exclude);
+			}
+		};
+
+		struct ScheduledSystem {
+			SystemAccess access;
+			std::function<void(void)> run;
+		};
+
+		/*! \brief An entity spawned by a command buffer, as it will be once its commands are applied. */
+		struct SpawnedEntity {
+			bool isAlive;
+			ComponentMask mask;
+			//! The component to move in for each type in the mask, null for a tag
+			std::vector<std::pair<ComponentTypeId, void*>> components;
+		};
+
+		template<typename... Ts>
+		static void ExecuteRows(JobSystem<Ts...>& system, Archetype& archetype, size_t begin, size_t end, const RowFilter& rows) {
+			std::array<ComponentColumn*, sizeof...(Ts)> columns = { archetype.GetColumn(ComponentTypes::GetId<Ts>())... };
+
+			if (rows.filter != FILTER_NONE && !ColumnsMatch(columns.data(), columns.size(), rows)) {
+				return;
+			}
+
+			const SimulationLODComponent* lods = nullptr;
+
+			if (rows.rate == RATE_LOD) {
+				auto lodColumn = archetype.GetColumn(ComponentTypes::GetId<SimulationLODComponent>());
+				lods = lodColumn != nullptr ? lodColumn->template Data<const SimulationLODComponent>() : nullptr;
+			}
+
+			ExecuteRows(system, columns, lods, archetype.GetEntities().data(), begin, end, rows, std::index_sequence_for<Ts...>());
+		}
+
+		template<typename... Ts, size_t... Is>
+		static void ExecuteRows(JobSystem<Ts...>& system, const std::array<ComponentColumn*, sizeof...(Ts)>& columns,
+				const SimulationLODComponent* lods, const EntityId* entities, size_t begin, size_t end, const RowFilter& rows,
+				std::index_sequence<Is...>) {
+			auto data = std::make_tuple(ComponentInfo::GetData<Ts>(columns[Is])...);
+			// Null for components the system only reads, and for tags
+			std::array<Tick*, sizeof...(Ts)> writtenTicks = {
+				(std::is_const<Ts>::value || columns[Is] == nullptr ? nullptr : columns[Is]->GetChangedTicks())...
+			};
+			bool executed = false;
+
+			for (size_t row = begin; row < end; row++) {
+				if (rows.filter != FILTER_NONE && !RowMatches(columns.data(), columns.size(), row, rows)) {
+					continue;
+				}
+
+				if (lods != nullptr && !lods[row].IsDue(entities[row], rows.step)) {
+					continue;
+				}
+
+				system.Execute(ComponentInfo::GetRow(std::get<Is>(data), row)...);
+				executed = true;
+
+				for (auto ticks : writtenTicks) {
+					if (ticks != nullptr) {
+						ticks[row] = rows.tick;
+					}
+				}
+			}
+
+			if (executed) {
+				for (size_t i = 0; i < columns.size(); i++) {
+					if (writtenTicks[i] != nullptr) {
+						columns[i]->MarkColumnChanged(rows.tick);
+					}
+				}
+			}
+		}
+
+		template<typename T, typename Source>
+		static void CheckSourceSize(Source& source, size_t count) {
+			if constexpr (!IsTagComponent<T>::value && !std::is_invocable<Source&, size_t>::value && !std::is_pointer<Source>::value) {
+				if (source.size() < count) {
+					throw EntityRegistryException("Cannot add " + std::to_string(count) + " entities from "
+						+ std::to_string(source.size()) + " " + ComponentTypes::GetName(ComponentTypes::GetId<T>()) + " components");
+				}
+			}
+		}
+
+		template<typename T, typename Source>
+		void FillColumn(ComponentColumn* column, size_t count, Source& source) {
+			// Tags have no column to fill
+			if constexpr (!IsTagComponent<T>::value) {
+				FillRows<T>(*column, count, source);
+			}
+		}
+
+		template<typename T, typename Source>
+		void FillRows(ComponentColumn& column, size_t count, Source& source) {
+			T* components = static_cast<T*>(column.AppendUninitialised(count, GetTick()));
+			size_t numConstructed = 0;
+
+			try {
+				if constexpr (std::is_invocable<Source&, size_t>::value) {
+					for (; numConstructed < count; numConstructed++) {
+						new (components + numConstructed) T(source(numConstructed));
+					}
+				}
+				else {
+					const T* values;
+
+					if constexpr (std::is_pointer<Source>::value) {
+						values = source;
+					}
+					else {
+						values = source.data();
+					}
+
+					if constexpr (std::is_trivially_copyable<T>::value) {
+						if (count > 0) {
+							std::memcpy(components, values, count * sizeof(T));
+						}
+					}
+					else {
+						for (; numConstructed < count; numConstructed++) {
+							new (components + numConstructed) T(values[numConstructed]);
+						}
+					}
+				}
+			}
+			catch (...) {
+				for (size_t i = 0; i < numConstructed; i++) {
+					components[i].~T();
+				}
+
+				column.DiscardUninitialised(count);
+				throw;
+			}
+		}
+
+		static bool ColumnsMatch(ComponentColumn* const* columns, size_t numColumns, const RowFilter& rows);
+		static bool RowMatches(ComponentColumn* const* columns, size_t numColumns, size_t row, const RowFilter& rows);
+
+		void* AddComponent(EntityId id, ComponentTypeId type, void* component);
+		void RemoveComponent(EntityId id, ComponentTypeId type);
+		void MarkChanged(EntityId id, ComponentTypeId type);
+		void CheckNotIterating(const std::string& action) const;
+		static void CheckRateMode(ChangeFilter filter, RateMode rate);
+
+		Archetype* GetArchetype(const ComponentMask& mask);
+		Archetype* GetAddEdge(Archetype* source, ComponentTypeId type);
+		Archetype* GetRemoveEdge(Archetype* source, ComponentTypeId type);
+		EntitySlot& GetSlot(EntityId id);
+		/*! \brief Takes \p count free slots, which don't belong to an archetype until \ref AssignEntities. */
+		std::vector<EntityId> AllocateEntities(size_t count);
+		void AssignEntities(const std::vector<EntityId>& ids, Archetype* archetype, size_t firstRow);
+		void FreeEntities(const std::vector<EntityId>& ids);
+		/*! \brief Adds \p entities, which all have the components \p mask, to its archetype together. */
+		void AddSpawnedEntities(const ComponentMask& mask, const std::vector<SpawnedEntity*>& entities);
+		void MoveEntity(EntitySlot& slot, Archetype* target);
+		void UpdateMovedEntity(Archetype* archetype, size_t row);
+
+		std::shared_ptr<EntityViewBase> GetView(const ComponentMask& mask, const ComponentMask& exclude = ComponentMask());
+		void NotifyEntityMoved(EntityId id, const Archetype* from, const Archetype* to);
+		std::vector<ArchetypeChunk> GetChunks(const EntityViewBase& view);
+		void BuildSystemBatches(void);
+		ThreadPool& GetThreadPool(void);
+
 		std::unordered_map<std::type_index, std::shared_ptr<Module>> registeredModules;
-		std::unordered_map<int, std::shared_ptr<Entity>> entities;
+		std::vector<std::function<void(EntityRegistry&)>> initialisers;
+		std::vector<EntitySlot> slots;
+		std::vector<uint32_t> freeSlots;
+
+		//! Declared before the archetypes so it outlives their columns
+		ChunkAllocator allocator;
+		std::vector<std::unique_ptr<Archetype>> archetypes;
+		std::unordered_map<ComponentMask, Archetype*> archetypeLookup;
+		std::unordered_map<ViewKey, std::shared_ptr<EntityViewBase>, ViewKeyHash> views;
+		Archetype* emptyArchetype;
+
+		TransformHierarchy transforms;
+
+		std::vector<ScheduledSystem> systems;
+		//! Indices into \ref systems, rebuilt when a system is added
+		std::vector<std::vector<size_t>> systemBatches;
+
+		//! Index 0 belongs to the thread owning the registry, worker i uses index i + 1. A deque so
+		//! growing it for a new pool doesn't move buffers callers already hold references to.
+		std::deque<EntityCommandBuffer> commandBuffers;
+		EventBus events;
+		//! One drain per event type, fanning out to that type's list in \ref eventHandlerLists
+		std::vector<std::function<void(void)>> eventHandlers;
+		std::unordered_map<std::type_index, std::shared_ptr<void>> eventHandlerLists;
+
+		std::atomic<int> numIterating;
+		std::atomic<Tick> tick;
+		//! Only changed by \ref RunSystems, between runs of the systems
+		uint64_t step;
+
+		SimulationLoop loop;
+
+		std::unique_ptr<ThreadPool> threadPool;
+		unsigned int numWorkers;
+		size_t chunkSize;
 	};
 
-}
\ No newline at end of file
+	template<typename T, typename... Args, typename std::enable_if<std::is_base_of<Component, T>::value>::type*>
+	T& Entity::AddComponent(Args&&... args) {
+		return registry->AddComponent<T>(id, std::forward<Args>(args)...);
+	}
+
+	template<typename T, typename std::enable_if<std::is_base_of<Component, T>::value>::type*>
+	void Entity::RemoveComponent(void) {
+		registry->RemoveComponent<T>(id);
+	}
+
+	template<typename T, typename std::enable_if<std::is_base_of<Component, T>::value>::type*>
+	T* Entity::TryGet(void) noexcept {
+		return registry->TryGet<T>(id);
+	}
+
+	template<typename T, typename std::enable_if<std::is_base_of<Component, T>::value>::type*>
+	T& Entity::Get(void) noexcept {
+		return registry->Get<T>(id);
+	}
+
+}
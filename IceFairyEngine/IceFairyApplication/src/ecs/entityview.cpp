@@ -0,0 +1,77 @@
+#include "entityview.h"
+
+IceFairy::EntityViewBase::EntityViewBase(const ComponentMask& mask, const ComponentMask& exclude) :
+	mask(mask),
+	exclude(exclude) {
+}
+
+bool IceFairy::EntityViewBase::Matches(const ComponentMask& archetypeMask) const {
+	return (archetypeMask & mask) == mask && (archetypeMask & exclude).none();
+}
+
+void IceFairy::EntityViewBase::OnArchetypeCreated(Archetype* archetype) {
+	if (Matches(archetype->GetMask())) {
+		archetypes.push_back(archetype);
+	}
+}
+
+void IceFairy::EntityViewBase::OnEntityMoved(EntityId id, const Archetype* from, const Archetype* to) {
+	bool wasInView = from != nullptr && Matches(from->GetMask());
+	bool isInView = to != nullptr && Matches(to->GetMask());
+
+	if (wasInView && !isInView) {
+		RemoveEntity(id);
+	}
+	else if (!wasInView && isInView) {
+		AddEntity(id);
+	}
+}
+
+void IceFairy::EntityViewBase::AddRemovalLog(const std::shared_ptr<std::vector<EntityId>>& log) {
+	removalLogs.push_back(log);
+}
+
+const IceFairy::ComponentMask& IceFairy::EntityViewBase::GetMask(void) const {
+	return mask;
+}
+
+const IceFairy::ComponentMask& IceFairy::EntityViewBase::GetExcludeMask(void) const {
+	return exclude;
+}
+
+const std::vector<IceFairy::Archetype*>& IceFairy::EntityViewBase::GetArchetypes(void) const {
+	return archetypes;
+}
+
+const std::vector<IceFairy::EntityId>& IceFairy::EntityViewBase::GetEntities(void) const {
+	return entities;
+}
+
+void IceFairy::EntityViewBase::AddEntity(EntityId id) {
+	if (id.index >= positions.size()) {
+		positions.resize(id.index + 1, NOT_IN_VIEW);
+	}
+
+	positions[id.index] = (uint32_t) entities.size();
+	entities.push_back(id);
+}
+
+void IceFairy::EntityViewBase::RemoveEntity(EntityId id) {
+	uint32_t position = positions[id.index];
+
+	entities[position] = entities.back();
+	positions[entities[position].index] = position;
+	positions[id.index] = NOT_IN_VIEW;
+	entities.pop_back();
+
+	for (size_t i = 0; i < removalLogs.size();) {
+		if (auto log = removalLogs[i].lock()) {
+			log->push_back(id);
+			i++;
+		}
+		else {
+			removalLogs[i] = removalLogs.back();
+			removalLogs.pop_back();
+		}
+	}
+}
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <array>
+#include <tuple>
+
+#include "archetype.h"
+#include "componenttypes.h"
+#include "entityid.h"
+
+namespace IceFairy {
+
+	/*! \brief Excludes entities with any of the components \p Ts from a view or system.
+	 *
+	 * Sample usage:
+	 * \code{.cpp}
+	 * auto living = registry.View<Position>(Without<Dead, Hidden>());
+	 * \endcode
+	 */
+	template<typename... Ts>
+	struct Without {
+		static ComponentMask GetMask(void) {
+			return ComponentTypes::GetMask<Ts...>();
+		}
+	};
+
+	/*! \brief Cached set of the archetypes and entities matching a component mask.
+	 *
+	 * Views are owned by the \ref EntityRegistry, which updates them as archetypes are created and
+	 * entities gain or lose components, so reading a view never rescans the registry.
+	 */
+	class EntityViewBase {
+	public:
+		/*! \param mask The components a matching entity has all of.
+		 * \param exclude The components a matching entity has none of.
+		 */
+		EntityViewBase(const ComponentMask& mask, const ComponentMask& exclude = ComponentMask());
+
+		bool Matches(const ComponentMask& archetypeMask) const;
+
+		/*! \brief Adds \p archetype if it matches this view. */
+		void OnArchetypeCreated(Archetype* archetype);
+		/*! \brief Adds or removes \p id after it moved from \p from to \p to. Either may be null. */
+		void OnEntityMoved(EntityId id, const Archetype* from, const Archetype* to);
+		/*! \brief Appends every entity which leaves the view from now on to \p log, until \p log is destroyed.
+		 *
+		 * Lets something mirroring the view, such as a \ref SpatialIndex, drop the entities which
+		 * left without checking every entity it holds.
+		 */
+		void AddRemovalLog(const std::shared_ptr<std::vector<EntityId>>& log);
+
+		const ComponentMask& GetMask(void) const;
+		const ComponentMask& GetExcludeMask(void) const;
+		const std::vector<Archetype*>& GetArchetypes(void) const;
+		const std::vector<EntityId>& GetEntities(void) const;
+
+	private:
+		void AddEntity(EntityId id);
+		void RemoveEntity(EntityId id);
+
+		static constexpr uint32_t NOT_IN_VIEW = UINT32_MAX;
+
+		ComponentMask mask;
+		ComponentMask exclude;
+		std::vector<Archetype*> archetypes;
+		std::vector<EntityId> entities;
+		//! Position of each entity in \ref entities, indexed by slot index
+		std::vector<uint32_t> positions;
+		//! Dropped once their owner destroys them, so nothing has to unregister
+		std::vector<std::weak_ptr<std::vector<EntityId>>> removalLogs;
+	};
+
+	/*! \brief Typed handle to a cached view, returned by \ref EntityRegistry::View.
+	 *
+	 * Sample usage:
+	 * \code{.cpp}
+	 * auto movers = registry.View<Position, Velocity>();
+	 *
+	 * movers.Each([](Position& position, Velocity& velocity) {
+	 *     position.x += velocity.x;
+	 * });
+	 * \endcode
+	 */
+	template<typename... Ts>
+	class EntityView {
+	public:
+		EntityView(std::shared_ptr<EntityViewBase> view) :
+			view(view) {
+		}
+
+		/*! \brief Calls \p function with the components of every matching entity, archetype by archetype. */
+		template<typename F>
+		void Each(F&& function) {
+			for (auto archetype : view->GetArchetypes()) {
+				EachRow(function, archetype->GetSize(), ComponentInfo::GetData<Ts>(archetype->GetColumn(ComponentTypes::GetId<Ts>()))...);
+			}
+		}
+
+		/*! \brief Calls \p function for every matching entity with a component added after \p since.
+		 *
+		 * Tags have no ticks, so only the components with data are checked.
+		 */
+		template<typename F>
+		void EachAddedSince(Tick since, F&& function) {
+			EachNewerThan(function, since, true);
+		}
+
+		/*! \brief Calls \p function for every matching entity with a component added or changed after \p since. */
+		template<typename F>
+		void EachChangedSince(Tick since, F&& function) {
+			EachNewerThan(function, since, false);
+		}
+
+		/*! \returns Every matching entity in one contiguous array. The order is unspecified. */
+		const std::vector<EntityId>& GetEntities(void) const {
+			return view->GetEntities();
+		}
+
+		const std::vector<Archetype*>& GetArchetypes(void) const {
+			return view->GetArchetypes();
+		}
+
+		size_t GetSize(void) const {
+			return view->GetEntities().size();
+		}
+
+		/*! \brief See \ref EntityViewBase::AddRemovalLog. */
+		void AddRemovalLog(const std::shared_ptr<std::vector<EntityId>>& log) {
+			view->AddRemovalLog(log);
+		}
+
+	private:
+		template<typename F>
+		static void EachRow(F& function, size_t size, Ts*... columns) {
+			for (size_t row = 0; row < size; row++) {
+				function(ComponentInfo::GetRow(columns, row)...);
+			}
+		}
+
+		template<typename F>
+		void EachNewerThan(F& function, Tick since, bool added) {
+			for (auto archetype : view->GetArchetypes()) {
+				std::array<ComponentColumn*, sizeof...(Ts)> columns = { archetype->GetColumn(ComponentTypes::GetId<Ts>())... };
+				std::array<const Tick*, sizeof...(Ts)> ticks;
+				bool anyNewer = false;
+
+				for (size_t i = 0; i < columns.size(); i++) {
+					if (columns[i] == nullptr) {
+						ticks[i] = nullptr;
+						continue;
+					}
+
+					ticks[i] = added ? columns[i]->GetAddedTicks() : columns[i]->GetChangedTicks();
+					anyNewer |= IsNewerTick(added ? columns[i]->GetLastAddedTick() : columns[i]->GetLastChangedTick(), since);
+				}
+
+				if (!anyNewer) {
+					continue;
+				}
+
+				auto data = std::make_tuple(ComponentInfo::GetData<Ts>(archetype->GetColumn(ComponentTypes::GetId<Ts>()))...);
+
+				for (size_t row = 0; row < archetype->GetSize(); row++) {
+					for (auto rowTicks : ticks) {
+						if (rowTicks != nullptr && IsNewerTick(rowTicks[row], since)) {
+							std::apply([&](auto*... components) { function(ComponentInfo::GetRow(components, row)...); }, data);
+							break;
+						}
+					}
+				}
+			}
+		}
+
+		std::shared_ptr<EntityViewBase> view;
+	};
+
+}
@@ -0,0 +1,25 @@
+#include "eventbus.h"
+
+IceFairy::EventBus::EventBus(size_t capacity) :
+	capacity(capacity) {
+	for (auto& queue : queues) {
+		queue.store(nullptr);
+	}
+}
+
+IceFairy::EventBus::~EventBus() {
+	for (auto& queue : queues) {
+		delete queue.load();
+	}
+}
+
+size_t IceFairy::EventBus::RegisterType(void) {
+	static std::atomic<size_t> nextId(0);
+	size_t id = nextId++;
+
+	if (id >= ICE_FAIRY_MAX_EVENT_TYPES) {
+		throw EventTypeLimitException(id);
+	}
+
+	return id;
+}
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <utility>
+#include <type_traits>
+#include <string>
+
+#include "core/utilities/mpscqueue.h"
+#include "core/utilities/icexception.h"
+
+#ifndef ICE_FAIRY_MAX_EVENT_TYPES
+#define ICE_FAIRY_MAX_EVENT_TYPES 64
+#endif
+
+namespace IceFairy {
+
+	class EventTypeLimitException : public ICException {
+	public:
+		EventTypeLimitException(size_t id)
+			: ICException("Cannot register event type " + std::to_string(id) + ", raise ICE_FAIRY_MAX_EVENT_TYPES above "
+				+ std::to_string(ICE_FAIRY_MAX_EVENT_TYPES)) {
+		}
+	};
+
+	/*! \brief Typed channel for systems to tell each other things happened.
+	 *
+	 * Every event type gets its own lock-free \ref MPSCQueue, so systems running on worker
+	 * threads can \ref Emit collisions, spawn requests or damage without taking a lock. Events
+	 * are then handled in batches with \ref Drain, at a point in the frame where nothing else is
+	 * emitting them, such as after \ref EntityRegistry::RunSystems.\n
+	 * Any thread may emit, but only one thread at a time may drain a given event type.
+	 * Events emitted by one thread are drained in the order they were emitted, unless the
+	 * queue overflowed in between.
+	 *
+	 * Sample usage:
+	 * \code{.cpp}
+	 * // In a system, on any thread
+	 * events.Emit(Damage { target, 10 });
+	 *
+	 * // Once per frame
+	 * events.Drain<Damage>([&](const Damage& damage) { ... });
+	 * \endcode
+	 */
+	class EventBus {
+	public:
+		/*! \param capacity The number of events of each type which can be queued before emitting
+		 * falls back to a locked overflow list.
+		 */
+		EventBus(size_t capacity = 4096);
+		~EventBus();
+
+		EventBus(const EventBus&) = delete;
+		EventBus& operator=(const EventBus&) = delete;
+
+		/*! \brief Queues \p event. Safe to call from any thread. */
+		template<typename E>
+		void Emit(E&& event) {
+			GetQueue<typename std::decay<E>::type>().Emit(std::forward<E>(event));
+		}
+
+		/*! \brief Calls \p handler with every queued event of type \p E, oldest first.
+		 *
+		 * Events emitted while \p handler runs are left for the next call.
+		 *
+		 * \returns The number of events handled.
+		 */
+		template<typename E, typename F>
+		size_t Drain(F&& handler) {
+			auto queue = queues[GetTypeId<E>()].load(std::memory_order_acquire);
+
+			return queue == nullptr ? 0 : static_cast<EventQueue<E>*>(queue)->Drain(handler);
+		}
+
+		/*! \returns The number of events of type \p E which didn't fit in the queue, since it was created. */
+		template<typename E>
+		size_t GetOverflowCount(void) {
+			auto queue = queues[GetTypeId<E>()].load(std::memory_order_acquire);
+
+			return queue == nullptr ? 0 : static_cast<EventQueue<E>*>(queue)->GetOverflowCount();
+		}
+
+	private:
+		class EventQueueBase {
+		public:
+			virtual ~EventQueueBase() {
+			}
+		};
+
+		template<typename E>
+		class EventQueue : public EventQueueBase {
+		public:
+			EventQueue(size_t capacity) :
+				ring(capacity),
+				hasOverflow(false),
+				numOverflowed(0) {
+			}
+
+			template<typename U>
+			void Emit(U&& event) {
+				if (ring.TryPush(std::forward<U>(event))) {
+					return;
+				}
+
+				// Slow path so events are never dropped when consumers fall behind
+				std::lock_guard<std::mutex> lock(overflowMutex);
+				overflow.emplace_back(std::forward<U>(event));
+				numOverflowed++;
+				hasOverflow.store(true, std::memory_order_release);
+			}
+
+			template<typename F>
+			size_t Drain(F& handler) {
+				size_t numDrained = ring.ConsumeAll(handler);
+
+				if (hasOverflow.load(std::memory_order_acquire)) {
+					std::vector<E> overflowed;
+					{
+						std::lock_guard<std::mutex> lock(overflowMutex);
+						overflowed.swap(overflow);
+						hasOverflow.store(false, std::memory_order_relaxed);
+					}
+
+					for (auto& event : overflowed) {
+						handler(event);
+					}
+					numDrained += overflowed.size();
+				}
+
+				return numDrained;
+			}
+
+			size_t GetOverflowCount(void) {
+				std::lock_guard<std::mutex> lock(overflowMutex);
+				return numOverflowed;
+			}
+
+		private:
+			MPSCQueue<E> ring;
+
+			std::mutex overflowMutex;
+			std::vector<E> overflow;
+			std::atomic<bool> hasOverflow;
+			size_t numOverflowed;
+		};
+
+		/*! \brief Returns the queue for \p E, creating it without locking if it doesn't exist yet. */
+		template<typename E>
+		EventQueue<E>& GetQueue(void) {
+			auto& slot = queues[GetTypeId<E>()];
+			auto queue = slot.load(std::memory_order_acquire);
+
+			if (queue == nullptr) {
+				auto created = new EventQueue<E>(capacity);
+
+				// Another thread may have created it first, in which case use theirs
+				if (slot.compare_exchange_strong(queue, created, std::memory_order_acq_rel)) {
+					queue = created;
+				}
+				else {
+					delete created;
+				}
+			}
+
+			return *static_cast<EventQueue<E>*>(queue);
+		}
+
+		template<typename E>
+		static size_t GetTypeId(void) {
+			static const size_t id = RegisterType();
+			return id;
+		}
+
+		static size_t RegisterType(void);
+
+		size_t capacity;
+		std::array<std::atomic<EventQueueBase*>, ICE_FAIRY_MAX_EVENT_TYPES> queues;
+	};
+
+}
@@ -8,7 +8,7 @@ namespace IceFairy {
 		template<class... Ms>
 		JobSystem(Ms&&... metadata) { }
 
-		virtual void Execute(std::shared_ptr<Ts>&... components) { }
+		virtual void Execute(Ts&... components) { }
 	};
 
 }
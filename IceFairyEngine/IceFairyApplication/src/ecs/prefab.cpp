@@ -0,0 +1,124 @@
+#include "prefab.h"
+
+#include <algorithm>
+#include <new>
+
+IceFairy::Prefab::Prefab(void) {
+}
+
+IceFairy::Prefab::~Prefab() {
+	Clear();
+}
+
+IceFairy::Prefab::Prefab(Prefab&& other) noexcept :
+	mask(other.mask),
+	components(std::move(other.components)) {
+	other.mask.reset();
+	other.components.clear();
+}
+
+IceFairy::Prefab& IceFairy::Prefab::operator=(Prefab&& other) noexcept {
+	if (this != &other) {
+		Clear();
+
+		mask = other.mask;
+		components = std::move(other.components);
+		other.mask.reset();
+		other.components.clear();
+	}
+
+	return *this;
+}
+
+void IceFairy::Prefab::SetCopy(ComponentTypeId type, const void* component) {
+	void* data = Allocate(type);
+
+	try {
+		ComponentTypes::GetInfo(type).copyConstruct(data, component);
+	}
+	catch (...) {
+		Deallocate(type, data);
+		throw;
+	}
+
+	Insert(type, data);
+}
+
+void IceFairy::Prefab::Remove(ComponentTypeId type) {
+	auto it = std::find_if(components.begin(), components.end(), [type](const StoredComponent& component) {
+		return component.type == type;
+	});
+
+	if (it == components.end()) {
+		return;
+	}
+
+	ComponentTypes::GetInfo(type).destroy(it->data);
+	Deallocate(type, it->data);
+	components.erase(it);
+	mask.reset(type);
+}
+
+const void* IceFairy::Prefab::Get(ComponentTypeId type) const {
+	for (auto& component : components) {
+		if (component.type == type) {
+			return component.data;
+		}
+	}
+
+	return nullptr;
+}
+
+const IceFairy::ComponentMask& IceFairy::Prefab::GetMask(void) const {
+	return mask;
+}
+
+void IceFairy::Prefab::Emplace(ComponentTypeId type, void* component) {
+	void* data = Allocate(type);
+
+	try {
+		ComponentTypes::GetInfo(type).moveConstruct(data, component);
+	}
+	catch (...) {
+		Deallocate(type, data);
+		throw;
+	}
+
+	Insert(type, data);
+}
+
+void* IceFairy::Prefab::Allocate(ComponentTypeId type) {
+	auto& info = ComponentTypes::GetInfo(type);
+
+	// Every instance is a copy, so a type which can't be copied could never be instantiated
+	if (info.copyConstruct == nullptr) {
+		throw PrefabException("Cannot store component of type '" + info.name + "', it isn't copy constructible");
+	}
+
+	return ::operator new(info.size, std::align_val_t(info.alignment));
+}
+
+void IceFairy::Prefab::Deallocate(ComponentTypeId type, void* data) {
+	::operator delete(data, std::align_val_t(ComponentTypes::GetInfo(type).alignment));
+}
+
+void IceFairy::Prefab::Insert(ComponentTypeId type, void* data) {
+	Remove(type);
+
+	auto it = std::lower_bound(components.begin(), components.end(), type, [](const StoredComponent& component, ComponentTypeId type) {
+		return component.type < type;
+	});
+
+	components.insert(it, { type, data });
+	mask.set(type);
+}
+
+void IceFairy::Prefab::Clear(void) {
+	for (auto& component : components) {
+		ComponentTypes::GetInfo(component.type).destroy(component.data);
+		Deallocate(component.type, component.data);
+	}
+
+	components.clear();
+	mask.reset();
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <utility>
+
+#include "componenttypes.h"
+#include "core/utilities/icexception.h"
+
+namespace IceFairy {
+
+	class PrefabException : public ICException {
+	public:
+		PrefabException(const std::string& message)
+			: ICException("Prefab encountered an error: " + message) {
+		}
+	};
+
+	/*! \brief A set of components and their values to stamp out new entities from.
+	 *
+	 * Build one with \ref Set, or copy an existing entity's components with
+	 * \ref EntityRegistry::CreatePrefab, then create entities from it with
+	 * \ref EntityRegistry::Instantiate. Every instance goes straight into the archetype for the
+	 * prefab's components, and trivially copyable components are copied into place in bulk.\n
+	 * Components are copied once per instance, so data shared by many instances such as
+	 * meshes should be held by a handle, for example a \c std::shared_ptr to \c const data.
+	 *
+	 * Sample usage:
+	 * \code{.cpp}
+	 * Prefab bullet;
+	 * bullet.Set<Position>(0.0f, 0.0f).Set<Velocity>(0.0f, 10.0f);
+	 *
+	 * auto bullets = registry.Instantiate(bullet, 1000);
+	 * \endcode
+	 */
+	class Prefab {
+	public:
+		Prefab(void);
+		~Prefab();
+
+		Prefab(Prefab&& other) noexcept;
+		Prefab& operator=(Prefab&& other) noexcept;
+		Prefab(const Prefab&) = delete;
+		Prefab& operator=(const Prefab&) = delete;
+
+		/*! \brief Sets the value of \p T given to every instance, replacing any previous value.
+		 *
+		 * \throws PrefabException if \p T can't be copied.
+		 */
+		template<typename T, typename... Args>
+		Prefab& Set(Args&&... args) {
+			T component(std::forward<Args>(args)...);
+			Emplace(ComponentTypes::GetId<T>(), &component);
+			return *this;
+		}
+
+		template<typename T>
+		void Remove(void) {
+			Remove(ComponentTypes::GetId<T>());
+		}
+
+		template<typename T>
+		bool Has(void) const {
+			return mask.test(ComponentTypes::GetId<T>());
+		}
+
+		/*! \throws PrefabException if the prefab has no \p T. */
+		template<typename T>
+		const T& Get(void) const {
+			auto component = Get(ComponentTypes::GetId<T>());
+
+			if (component == nullptr) {
+				throw PrefabException("Prefab has no component of type '" + ComponentTypes::GetName(ComponentTypes::GetId<T>()) + "'");
+			}
+
+			return *static_cast<const T*>(component);
+		}
+
+		/*! \brief Sets the value of \p type to a copy of \p component.
+		 *
+		 * \throws PrefabException if \p type can't be copied.
+		 */
+		void SetCopy(ComponentTypeId type, const void* component);
+		void Remove(ComponentTypeId type);
+		/*! \returns The value of \p type, or null if the prefab doesn't have one. */
+		const void* Get(ComponentTypeId type) const;
+
+		const ComponentMask& GetMask(void) const;
+
+	private:
+		friend class EntityRegistry;
+
+		struct StoredComponent {
+			ComponentTypeId type;
+			void* data;
+		};
+
+		/*! \brief Moves \p component into the prefab. */
+		void Emplace(ComponentTypeId type, void* component);
+		/*! \brief Allocates storage for a \p type, checking it can be copied into instances. */
+		static void* Allocate(ComponentTypeId type);
+		static void Deallocate(ComponentTypeId type, void* data);
+		/*! \brief Takes ownership of the component of \p type constructed at \p data. */
+		void Insert(ComponentTypeId type, void* data);
+		void Clear(void);
+
+		ComponentMask mask;
+		//! Sorted by type
+		std::vector<StoredComponent> components;
+	};
+
+}
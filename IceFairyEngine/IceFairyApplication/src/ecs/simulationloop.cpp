@@ -0,0 +1,146 @@
+#include "simulationloop.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <thread>
+
+#include "entityregistry.h"
+
+IceFairy::SimulationLoop::SimulationLoop(EntityRegistry& registry) :
+	registry(registry),
+	clock([]() {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+	}),
+	fixedStep(1.0 / 60.0),
+	frameBudget(1.0 / 60.0),
+	maxStepsPerFrame(8),
+	accumulator(0.0),
+	lastFrameTime(-1.0),
+	stepCount(0),
+	stepsLastFrame(0),
+	slicesLastFrame(0),
+	nextSlicedTask(0) {
+}
+
+void IceFairy::SimulationLoop::Frame(void) {
+	double now = clock();
+	double elapsed = lastFrameTime < 0.0 ? 0.0 : now - lastFrameTime;
+
+	lastFrameTime = now;
+	Frame(elapsed);
+}
+
+void IceFairy::SimulationLoop::Frame(double elapsedSeconds) {
+	double frameStart = clock();
+
+	// Also catches NaN, which would otherwise poison the accumulator for good
+	accumulator += elapsedSeconds > 0.0 ? elapsedSeconds : 0.0;
+	stepsLastFrame = 0;
+
+	while (accumulator >= fixedStep && stepsLastFrame < maxStepsPerFrame) {
+		registry.RunSystems();
+
+		accumulator -= fixedStep;
+		stepCount++;
+		stepsLastFrame++;
+	}
+
+	// Drop the backlog we couldn't catch up on rather than carrying it into every later frame
+	if (accumulator >= fixedStep) {
+		accumulator = std::fmod(accumulator, fixedStep);
+	}
+
+	RunSlicedTasks(frameStart + frameBudget);
+}
+
+void IceFairy::SimulationLoop::Run(const std::function<bool(void)>& isRunning) {
+	while (isRunning()) {
+		Frame();
+
+		// Sliced work soaks up any spare time, so only sleep when there is none
+		if (GetSlicedTaskCount() == 0) {
+			std::this_thread::sleep_for(std::chrono::duration<double>(fixedStep - accumulator));
+		}
+	}
+}
+
+void IceFairy::SimulationLoop::AddSlicedTask(SlicedTask task) {
+	addedSlicedTasks.push_back(std::move(task));
+}
+
+size_t IceFairy::SimulationLoop::GetSlicedTaskCount(void) const {
+	return slicedTasks.size() + addedSlicedTasks.size();
+}
+
+double IceFairy::SimulationLoop::GetAlpha(void) const {
+	return accumulator / fixedStep;
+}
+
+uint64_t IceFairy::SimulationLoop::GetStepCount(void) const {
+	return stepCount;
+}
+
+unsigned int IceFairy::SimulationLoop::GetStepsLastFrame(void) const {
+	return stepsLastFrame;
+}
+
+unsigned int IceFairy::SimulationLoop::GetSlicesLastFrame(void) const {
+	return slicesLastFrame;
+}
+
+void IceFairy::SimulationLoop::SetFixedStep(double seconds) {
+	// Also catches NaN, which std::max would let through
+	fixedStep = seconds > MIN_FIXED_STEP ? seconds : MIN_FIXED_STEP;
+}
+
+double IceFairy::SimulationLoop::GetFixedStep(void) const {
+	return fixedStep;
+}
+
+void IceFairy::SimulationLoop::SetFrameBudget(double seconds) {
+	frameBudget = seconds;
+}
+
+double IceFairy::SimulationLoop::GetFrameBudget(void) const {
+	return frameBudget;
+}
+
+void IceFairy::SimulationLoop::SetMaxStepsPerFrame(unsigned int maxSteps) {
+	maxStepsPerFrame = std::max(maxSteps, 1u);
+}
+
+void IceFairy::SimulationLoop::SetClock(Clock clock) {
+	this->clock = std::move(clock);
+	lastFrameTime = -1.0;
+}
+
+void IceFairy::SimulationLoop::RunSlicedTasks(double deadline) {
+	slicesLastFrame = 0;
+
+	while (!slicedTasks.empty() || !addedSlicedTasks.empty()) {
+		// Moved in here rather than added directly, as a task may add another while it runs
+		for (auto& task : addedSlicedTasks) {
+			slicedTasks.push_back(std::move(task));
+		}
+		addedSlicedTasks.clear();
+
+		if (slicesLastFrame > 0 && clock() >= deadline) {
+			break;
+		}
+
+		if (nextSlicedTask >= slicedTasks.size()) {
+			nextSlicedTask = 0;
+		}
+
+		bool hasMoreWork = slicedTasks[nextSlicedTask]();
+		slicesLastFrame++;
+
+		if (hasMoreWork) {
+			nextSlicedTask++;
+		}
+		else {
+			slicedTasks.erase(slicedTasks.begin() + nextSlicedTask);
+		}
+	}
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+#include <cstdint>
+
+namespace IceFairy {
+
+	class EntityRegistry;
+
+	/*! \brief Steps an \ref EntityRegistry at a fixed rate, whatever the frame rate.
+	 *
+	 * Every \ref Frame adds the real time elapsed to an accumulator and runs the registry's
+	 * systems once per whole fixed step in it, so the simulation advances by the same amount
+	 * each step. What is left over becomes \ref GetAlpha, the fraction of a step rendering
+	 * should interpolate between the previous and current state by.\n
+	 * Whatever remains of the frame's CPU budget once the steps are done goes to time-sliced
+	 * tasks. Long running work such as AI or pathfinding is split into small units which are
+	 * run until the budget is spent, then picked up again next frame, rather than spiking
+	 * the frame time.
+	 *
+	 * Sample usage:
+	 * \code{.cpp}
+	 * auto& loop = registry.GetLoop();
+	 * loop.AddSlicedTask([&]() { return pathfinder.Expand(64); });
+	 *
+	 * while (running) {
+	 *     loop.Frame();
+	 *     Render(loop.GetAlpha());
+	 * }
+	 * \endcode
+	 */
+	class SimulationLoop {
+	public:
+		//! The shortest step \ref SetFixedStep allows, as a step of 0 would never advance the simulation
+		static constexpr double MIN_FIXED_STEP = 1e-6;
+
+		/*! \brief Returns the current time in seconds. */
+		typedef std::function<double(void)> Clock;
+		/*! \brief Runs one small unit of work and returns whether there is more to do. */
+		typedef std::function<bool(void)> SlicedTask;
+
+		SimulationLoop(EntityRegistry& registry);
+
+		/*! \brief Runs a frame with the real time elapsed since the previous frame. */
+		void Frame(void);
+		/*! \brief Runs a frame, \p elapsedSeconds after the previous one.
+		 *
+		 * Runs as many fixed steps as have built up, at most \ref SetMaxStepsPerFrame, then
+		 * sliced tasks until the frame has used its budget. At least one unit of sliced work
+		 * runs every frame, so tasks still finish when the steps use the whole budget.
+		 */
+		void Frame(double elapsedSeconds);
+		/*! \brief Runs frames until \p isRunning returns false, sleeping while no step is due. */
+		void Run(const std::function<bool(void)>& isRunning);
+
+		/*! \brief Adds \p task to be run in slices, in turn with the other tasks, until it returns false. */
+		void AddSlicedTask(SlicedTask task);
+		size_t GetSlicedTaskCount(void) const;
+
+		/*! \returns How far between the last step and the next the current time is, from 0 to 1. */
+		double GetAlpha(void) const;
+		/*! \returns The number of fixed steps run since the loop was created. */
+		uint64_t GetStepCount(void) const;
+		/*! \returns The number of fixed steps the last frame ran. */
+		unsigned int GetStepsLastFrame(void) const;
+		/*! \returns The number of sliced task units the last frame ran. */
+		unsigned int GetSlicesLastFrame(void) const;
+
+		/*! \brief Sets the simulated time each step covers, at least \ref MIN_FIXED_STEP. */
+		void SetFixedStep(double seconds);
+		double GetFixedStep(void) const;
+		/*! \brief Sets the CPU time a frame may spend on steps and sliced tasks together. */
+		void SetFrameBudget(double seconds);
+		double GetFrameBudget(void) const;
+		/*! \brief Sets the most steps one frame may run.
+		 *
+		 * After a long stall any time beyond this is dropped, so the simulation slows down for
+		 * a moment rather than every later frame falling further behind.
+		 */
+		void SetMaxStepsPerFrame(unsigned int maxSteps);
+		/*! \brief Replaces the clock used to time frames and budgets, mainly for tests. */
+		void SetClock(Clock clock);
+
+	private:
+		void RunSlicedTasks(double deadline);
+
+		EntityRegistry& registry;
+		Clock clock;
+
+		double fixedStep;
+		double frameBudget;
+		unsigned int maxStepsPerFrame;
+
+		double accumulator;
+		//! Negative until the first frame
+		double lastFrameTime;
+		uint64_t stepCount;
+		unsigned int stepsLastFrame;
+		unsigned int slicesLastFrame;
+
+		std::vector<SlicedTask> slicedTasks;
+		//! Tasks added since the sliced tasks last ran
+		std::vector<SlicedTask> addedSlicedTasks;
+		//! The task to resume from, so every task gets a turn even when the budget is tight
+		size_t nextSlicedTask;
+	};
+
+}
@@ -0,0 +1,288 @@
+#include "spatialindex.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "entityregistry.h"
+
+IceFairy::SpatialIndex::SpatialIndex(float cellSize, float margin) :
+	cellSize(cellSize),
+	inverseCellSize(1.0f / cellSize),
+	maxHalfExtent(0.0f),
+	tree(margin),
+	lastUpdate(0),
+	trackedRegistry(nullptr) {
+}
+
+void IceFairy::SpatialIndex::Update(EntityRegistry& registry) {
+	auto view = registry.View<const PositionComponent, const BoundsComponent>();
+
+	// The proxies of another registry's entities mean nothing in this one
+	if (trackedRegistry != &registry) {
+		Clear();
+		trackedRegistry = &registry;
+		removals = std::make_shared<std::vector<EntityId>>();
+		view.AddRemovalLog(removals);
+	}
+
+	// Changes made from here on are newer than now, so the next update picks them up
+	Tick now = registry.AdvanceTick();
+
+	for (auto id : *removals) {
+		// Entities which left and came back are added again below, as their components are new
+		if (Contains(id)) {
+			RemoveProxy(proxyOfSlot[id.index]);
+		}
+	}
+	removals->clear();
+	auto positionType = ComponentTypes::GetId<PositionComponent>();
+	auto boundsType = ComponentTypes::GetId<BoundsComponent>();
+
+	for (auto archetype : view.GetArchetypes()) {
+		auto positions = archetype->GetColumn(positionType);
+		auto bounds = archetype->GetColumn(boundsType);
+
+		if (!IsNewerTick(positions->GetLastChangedTick(), lastUpdate) && !IsNewerTick(bounds->GetLastChangedTick(), lastUpdate)) {
+			continue;
+		}
+
+		auto& entities = archetype->GetEntities();
+
+		for (size_t row = 0; row < archetype->GetSize(); row++) {
+			if (IsNewerTick(positions->GetChangedTick(row), lastUpdate) || IsNewerTick(bounds->GetChangedTick(row), lastUpdate)) {
+				UpdateEntity(entities[row], positions->Get<PositionComponent>(row)->position, bounds->Get<BoundsComponent>(row)->halfExtents);
+			}
+		}
+	}
+
+	lastUpdate = now;
+}
+
+void IceFairy::SpatialIndex::Clear(void) {
+	tree.Clear();
+	cells.clear();
+	proxies.clear();
+	freeProxies.clear();
+	proxyOfSlot.clear();
+	maxHalfExtent = 0.0f;
+	lastUpdate = 0;
+	trackedRegistry = nullptr;
+	removals.reset();
+}
+
+void IceFairy::SpatialIndex::QueryRadius(const Vector3f& centre, float radius, std::vector<EntityId>& results) const {
+	float radiusSQ = radius * radius;
+	auto test = [&](uint32_t proxy) {
+		if (proxies[proxy].bounds.DistanceSQ(centre) <= radiusSQ) {
+			results.push_back(proxies[proxy].entity);
+		}
+	};
+
+	// Entities are filed under the cell of their centre, so look as far as the biggest can reach
+	double reach = (double) radius + maxHalfExtent;
+
+	// Worked out in double first, as a huge or infinite reach has cells beyond the range of int32_t
+	double lowX = std::floor((centre.x - reach) * inverseCellSize);
+	double lowY = std::floor((centre.y - reach) * inverseCellSize);
+	double lowZ = std::floor((centre.z - reach) * inverseCellSize);
+	double highX = std::floor((centre.x + reach) * inverseCellSize);
+	double highY = std::floor((centre.y + reach) * inverseCellSize);
+	double highZ = std::floor((centre.z + reach) * inverseCellSize);
+	double numCells = (highX - lowX + 1) * (highY - lowY + 1) * (highZ - lowZ + 1);
+
+	// Large queries would mostly probe empty cells, the tree is quicker for them. Written so an
+	// infinite reach, whose cell count is NaN, goes to the tree too.
+	if (!(numCells <= (double) cells.size())
+		|| std::min({ lowX, lowY, lowZ }) < INT32_MIN || std::max({ highX, highY, highZ }) > INT32_MAX) {
+		tree.QuerySphere(centre, radius, test);
+		return;
+	}
+
+	int32_t minX = (int32_t) lowX;
+	int32_t minY = (int32_t) lowY;
+	int32_t minZ = (int32_t) lowZ;
+	int32_t maxX = (int32_t) highX;
+	int32_t maxY = (int32_t) highY;
+	int32_t maxZ = (int32_t) highZ;
+
+	for (int32_t x = minX; x <= maxX; x++) {
+		for (int32_t y = minY; y <= maxY; y++) {
+			for (int32_t z = minZ; z <= maxZ; z++) {
+				auto it = cells.find(GetCell(x, y, z));
+
+				if (it != cells.end()) {
+					for (auto proxy : it->second) {
+						test(proxy);
+					}
+				}
+			}
+		}
+	}
+}
+
+void IceFairy::SpatialIndex::QueryAABB(const AABB& bounds, std::vector<EntityId>& results) const {
+	tree.Query(bounds, [&](uint32_t proxy) {
+		if (proxies[proxy].bounds.Overlaps(bounds)) {
+			results.push_back(proxies[proxy].entity);
+		}
+	});
+}
+
+bool IceFairy::SpatialIndex::Raycast(const Ray3f& ray, float maxDistance, RayHit& hit) const {
+	Vector3f inverseDirection(1.0f / ray.direction.x, 1.0f / ray.direction.y, 1.0f / ray.direction.z);
+
+	hit.entity = EntityId { 0, 0 };
+	hit.distance = std::numeric_limits<float>::infinity();
+
+	tree.Raycast(ray.origin, ray.direction, maxDistance, [&](uint32_t proxy, float closest) {
+		float distance;
+
+		// The leaf's box is enlarged, so check the entity's real bounds
+		if (proxies[proxy].bounds.Raycast(ray.origin, inverseDirection, closest, distance) && distance < hit.distance) {
+			hit.entity = proxies[proxy].entity;
+			hit.distance = distance;
+			return distance;
+		}
+
+		return closest;
+	});
+
+	return hit.IsHit();
+}
+
+void IceFairy::SpatialIndex::QueryRadius(const std::vector<RadiusQuery>& queries, QueryResults& results, ThreadPool* pool) const {
+	RunBatch(queries.size(), results, pool, [&](size_t i, std::vector<EntityId>& found) {
+		QueryRadius(queries[i].centre, queries[i].radius, found);
+	});
+}
+
+void IceFairy::SpatialIndex::QueryAABB(const std::vector<AABB>& queries, QueryResults& results, ThreadPool* pool) const {
+	RunBatch(queries.size(), results, pool, [&](size_t i, std::vector<EntityId>& found) {
+		QueryAABB(queries[i], found);
+	});
+}
+
+void IceFairy::SpatialIndex::Raycast(const std::vector<Ray3f>& rays, float maxDistance, std::vector<RayHit>& hits, ThreadPool* pool) const {
+	hits.resize(rays.size());
+
+	auto job = [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; i++) {
+			Raycast(rays[i], maxDistance, hits[i]);
+		}
+	};
+
+	if (pool == nullptr) {
+		job(0, rays.size());
+	}
+	else {
+		pool->ParallelFor(rays.size(), BATCH_CHUNK_SIZE, job);
+	}
+}
+
+bool IceFairy::SpatialIndex::Contains(EntityId id) const {
+	return id.index < proxyOfSlot.size()
+		&& proxyOfSlot[id.index] != NO_PROXY
+		&& proxies[proxyOfSlot[id.index]].entity == id;
+}
+
+size_t IceFairy::SpatialIndex::GetSize(void) const {
+	return tree.GetLeafCount();
+}
+
+const IceFairy::AABBTree& IceFairy::SpatialIndex::GetTree(void) const {
+	return tree;
+}
+
+void IceFairy::SpatialIndex::UpdateEntity(EntityId id, const Vector3f& position, const Vector3f& halfExtents) {
+	AABB bounds = AABB::FromCentre(position, halfExtents);
+	uint64_t cell = GetCell(position);
+
+	maxHalfExtent = std::max({ maxHalfExtent, halfExtents.x, halfExtents.y, halfExtents.z });
+
+	if (id.index >= proxyOfSlot.size()) {
+		proxyOfSlot.resize(id.index + 1, NO_PROXY);
+	}
+
+	uint32_t proxy = proxyOfSlot[id.index];
+
+	// The slot now belongs to a different entity
+	if (proxy != NO_PROXY && proxies[proxy].entity != id) {
+		RemoveProxy(proxy);
+		proxy = NO_PROXY;
+	}
+
+	if (proxy == NO_PROXY) {
+		if (!freeProxies.empty()) {
+			proxy = freeProxies.back();
+			freeProxies.pop_back();
+		}
+		else {
+			proxy = (uint32_t) proxies.size();
+			proxies.emplace_back();
+		}
+
+		proxies[proxy].entity = id;
+		proxies[proxy].bounds = bounds;
+		proxies[proxy].leaf = tree.Insert(bounds, proxy);
+		proxyOfSlot[id.index] = proxy;
+		AddToCell(proxy, cell);
+		return;
+	}
+
+	proxies[proxy].bounds = bounds;
+	tree.Move(proxies[proxy].leaf, bounds);
+
+	if (proxies[proxy].cell != cell) {
+		RemoveFromCell(proxy);
+		AddToCell(proxy, cell);
+	}
+}
+
+void IceFairy::SpatialIndex::RemoveProxy(uint32_t proxy) {
+	auto& removed = proxies[proxy];
+
+	RemoveFromCell(proxy);
+	tree.Remove(removed.leaf);
+
+	proxyOfSlot[removed.entity.index] = NO_PROXY;
+	removed.leaf = AABBTree::NULL_NODE;
+	freeProxies.push_back(proxy);
+}
+
+void IceFairy::SpatialIndex::AddToCell(uint32_t proxy, uint64_t cell) {
+	auto& members = cells[cell];
+
+	proxies[proxy].cell = cell;
+	proxies[proxy].cellPosition = (uint32_t) members.size();
+	members.push_back(proxy);
+}
+
+void IceFairy::SpatialIndex::RemoveFromCell(uint32_t proxy) {
+	auto it = cells.find(proxies[proxy].cell);
+	auto& members = it->second;
+	uint32_t position = proxies[proxy].cellPosition;
+
+	members[position] = members.back();
+	proxies[members[position]].cellPosition = position;
+	members.pop_back();
+
+	// Keeps the map from filling with empty cells as entities move through the world
+	if (members.empty()) {
+		cells.erase(it);
+	}
+}
+
+int32_t IceFairy::SpatialIndex::GetCellCoordinate(float value) const {
+	return (int32_t) std::floor(value * inverseCellSize);
+}
+
+uint64_t IceFairy::SpatialIndex::GetCell(const Vector3f& position) const {
+	return GetCell(GetCellCoordinate(position.x), GetCellCoordinate(position.y), GetCellCoordinate(position.z));
+}
+
+uint64_t IceFairy::SpatialIndex::GetCell(int32_t x, int32_t y, int32_t z) {
+	// 21 bits per axis, enough for a million cells either side of the origin
+	const uint64_t mask = (1ull << 21) - 1;
+
+	return ((uint64_t) x & mask) | (((uint64_t) y & mask) << 21) | (((uint64_t) z & mask) << 42);
+}
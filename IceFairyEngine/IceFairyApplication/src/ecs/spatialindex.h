@@ -0,0 +1,195 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <limits>
+#include <memory>
+
+#include "aabbtree.h"
+#include "entityid.h"
+#include "componentcolumn.h"
+#include "components/positioncomponent.h"
+#include "components/boundscomponent.h"
+#include "math/vector.h"
+#include "core/utilities/threadpool.h"
+
+namespace IceFairy {
+
+	class EntityRegistry;
+
+	/*! \brief Finds entities by where they are.
+	 *
+	 * Tracks every entity with both a \ref PositionComponent and a \ref BoundsComponent, in a
+	 * uniform hash grid for neighbour queries and in an \ref AABBTree for box and ray queries.
+	 * \ref Update only revisits the entities whose components changed since the last update,
+	 * found from the registry's change ticks, and the entities which have left the view.\n
+	 * The queries don't modify the index, so systems running in parallel can share one as long
+	 * as nothing updates it while they run. The batched queries split their work across a
+	 * \ref ThreadPool themselves.
+	 *
+	 * Sample usage:
+	 * \code{.cpp}
+	 * SpatialIndex index(2.0f);
+	 *
+	 * // Once per frame, after movement
+	 * index.Update(registry);
+	 *
+	 * std::vector<EntityId> neighbours;
+	 * index.QueryRadius(position, 5.0f, neighbours);
+	 * \endcode
+	 */
+	class SpatialIndex {
+	public:
+		struct RadiusQuery {
+			Vector3f centre;
+			float radius;
+		};
+
+		struct RayHit {
+			EntityId entity;
+			//! Distance along the ray, infinite if nothing was hit
+			float distance;
+
+			bool IsHit(void) const {
+				return distance != std::numeric_limits<float>::infinity();
+			}
+		};
+
+		/*! \brief Results of a batch of queries, the entities found by every query one after another.
+		 *
+		 * The entities found by query \c i are \c entities[offsets[i]] up to \c entities[offsets[i + 1]].
+		 */
+		struct QueryResults {
+			std::vector<size_t> offsets;
+			std::vector<EntityId> entities;
+
+			size_t GetCount(size_t query) const {
+				return offsets[query + 1] - offsets[query];
+			}
+
+			const EntityId* GetEntities(size_t query) const {
+				return entities.data() + offsets[query];
+			}
+		};
+
+		/*! \param cellSize Width of a grid cell, around the typical query radius works best.
+		 * \param margin How far an entity can move before the tree has to be changed.
+		 */
+		SpatialIndex(float cellSize = 4.0f, float margin = 0.5f);
+
+		/*! \brief Adds, moves and removes entities to match \p registry.
+		 *
+		 * Only entities whose position or bounds changed since the previous update are moved.
+		 * The registry's view logs the entities which lose either component or are destroyed,
+		 * so only those are removed and the rest aren't visited.\n
+		 * Updating from a different registry than last time clears the index first.
+		 */
+		void Update(EntityRegistry& registry);
+		void Clear(void);
+
+		/*! \brief Appends every entity whose bounds are within \p radius of \p centre to \p results. */
+		void QueryRadius(const Vector3f& centre, float radius, std::vector<EntityId>& results) const;
+		/*! \brief Appends every entity whose bounds overlap \p bounds to \p results. */
+		void QueryAABB(const AABB& bounds, std::vector<EntityId>& results) const;
+		/*! \brief Finds the closest entity whose bounds \p ray hits within \p maxDistance.
+		 *
+		 * \returns Whether anything was hit.
+		 */
+		bool Raycast(const Ray3f& ray, float maxDistance, RayHit& hit) const;
+
+		/*! \brief Runs every query in \p queries, in parallel across \p pool if one is given. */
+		void QueryRadius(const std::vector<RadiusQuery>& queries, QueryResults& results, ThreadPool* pool = nullptr) const;
+		/*! \brief Runs every query in \p queries, in parallel across \p pool if one is given. */
+		void QueryAABB(const std::vector<AABB>& queries, QueryResults& results, ThreadPool* pool = nullptr) const;
+		/*! \brief Casts every ray in \p rays, setting \p hits[i] to the closest hit of ray \c i. */
+		void Raycast(const std::vector<Ray3f>& rays, float maxDistance, std::vector<RayHit>& hits, ThreadPool* pool = nullptr) const;
+
+		bool Contains(EntityId id) const;
+		/*! \returns The number of entities tracked. */
+		size_t GetSize(void) const;
+		const AABBTree& GetTree(void) const;
+
+	private:
+		//! The number of queries a batch gives to each task
+		static constexpr size_t BATCH_CHUNK_SIZE = 64;
+		static constexpr uint32_t NO_PROXY = UINT32_MAX;
+
+		/*! \brief A tracked entity. A free proxy has no leaf. */
+		struct Proxy {
+			EntityId entity;
+			AABB bounds;
+			int32_t leaf;
+			uint64_t cell;
+			//! Position in the cell's list
+			uint32_t cellPosition;
+		};
+
+		void UpdateEntity(EntityId id, const Vector3f& position, const Vector3f& halfExtents);
+		void RemoveProxy(uint32_t proxy);
+		void AddToCell(uint32_t proxy, uint64_t cell);
+		void RemoveFromCell(uint32_t proxy);
+		int32_t GetCellCoordinate(float value) const;
+		uint64_t GetCell(const Vector3f& position) const;
+		static uint64_t GetCell(int32_t x, int32_t y, int32_t z);
+
+		/*! \brief Runs \p query for each of the \p count queries, collecting what they find into \p results. */
+		template<typename F>
+		static void RunBatch(size_t count, QueryResults& results, ThreadPool* pool, const F& query) {
+			results.offsets.assign(count + 1, 0);
+			results.entities.clear();
+
+			if (pool == nullptr || count <= BATCH_CHUNK_SIZE) {
+				for (size_t i = 0; i < count; i++) {
+					results.offsets[i] = results.entities.size();
+					query(i, results.entities);
+				}
+				results.offsets[count] = results.entities.size();
+				return;
+			}
+
+			// Every chunk collects into its own list, which are joined in order afterwards
+			std::vector<std::vector<EntityId>> chunks((count + BATCH_CHUNK_SIZE - 1) / BATCH_CHUNK_SIZE);
+			std::vector<size_t> counts(count);
+
+			pool->ParallelFor(count, BATCH_CHUNK_SIZE, [&](size_t begin, size_t end) {
+				auto& found = chunks[begin / BATCH_CHUNK_SIZE];
+
+				for (size_t i = begin; i < end; i++) {
+					size_t before = found.size();
+					query(i, found);
+					counts[i] = found.size() - before;
+				}
+			});
+
+			for (size_t i = 0; i < count; i++) {
+				results.offsets[i + 1] = results.offsets[i] + counts[i];
+			}
+
+			results.entities.reserve(results.offsets[count]);
+			for (auto& found : chunks) {
+				results.entities.insert(results.entities.end(), found.begin(), found.end());
+			}
+		}
+
+		float cellSize;
+		float inverseCellSize;
+		//! The largest half extent of any tracked entity, how far beyond its cell an entity can reach
+		float maxHalfExtent;
+
+		AABBTree tree;
+		std::unordered_map<uint64_t, std::vector<uint32_t>> cells;
+
+		std::vector<Proxy> proxies;
+		std::vector<uint32_t> freeProxies;
+		//! Proxy of every entity, indexed by slot index
+		std::vector<uint32_t> proxyOfSlot;
+
+		Tick lastUpdate;
+		//! The registry whose view logs into \ref removals
+		const EntityRegistry* trackedRegistry;
+		//! Entities which left the registry's view since the last update
+		std::shared_ptr<std::vector<EntityId>> removals;
+	};
+
+}
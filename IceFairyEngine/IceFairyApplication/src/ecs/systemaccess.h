@@ -0,0 +1,45 @@
+#pragma once
+
+#include <type_traits>
+
+#include "componenttypes.h"
+
+namespace IceFairy {
+
+	/*! \brief The components a system reads and writes.
+	 *
+	 * Built from a system's component list, where a \c const component is only read:
+	 * \code{.cpp}
+	 * // Reads Velocity, writes Position
+	 * auto access = SystemAccess::Create<Position, const Velocity>();
+	 * \endcode
+	 */
+	struct SystemAccess {
+		ComponentMask reads;
+		ComponentMask writes;
+
+		/*! \returns Whether running alongside \p other could race, i.e. either writes what the other touches. */
+		bool Conflicts(const SystemAccess& other) const {
+			return (writes & (other.reads | other.writes)).any() || (other.writes & reads).any();
+		}
+
+		template<typename... Ts>
+		static SystemAccess Create(void) {
+			SystemAccess access;
+			(access.Add<Ts>(), ...);
+			return access;
+		}
+
+	private:
+		template<typename T>
+		void Add(void) {
+			if (std::is_const<T>::value) {
+				reads.set(ComponentTypes::GetId<T>());
+			}
+			else {
+				writes.set(ComponentTypes::GetId<T>());
+			}
+		}
+	};
+
+}
@@ -0,0 +1,20 @@
+#include "vertexobjectsystem.h"
+
+#include "../entityregistry.h"
+#include "vulkan/vulkanmodule.h"
+
+void IceFairy::AddVertexObjectSystems(EntityRegistry& registry) {
+	if (!registry.IsModuleRegistered<VulkanModule>()) {
+		return;
+	}
+
+	auto module = registry.GetRegisteredModule<VulkanModule>();
+
+	// Only emits components added since its last run, so existing geometry costs nothing per frame
+	registry.AddSystem(std::make_shared<VertexObjectCreationJob>(registry.GetEvents()),
+		EntityRegistry::EXECUTION_PARALLEL, EntityRegistry::FILTER_ADDED);
+	// The module isn't thread-safe, so uploads happen on this thread once the systems are done
+	registry.AddEventHandler<MeshAddedEvent>([module](const MeshAddedEvent& event) {
+		module->AddVertexObject(VertexObject(event.mesh->indices, event.mesh->vertices));
+	});
+}
\ No newline at end of file
@@ -1,27 +1,43 @@
 #pragma once
 
+#include <memory>
+
 #include "../jobsystem.h"
+#include "../eventbus.h"
 #include "../components/vertexobjectcomponent.h"
-#include "vulkan/vulkanmodule.h"
 
 namespace IceFairy {
 
+	class EntityRegistry;
+
+	/*! \brief Emitted when a \ref VertexObjectComponent is added, so its mesh can be uploaded. */
+	struct MeshAddedEvent {
+		std::shared_ptr<const Mesh> mesh;
+	};
+
 	template <>
-	class JobSystem<VertexObjectComponent> {
+	class JobSystem<const VertexObjectComponent> {
 	public:
-		JobSystem(std::shared_ptr<VulkanModule> vulkanModule) :
-			vulkanModule(vulkanModule) {
+		JobSystem(EventBus& events) :
+			events(events) {
 		}
 
-		void Execute(std::shared_ptr<VertexObjectComponent> voc) {
-			// TODO: Logging
-			vulkanModule->AddVertexObject(VertexObject(voc->GetIndicies(), voc->GetVertices()));
+		void Execute(const VertexObjectComponent& voc) {
+			events.Emit(MeshAddedEvent { voc.GetMesh() });
 		}
 
 	private:
-		std::shared_ptr<VulkanModule> vulkanModule;
+		EventBus& events;
 	};
 
-	typedef JobSystem<VertexObjectComponent> VertexObjectCreationJob;
+	typedef JobSystem<const VertexObjectComponent> VertexObjectCreationJob;
+
+	/*! \brief Uploads the mesh of every \ref VertexObjectComponent added to \p registry to its
+	 * \ref VulkanModule, if one is registered.
+	 *
+	 * Passed to \ref EntityRegistry::AddInitialiser, so only applications linking the graphics
+	 * module depend on it.
+	 */
+	void AddVertexObjectSystems(EntityRegistry& registry);
 
 }
\ No newline at end of file
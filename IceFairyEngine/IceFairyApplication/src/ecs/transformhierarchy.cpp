@@ -0,0 +1,341 @@
+#include "transformhierarchy.h"
+
+#include <algorithm>
+
+IceFairy::TransformHierarchy::TransformHierarchy() :
+	levelOffsets { 0 },
+	firstDirtyLevel(SIZE_MAX),
+	numRemoved(0),
+	isSorted(true) {
+}
+
+void IceFairy::TransformHierarchy::Add(EntityId entity, const Matrix4f& local) {
+	if (Contains(entity)) {
+		throw TransformHierarchyException(entity, "Entity already has a transform");
+	}
+
+	if (entity.index >= nodes.size()) {
+		nodes.resize(entity.index + 1, NO_NODE);
+	}
+
+	nodes[entity.index] = (uint32_t) entities.size();
+
+	entities.push_back(entity);
+	parents.push_back(NO_NODE);
+	firstChildren.push_back(NO_NODE);
+	nextSiblings.push_back(NO_NODE);
+	previousSiblings.push_back(NO_NODE);
+	depths.push_back(0);
+	locals.push_back(local);
+	worlds.push_back(local);
+	dirty.push_back(1);
+	removed.push_back(0);
+
+	isSorted = false;
+}
+
+void IceFairy::TransformHierarchy::Remove(EntityId entity) {
+	uint32_t node = GetNode(entity);
+	std::vector<EntityId> subtree { entity };
+
+	GetDescendants(entity, subtree);
+	Detach(node);
+
+	for (auto id : subtree) {
+		uint32_t removedNode = nodes[id.index];
+
+		removed[removedNode] = 1;
+		nodes[id.index] = NO_NODE;
+	}
+
+	numRemoved += subtree.size();
+	isSorted = false;
+}
+
+bool IceFairy::TransformHierarchy::Contains(EntityId entity) const {
+	return entity.index < nodes.size()
+		&& nodes[entity.index] != NO_NODE
+		&& entities[nodes[entity.index]] == entity;
+}
+
+void IceFairy::TransformHierarchy::SetParent(EntityId child, EntityId parent) {
+	uint32_t childNode = GetNode(child);
+	uint32_t parentNode = GetNode(parent);
+
+	for (uint32_t ancestor = parentNode; ancestor != NO_NODE; ancestor = parents[ancestor]) {
+		if (ancestor == childNode) {
+			throw TransformHierarchyException(child, "Cannot parent an entity to itself or one of its descendants");
+		}
+	}
+
+	Detach(childNode);
+	Attach(childNode, parentNode);
+	MarkDirty(childNode);
+
+	isSorted = false;
+}
+
+void IceFairy::TransformHierarchy::ClearParent(EntityId child) {
+	uint32_t node = GetNode(child);
+
+	if (parents[node] == NO_NODE) {
+		return;
+	}
+
+	Detach(node);
+	MarkDirty(node);
+
+	isSorted = false;
+}
+
+bool IceFairy::TransformHierarchy::HasParent(EntityId child) const {
+	return parents[GetNode(child)] != NO_NODE;
+}
+
+IceFairy::EntityId IceFairy::TransformHierarchy::GetParent(EntityId child) const {
+	uint32_t parent = parents[GetNode(child)];
+
+	if (parent == NO_NODE) {
+		throw TransformHierarchyException(child, "Entity has no parent");
+	}
+
+	return entities[parent];
+}
+
+std::vector<IceFairy::EntityId> IceFairy::TransformHierarchy::GetChildren(EntityId parent) const {
+	std::vector<EntityId> children;
+
+	for (uint32_t child = firstChildren[GetNode(parent)]; child != NO_NODE; child = nextSiblings[child]) {
+		children.push_back(entities[child]);
+	}
+
+	return children;
+}
+
+void IceFairy::TransformHierarchy::GetDescendants(EntityId entity, std::vector<EntityId>& descendants) const {
+	size_t first = descendants.size();
+
+	for (uint32_t child = firstChildren[GetNode(entity)]; child != NO_NODE; child = nextSiblings[child]) {
+		descendants.push_back(entities[child]);
+	}
+
+	// Breadth first, so parents are always listed before their children
+	for (size_t i = first; i < descendants.size(); i++) {
+		for (uint32_t child = firstChildren[nodes[descendants[i].index]]; child != NO_NODE; child = nextSiblings[child]) {
+			descendants.push_back(entities[child]);
+		}
+	}
+}
+
+void IceFairy::TransformHierarchy::SetLocal(EntityId entity, const Matrix4f& local) {
+	uint32_t node = GetNode(entity);
+
+	locals[node] = local;
+	MarkDirty(node);
+}
+
+const IceFairy::Matrix4f& IceFairy::TransformHierarchy::GetLocal(EntityId entity) const {
+	return locals[GetNode(entity)];
+}
+
+const IceFairy::Matrix4f& IceFairy::TransformHierarchy::GetWorld(EntityId entity) const {
+	return worlds[GetNode(entity)];
+}
+
+void IceFairy::TransformHierarchy::Update(ThreadPool* pool, size_t chunkSize) {
+	if (!isSorted) {
+		Sort();
+	}
+
+	size_t numLevels = GetNumLevels();
+
+	// Levels above the first dirty one can't have changed
+	for (size_t level = firstDirtyLevel; level < numLevels; level++) {
+		size_t begin = levelOffsets[level];
+		size_t end = levelOffsets[level + 1];
+
+		if (pool == nullptr) {
+			UpdateRange(begin, end);
+			continue;
+		}
+
+		pool->ParallelFor(end - begin, chunkSize, [&](size_t first, size_t last) {
+			UpdateRange(begin + first, begin + last);
+		});
+	}
+
+	std::fill(dirty.begin(), dirty.end(), 0);
+	firstDirtyLevel = SIZE_MAX;
+}
+
+size_t IceFairy::TransformHierarchy::GetSize(void) const {
+	return entities.size() - numRemoved;
+}
+
+size_t IceFairy::TransformHierarchy::GetNumLevels(void) const {
+	return levelOffsets.size() - 1;
+}
+
+uint32_t IceFairy::TransformHierarchy::GetNode(EntityId entity) const {
+	if (!Contains(entity)) {
+		throw TransformHierarchyException(entity, "Entity has no transform");
+	}
+
+	return nodes[entity.index];
+}
+
+void IceFairy::TransformHierarchy::Attach(uint32_t node, uint32_t parent) {
+	parents[node] = parent;
+	previousSiblings[node] = NO_NODE;
+	nextSiblings[node] = firstChildren[parent];
+
+	if (firstChildren[parent] != NO_NODE) {
+		previousSiblings[firstChildren[parent]] = node;
+	}
+
+	firstChildren[parent] = node;
+}
+
+void IceFairy::TransformHierarchy::Detach(uint32_t node) {
+	uint32_t parent = parents[node];
+
+	if (parent == NO_NODE) {
+		return;
+	}
+
+	if (previousSiblings[node] != NO_NODE) {
+		nextSiblings[previousSiblings[node]] = nextSiblings[node];
+	}
+	else {
+		firstChildren[parent] = nextSiblings[node];
+	}
+
+	if (nextSiblings[node] != NO_NODE) {
+		previousSiblings[nextSiblings[node]] = previousSiblings[node];
+	}
+
+	parents[node] = NO_NODE;
+	nextSiblings[node] = NO_NODE;
+	previousSiblings[node] = NO_NODE;
+}
+
+void IceFairy::TransformHierarchy::MarkDirty(uint32_t node) {
+	dirty[node] = 1;
+
+	// Depths are only known while sorted, Sort restarts from the first level anyway
+	if (isSorted) {
+		firstDirtyLevel = std::min<size_t>(firstDirtyLevel, depths[node]);
+	}
+}
+
+void IceFairy::TransformHierarchy::Sort(void) {
+	size_t numNodes = entities.size();
+	std::vector<uint32_t> newDepths(numNodes, NO_NODE);
+	std::vector<uint32_t> chain;
+	uint32_t numLevels = 0;
+
+	// Walk up to the nearest node with a known depth, then fill in the depths on the way back
+	for (uint32_t node = 0; node < numNodes; node++) {
+		if (removed[node]) {
+			continue;
+		}
+
+		uint32_t ancestor = node;
+		while (ancestor != NO_NODE && newDepths[ancestor] == NO_NODE) {
+			chain.push_back(ancestor);
+			ancestor = parents[ancestor];
+		}
+
+		uint32_t depth = ancestor == NO_NODE ? 0 : newDepths[ancestor] + 1;
+		for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+			newDepths[*it] = depth++;
+		}
+
+		numLevels = std::max(numLevels, depth);
+		chain.clear();
+	}
+
+	// Counting sort by depth, which keeps the existing order within a level
+	levelOffsets.assign(numLevels + 1, 0);
+	for (uint32_t node = 0; node < numNodes; node++) {
+		if (!removed[node]) {
+			levelOffsets[newDepths[node] + 1]++;
+		}
+	}
+
+	for (size_t level = 0; level < numLevels; level++) {
+		levelOffsets[level + 1] += levelOffsets[level];
+	}
+
+	std::vector<size_t> nextInLevel(levelOffsets.begin(), levelOffsets.end() - 1);
+	std::vector<uint32_t> newIndices(numNodes, NO_NODE);
+	for (uint32_t node = 0; node < numNodes; node++) {
+		if (!removed[node]) {
+			newIndices[node] = (uint32_t) nextInLevel[newDepths[node]]++;
+		}
+	}
+
+	size_t numSorted = numNodes - numRemoved;
+	auto remap = [&](uint32_t node) { return node == NO_NODE ? NO_NODE : newIndices[node]; };
+
+	std::vector<EntityId> sortedEntities(numSorted);
+	std::vector<uint32_t> sortedParents(numSorted);
+	std::vector<uint32_t> sortedFirstChildren(numSorted);
+	std::vector<uint32_t> sortedNextSiblings(numSorted);
+	std::vector<uint32_t> sortedPreviousSiblings(numSorted);
+	std::vector<uint32_t> sortedDepths(numSorted);
+	std::vector<Matrix4f> sortedLocals(numSorted);
+	std::vector<Matrix4f> sortedWorlds(numSorted);
+	std::vector<uint8_t> sortedDirty(numSorted);
+
+	for (uint32_t node = 0; node < numNodes; node++) {
+		if (removed[node]) {
+			continue;
+		}
+
+		uint32_t index = newIndices[node];
+
+		sortedEntities[index] = entities[node];
+		sortedParents[index] = remap(parents[node]);
+		sortedFirstChildren[index] = remap(firstChildren[node]);
+		sortedNextSiblings[index] = remap(nextSiblings[node]);
+		sortedPreviousSiblings[index] = remap(previousSiblings[node]);
+		sortedDepths[index] = newDepths[node];
+		sortedLocals[index] = locals[node];
+		sortedWorlds[index] = worlds[node];
+		sortedDirty[index] = dirty[node];
+
+		nodes[entities[node].index] = index;
+	}
+
+	entities.swap(sortedEntities);
+	parents.swap(sortedParents);
+	firstChildren.swap(sortedFirstChildren);
+	nextSiblings.swap(sortedNextSiblings);
+	previousSiblings.swap(sortedPreviousSiblings);
+	depths.swap(sortedDepths);
+	locals.swap(sortedLocals);
+	worlds.swap(sortedWorlds);
+	dirty.swap(sortedDirty);
+	removed.assign(numSorted, 0);
+
+	numRemoved = 0;
+	firstDirtyLevel = 0;
+	isSorted = true;
+}
+
+void IceFairy::TransformHierarchy::UpdateRange(size_t begin, size_t end) {
+	for (size_t node = begin; node < end; node++) {
+		uint32_t parent = parents[node];
+
+		if (parent == NO_NODE) {
+			if (dirty[node]) {
+				worlds[node] = locals[node];
+			}
+		}
+		else if (dirty[node] || dirty[parent]) {
+			worlds[node] = worlds[parent] * locals[node];
+			dirty[node] = 1;
+		}
+	}
+}
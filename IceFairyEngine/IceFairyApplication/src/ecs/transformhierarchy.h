@@ -0,0 +1,116 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+#include "entityid.h"
+#include "math/matrix.h"
+#include "core/utilities/icexception.h"
+#include "core/utilities/threadpool.h"
+
+namespace IceFairy {
+
+	class TransformHierarchyException : public ICException {
+	public:
+		TransformHierarchyException(const EntityId& entityId, const std::string& message)
+			: ICException("TransformHierarchy encountered an error with entity[" + entityId.Str() + "]: " + message) {
+		}
+	};
+
+	/*! \brief Local and world transforms of entities arranged in a parent/child hierarchy.
+	 *
+	 * Transforms are stored sorted by their depth in the hierarchy, so every parent comes before
+	 * its children and \ref Update recomputes the world matrices in one linear pass over
+	 * contiguous arrays, a depth level at a time. Only transforms which changed, along with their
+	 * descendants, are recomputed, and every depth level is split across the thread pool.\n
+	 * Adding, removing or reparenting a transform leaves the order stale until the next
+	 * \ref Update re-sorts it, so any number of those changes cost a single sort.
+	 *
+	 * Sample usage:
+	 * \code{.cpp}
+	 * auto& transforms = registry.GetTransforms();
+	 *
+	 * transforms.Add(arm.GetId(), Matrix4f::Translate(1.0f, 0.0f, 0.0f));
+	 * transforms.Add(hand.GetId(), Matrix4f::Translate(0.0f, 1.0f, 0.0f));
+	 * transforms.SetParent(hand.GetId(), arm.GetId());
+	 *
+	 * registry.UpdateTransforms();
+	 * auto& world = transforms.GetWorld(hand.GetId());
+	 * \endcode
+	 */
+	class TransformHierarchy {
+	public:
+		TransformHierarchy();
+
+		/*! \brief Gives \p entity a transform with no parent. */
+		void Add(EntityId entity, const Matrix4f& local = Matrix4f::Identity());
+		/*! \brief Removes the transform of \p entity along with those of all of its descendants. */
+		void Remove(EntityId entity);
+		bool Contains(EntityId entity) const;
+
+		/*! \brief Makes \p child's transform relative to \p parent's.
+		 *
+		 * \throws TransformHierarchyException if \p parent is \p child or one of its descendants.
+		 */
+		void SetParent(EntityId child, EntityId parent);
+		/*! \brief Makes \p child a root, its local transform becomes its world transform. */
+		void ClearParent(EntityId child);
+		bool HasParent(EntityId child) const;
+		EntityId GetParent(EntityId child) const;
+		std::vector<EntityId> GetChildren(EntityId parent) const;
+		/*! \brief Appends every descendant of \p entity to \p descendants, parents before their children. */
+		void GetDescendants(EntityId entity, std::vector<EntityId>& descendants) const;
+
+		void SetLocal(EntityId entity, const Matrix4f& local);
+		const Matrix4f& GetLocal(EntityId entity) const;
+		/*! \returns The world transform of \p entity as of the last \ref Update. */
+		const Matrix4f& GetWorld(EntityId entity) const;
+
+		/*! \brief Recomputes the world transform of every changed transform and its descendants.
+		 *
+		 * \param pool Splits each depth level across this pool, or runs serially when null.
+		 * \param chunkSize The maximum number of transforms given to a single task.
+		 */
+		void Update(ThreadPool* pool = nullptr, size_t chunkSize = 1024);
+
+		size_t GetSize(void) const;
+		/*! \returns The number of depth levels, as of the last \ref Update. */
+		size_t GetNumLevels(void) const;
+
+	private:
+		friend class WorldSnapshot;
+
+		static constexpr uint32_t NO_NODE = UINT32_MAX;
+
+		/*! \throws TransformHierarchyException if \p entity has no transform. */
+		uint32_t GetNode(EntityId entity) const;
+		void Attach(uint32_t node, uint32_t parent);
+		void Detach(uint32_t node);
+		void MarkDirty(uint32_t node);
+		void Sort(void);
+		void UpdateRange(size_t begin, size_t end);
+
+		// Every array is indexed by node, and sorted by depth after Sort
+		std::vector<EntityId> entities;
+		std::vector<uint32_t> parents;
+		std::vector<uint32_t> firstChildren;
+		std::vector<uint32_t> nextSiblings;
+		std::vector<uint32_t> previousSiblings;
+		std::vector<uint32_t> depths;
+		std::vector<Matrix4f> locals;
+		std::vector<Matrix4f> worlds;
+		//! Not a vector<bool> so nodes of one level can be written concurrently
+		std::vector<uint8_t> dirty;
+		std::vector<uint8_t> removed;
+
+		//! Node of each entity, indexed by entity index
+		std::vector<uint32_t> nodes;
+		//! Index of the first node of each depth level, plus one past the last node
+		std::vector<size_t> levelOffsets;
+		size_t firstDirtyLevel;
+		size_t numRemoved;
+		bool isSorted;
+	};
+
+}
@@ -0,0 +1,469 @@
+#include "worldsnapshot.h"
+
+#include <fstream>
+#include <vector>
+#include <cstring>
+#include <utility>
+
+#include "entityregistry.h"
+#include "core/utilities/mappedfile.h"
+
+namespace {
+	const char SNAPSHOT_MAGIC[8] = { 'I', 'C', 'E', 'W', 'O', 'R', 'L', 'D' };
+	// Matches the alignment of component chunks, so blocks could be used straight from the mapping
+	const size_t BLOCK_ALIGNMENT = 64;
+
+	struct SnapshotHeader {
+		char magic[8];
+		uint32_t version;
+		uint32_t numTypes;
+		uint32_t numSlots;
+		uint32_t numFreeSlots;
+		uint32_t numArchetypes;
+		uint32_t numTransforms;
+	};
+
+	struct TypeRecord {
+		uint32_t nameLength;
+		uint32_t size;
+		uint32_t alignment;
+		uint32_t isTriviallyCopyable;
+	};
+
+	struct SlotRecord {
+		uint32_t generation;
+		uint32_t isAlive;
+	};
+
+	struct ArchetypeRecord {
+		uint32_t numColumns;
+		uint32_t numRows;
+	};
+
+	struct TransformRecord {
+		IceFairy::EntityId entity;
+		IceFairy::EntityId parent;
+		uint32_t hasParent;
+		uint32_t padding;
+		float local[16];
+	};
+
+	// A column of one archetype found by the validation pass of Load. Trivially copyable
+	// columns are one block holding every row, any other column has a block per row.
+	struct ColumnBlock {
+		IceFairy::ComponentTypeId id;
+		std::vector<std::pair<const unsigned char*, size_t>> blocks;
+	};
+
+	struct ArchetypeBlock {
+		IceFairy::ComponentMask mask;
+		const IceFairy::EntityId* entities;
+		uint32_t numRows;
+		std::vector<ColumnBlock> columns;
+	};
+
+	class SnapshotWriter {
+	public:
+		SnapshotWriter(const std::string& path) :
+			path(path),
+			out(path, std::ios::binary | std::ios::trunc),
+			offset(0) {
+			if (!out) {
+				throw IceFairy::WorldSnapshotException(path, "could not open file for writing");
+			}
+		}
+
+		void Write(const void* data, size_t size) {
+			out.write(static_cast<const char*>(data), size);
+			offset += size;
+
+			if (!out) {
+				throw IceFairy::WorldSnapshotException(path, "could not write to file");
+			}
+		}
+
+		template<typename T>
+		void Write(const T& record) {
+			Write(&record, sizeof(T));
+		}
+
+		void Align(size_t alignment) {
+			static const char zeros[BLOCK_ALIGNMENT] = { 0 };
+			Write(zeros, (alignment - offset % alignment) % alignment);
+		}
+
+	private:
+		std::string path;
+		std::ofstream out;
+		size_t offset;
+	};
+
+	class SnapshotReader {
+	public:
+		SnapshotReader(const std::string& path, const IceFairy::MappedFile& file) :
+			path(path),
+			data(file.GetData()),
+			size(file.GetSize()),
+			offset(0) {
+		}
+
+		const unsigned char* Read(size_t bytes) {
+			if (bytes > size - offset) {
+				throw IceFairy::WorldSnapshotException(path, "file is truncated");
+			}
+
+			auto block = data + offset;
+			offset += bytes;
+			return block;
+		}
+
+		// Every record is written at an offset aligned for it, so it can be used in place
+		template<typename T>
+		const T& Read(void) {
+			return *reinterpret_cast<const T*>(Read(sizeof(T)));
+		}
+
+		template<typename T>
+		const T* ReadArray(size_t count) {
+			return reinterpret_cast<const T*>(Read(count * sizeof(T)));
+		}
+
+		void Align(size_t alignment) {
+			Read((alignment - offset % alignment) % alignment);
+		}
+
+	private:
+		std::string path;
+		const unsigned char* data;
+		size_t size;
+		size_t offset;
+	};
+}
+
+void IceFairy::WorldSnapshot::Save(EntityRegistry& registry, const std::string& path) {
+	// Only types which have a component somewhere are written, indexed in the file by their position
+	std::vector<ComponentTypeId> types;
+	std::vector<uint32_t> fileTypes(ComponentTypes::GetCount(), UINT32_MAX);
+	std::vector<Archetype*> archetypes;
+
+	for (auto& archetype : registry.archetypes) {
+		if (archetype->GetSize() == 0) {
+			continue;
+		}
+
+		archetypes.push_back(archetype.get());
+
+		for (ComponentTypeId id = 0; id < fileTypes.size(); id++) {
+			if (archetype->HasComponent(id) && fileTypes[id] == UINT32_MAX) {
+				auto& info = ComponentTypes::GetInfo(id);
+
+				if (!info.isTriviallyCopyable && info.save == nullptr) {
+					throw WorldSnapshotException(path, "component type '" + info.name
+						+ "' isn't trivially copyable and has no serializer");
+				}
+
+				fileTypes[id] = (uint32_t) types.size();
+				types.push_back(id);
+			}
+		}
+	}
+
+	auto& transforms = registry.transforms;
+	SnapshotWriter writer(path);
+	SnapshotHeader header;
+
+	std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+	header.version = VERSION;
+	header.numTypes = (uint32_t) types.size();
+	header.numSlots = (uint32_t) registry.slots.size();
+	header.numFreeSlots = (uint32_t) registry.freeSlots.size();
+	header.numArchetypes = (uint32_t) archetypes.size();
+	header.numTransforms = (uint32_t) transforms.GetSize();
+	writer.Write(header);
+
+	for (auto id : types) {
+		auto& info = ComponentTypes::GetInfo(id);
+
+		writer.Write(TypeRecord { (uint32_t) info.name.size(), (uint32_t) info.size, (uint32_t) info.alignment, info.isTriviallyCopyable });
+		writer.Write(info.name.data(), info.name.size());
+		writer.Align(sizeof(uint32_t));
+	}
+	writer.Align(BLOCK_ALIGNMENT);
+
+	for (auto& slot : registry.slots) {
+		writer.Write(SlotRecord { slot.generation, slot.archetype != nullptr });
+	}
+	writer.Align(BLOCK_ALIGNMENT);
+
+	writer.Write(registry.freeSlots.data(), registry.freeSlots.size() * sizeof(uint32_t));
+	writer.Align(BLOCK_ALIGNMENT);
+
+	std::vector<unsigned char> buffer;
+
+	for (auto archetype : archetypes) {
+		std::vector<ComponentTypeId> columnTypes;
+		for (auto id : types) {
+			if (archetype->HasComponent(id)) {
+				columnTypes.push_back(id);
+			}
+		}
+
+		writer.Write(ArchetypeRecord { (uint32_t) columnTypes.size(), (uint32_t) archetype->GetSize() });
+		for (auto id : columnTypes) {
+			writer.Write(fileTypes[id]);
+		}
+		writer.Align(BLOCK_ALIGNMENT);
+
+		writer.Write(archetype->GetEntities().data(), archetype->GetSize() * sizeof(EntityId));
+		writer.Align(BLOCK_ALIGNMENT);
+
+		for (auto id : columnTypes) {
+			auto column = archetype->GetColumn(id);
+			auto& info = ComponentTypes::GetInfo(id);
+
+			// Tags are only saved in the archetype's list of types
+			if (column == nullptr) {
+				continue;
+			}
+
+			if (info.isTriviallyCopyable) {
+				uint64_t numBytes = column->GetSize() * info.size;
+
+				writer.Write(numBytes);
+				writer.Align(BLOCK_ALIGNMENT);
+				writer.Write(column->Get(0), (size_t) numBytes);
+			}
+			else {
+				for (size_t row = 0; row < column->GetSize(); row++) {
+					buffer.clear();
+					info.save(column->Get(row), buffer);
+
+					writer.Write((uint64_t) buffer.size());
+					writer.Write(buffer.data(), buffer.size());
+					writer.Align(sizeof(uint64_t));
+				}
+			}
+
+			writer.Align(BLOCK_ALIGNMENT);
+		}
+	}
+
+	for (size_t node = 0; node < transforms.entities.size(); node++) {
+		if (transforms.removed[node]) {
+			continue;
+		}
+
+		uint32_t parent = transforms.parents[node];
+		TransformRecord record;
+
+		record.entity = transforms.entities[node];
+		record.parent = parent != TransformHierarchy::NO_NODE ? transforms.entities[parent] : EntityId { 0, 0 };
+		record.hasParent = parent != TransformHierarchy::NO_NODE;
+		record.padding = 0;
+		std::memcpy(record.local, transforms.locals[node].v, sizeof(record.local));
+
+		writer.Write(record);
+	}
+}
+
+void IceFairy::WorldSnapshot::Load(EntityRegistry& registry, const std::string& path) {
+	if (registry.GetEntityCount() != 0 || registry.transforms.GetSize() != 0) {
+		throw WorldSnapshotException(path, "snapshots can only be loaded into an empty registry");
+	}
+
+	registry.CheckNotIterating("load a snapshot");
+
+	MappedFile file(path);
+	SnapshotReader reader(path, file);
+	auto& header = reader.Read<SnapshotHeader>();
+
+	if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0) {
+		throw WorldSnapshotException(path, "file is not a world snapshot");
+	}
+
+	if (header.version != VERSION) {
+		throw WorldSnapshotException(path, "snapshot version " + std::to_string(header.version)
+			+ " can't be loaded, expected version " + std::to_string(VERSION));
+	}
+
+	// Resolve every type before touching the registry
+	std::vector<ComponentTypeId> types;
+
+	for (uint32_t i = 0; i < header.numTypes; i++) {
+		auto& record = reader.Read<TypeRecord>();
+		std::string name(reinterpret_cast<const char*>(reader.Read(record.nameLength)), record.nameLength);
+		ComponentTypeId id;
+
+		reader.Align(sizeof(uint32_t));
+
+		if (!ComponentTypes::FindId(name, id)) {
+			throw WorldSnapshotException(path, "component type '" + name + "' hasn't been registered");
+		}
+
+		auto& info = ComponentTypes::GetInfo(id);
+
+		if (info.size != record.size || info.isTriviallyCopyable != (record.isTriviallyCopyable != 0)) {
+			throw WorldSnapshotException(path, "component type '" + name + "' has changed since the snapshot was saved");
+		}
+
+		if (!info.isTriviallyCopyable && info.load == nullptr) {
+			throw WorldSnapshotException(path, "component type '" + name + "' isn't trivially copyable and has no serializer");
+		}
+
+		types.push_back(id);
+	}
+	reader.Align(BLOCK_ALIGNMENT);
+
+	auto slots = reader.ReadArray<SlotRecord>(header.numSlots);
+	reader.Align(BLOCK_ALIGNMENT);
+
+	auto freeSlots = reader.ReadArray<uint32_t>(header.numFreeSlots);
+	reader.Align(BLOCK_ALIGNMENT);
+
+	for (uint32_t i = 0; i < header.numFreeSlots; i++) {
+		if (freeSlots[i] >= header.numSlots || slots[freeSlots[i]].isAlive) {
+			throw WorldSnapshotException(path, "free slot " + std::to_string(freeSlots[i]) + " isn't a dead slot");
+		}
+	}
+
+	// Walk every block before touching the registry, so a cut short or corrupt file leaves it empty
+	std::vector<ArchetypeBlock> archetypes(header.numArchetypes);
+	std::vector<bool> isPlaced(header.numSlots, false);
+
+	for (auto& block : archetypes) {
+		auto& record = reader.Read<ArchetypeRecord>();
+		auto fileTypes = reader.ReadArray<uint32_t>(record.numColumns);
+		reader.Align(BLOCK_ALIGNMENT);
+
+		block.numRows = record.numRows;
+
+		for (uint32_t columnIndex = 0; columnIndex < record.numColumns; columnIndex++) {
+			if (fileTypes[columnIndex] >= types.size()) {
+				throw WorldSnapshotException(path, "archetype refers to an unknown component type");
+			}
+
+			block.mask.set(types[fileTypes[columnIndex]]);
+		}
+
+		block.entities = reader.ReadArray<EntityId>(record.numRows);
+		reader.Align(BLOCK_ALIGNMENT);
+
+		for (uint32_t row = 0; row < record.numRows; row++) {
+			auto& id = block.entities[row];
+
+			if (id.index >= header.numSlots || !slots[id.index].isAlive
+				|| slots[id.index].generation != id.generation || isPlaced[id.index]) {
+				throw WorldSnapshotException(path, "archetype refers to entity '" + id.Str() + "' which isn't alive");
+			}
+
+			isPlaced[id.index] = true;
+		}
+
+		for (uint32_t columnIndex = 0; columnIndex < record.numColumns; columnIndex++) {
+			auto& info = ComponentTypes::GetInfo(types[fileTypes[columnIndex]]);
+
+			// Tags are only saved in the archetype's list of types
+			if (info.IsTag()) {
+				continue;
+			}
+
+			ColumnBlock column { info.id, {} };
+
+			if (info.isTriviallyCopyable) {
+				auto numBytes = reader.Read<uint64_t>();
+				reader.Align(BLOCK_ALIGNMENT);
+
+				if (numBytes != (uint64_t) record.numRows * info.size) {
+					throw WorldSnapshotException(path, "column of '" + info.name + "' has the wrong size");
+				}
+
+				column.blocks.emplace_back(reader.Read((size_t) numBytes), (size_t) numBytes);
+			}
+			else {
+				column.blocks.reserve(record.numRows);
+
+				for (uint32_t row = 0; row < record.numRows; row++) {
+					auto numBytes = reader.Read<uint64_t>();
+
+					if (numBytes > SIZE_MAX) {
+						throw WorldSnapshotException(path, "file is truncated");
+					}
+
+					column.blocks.emplace_back(reader.Read((size_t) numBytes), (size_t) numBytes);
+					reader.Align(sizeof(uint64_t));
+				}
+			}
+
+			block.columns.push_back(std::move(column));
+			reader.Align(BLOCK_ALIGNMENT);
+		}
+	}
+
+	for (uint32_t i = 0; i < header.numSlots; i++) {
+		if (slots[i].isAlive && !isPlaced[i]) {
+			throw WorldSnapshotException(path, "entity in slot " + std::to_string(i) + " isn't in any archetype");
+		}
+	}
+
+	auto transforms = reader.ReadArray<TransformRecord>(header.numTransforms);
+
+	auto isLoaded = [&](const EntityId& id) {
+		return id.index < header.numSlots && isPlaced[id.index] && slots[id.index].generation == id.generation;
+	};
+
+	for (uint32_t i = 0; i < header.numTransforms; i++) {
+		if (!isLoaded(transforms[i].entity) || (transforms[i].hasParent && !isLoaded(transforms[i].parent))) {
+			throw WorldSnapshotException(path, "transform refers to an entity which isn't alive");
+		}
+	}
+
+	// The whole file is known to be valid from here on
+	registry.slots.resize(header.numSlots);
+	for (uint32_t i = 0; i < header.numSlots; i++) {
+		registry.slots[i] = { nullptr, 0, slots[i].generation };
+	}
+
+	registry.freeSlots.assign(freeSlots, freeSlots + header.numFreeSlots);
+
+	Tick tick = registry.GetTick();
+
+	for (auto& block : archetypes) {
+		auto archetype = registry.GetArchetype(block.mask);
+		size_t firstRow = archetype->AddEntities(block.entities, block.numRows);
+
+		for (uint32_t row = 0; row < block.numRows; row++) {
+			auto& slot = registry.slots[block.entities[row].index];
+			slot.archetype = archetype;
+			slot.row = (uint32_t) (firstRow + row);
+		}
+
+		for (auto& columnBlock : block.columns) {
+			auto column = archetype->GetColumn(columnBlock.id);
+			auto& info = column->GetInfo();
+
+			if (info.isTriviallyCopyable) {
+				auto& data = columnBlock.blocks[0];
+				std::memcpy(column->AppendUninitialised(block.numRows, tick), data.first, data.second);
+			}
+			else {
+				for (auto& data : columnBlock.blocks) {
+					info.load(*column, data.first, data.second, tick);
+				}
+			}
+		}
+
+		for (uint32_t row = 0; row < block.numRows; row++) {
+			registry.NotifyEntityMoved(block.entities[row], nullptr, archetype);
+		}
+	}
+
+	for (uint32_t i = 0; i < header.numTransforms; i++) {
+		registry.transforms.Add(transforms[i].entity, Matrix4f(transforms[i].local));
+	}
+
+	for (uint32_t i = 0; i < header.numTransforms; i++) {
+		if (transforms[i].hasParent) {
+			registry.transforms.SetParent(transforms[i].entity, transforms[i].parent);
+		}
+	}
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <string>
+#include <cstdint>
+
+#include "core/utilities/icexception.h"
+
+namespace IceFairy {
+
+	class EntityRegistry;
+
+	class WorldSnapshotException : public ICException {
+	public:
+		WorldSnapshotException(const std::string& path, const std::string& message)
+			: ICException("World snapshot '" + path + "' encountered an error: " + message) {
+		}
+	};
+
+	/*! \brief Saves every entity, component and transform of an \ref EntityRegistry to a binary file.
+	 *
+	 * The file mirrors the registry's own layout: the entity slots, then every archetype's
+	 * entities and component columns, then the transform hierarchy, with each block aligned so
+	 * it can be copied straight out of a memory mapping. Loading maps the file and copies the
+	 * columns of trivially copyable components in a single \c memcpy each, instead of
+	 * rebuilding the world entity by entity.\n
+	 * Entity ids are kept, so components may safely refer to other entities.\n
+	 * Component types are matched by name, and must be registered before loading, for example
+	 * by calling \ref ComponentTypes::GetId. Components which aren't trivially copyable need a
+	 * serializer set with \ref ComponentTypes::SetSerializer. Type names come from \c typeid, so
+	 * snapshots are only portable between builds made by the same compiler.
+	 *
+	 * Sample usage:
+	 * \code{.cpp}
+	 * WorldSnapshot::Save(registry, "level.world");
+	 *
+	 * EntityRegistry loaded;
+	 * WorldSnapshot::Load(loaded, "level.world");
+	 * \endcode
+	 */
+	class WorldSnapshot {
+	public:
+		//! Bumped whenever the file layout changes, older files are rejected
+		static const uint32_t VERSION = 2;
+
+		/*! \throws WorldSnapshotException if a component can't be saved or the file can't be written. */
+		static void Save(EntityRegistry& registry, const std::string& path);
+		/*! \brief Loads the snapshot at \p path into \p registry, which must have no entities.
+		 *
+		 * Loaded components are marked as added at the registry's current tick.
+		 *
+		 * \throws WorldSnapshotException if the file is invalid, or a component type in it isn't
+		 * registered. The whole file is checked before anything is loaded, so the registry is
+		 * left empty if it throws.
+		 */
+		static void Load(EntityRegistry& registry, const std::string& path);
+	};
+
+}
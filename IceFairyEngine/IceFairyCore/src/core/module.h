@@ -6,8 +6,8 @@
 #include <memory>
 #include <exception>
 
-#include "utilities\logger.h"
-#include "utilities\icexception.h"
+#include "utilities/logger.h"
+#include "utilities/icexception.h"
 
 namespace IceFairy {
 	/*! \brief Thrown when no module by a given name exists. */
@@ -13,7 +13,11 @@ Logger::Logger()
 std::string Logger::GetTimestamp(void) {
 	auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
 	struct std::tm local;
+#ifdef _WIN32
 	localtime_s(&local, &now);
+#else
+	localtime_r(&now, &local);
+#endif
 
 	std::stringstream ss;
 	ss << std::put_time(&local, "%d/%m/%y %H:%M:%S");
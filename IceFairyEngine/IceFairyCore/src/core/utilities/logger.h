@@ -23,12 +23,17 @@
     char* text = new char[len];                     \
     if (fmt != NULL) {                              \
         va_list ap;                                 \
+        va_list measure;                            \
         va_start(ap, fmt);                          \
-        if (_vscprintf(fmt, ap) >= (signed) len) {  \
+        va_copy(measure, ap);                       \
+        int needed = vsnprintf(NULL, 0, fmt, measure); \
+        va_end(measure);                            \
+        if (needed >= (signed) len) {               \
+            va_end(ap);                             \
             delete[] text;                          \
             throw PrintBufferTooSmallException();   \
         }                                           \
-        vsnprintf_s(text, len, len, fmt, ap);       \
+        vsnprintf(text, len, fmt, ap);              \
         va_end(ap);                                 \
     }                                               \
     *(GetLogStream()) << text;                      \
@@ -0,0 +1,114 @@
+#include "mappedfile.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace IceFairy;
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& path) :
+	data(nullptr),
+	size(0),
+	file(INVALID_HANDLE_VALUE),
+	mapping(nullptr) {
+	file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		throw MappedFileException(path, "could not open file");
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize)) {
+		CloseHandle(file);
+		throw MappedFileException(path, "could not read file size");
+	}
+
+	size = (size_t) fileSize.QuadPart;
+
+	// Empty files can't be mapped, they simply have no data
+	if (size == 0) {
+		return;
+	}
+
+	mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr) {
+		CloseHandle(file);
+		throw MappedFileException(path, "could not create file mapping");
+	}
+
+	data = static_cast<const unsigned char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+	if (data == nullptr) {
+		CloseHandle(mapping);
+		CloseHandle(file);
+		throw MappedFileException(path, "could not map view of file");
+	}
+}
+
+MappedFile::~MappedFile() {
+	if (data != nullptr) {
+		UnmapViewOfFile(data);
+	}
+
+	if (mapping != nullptr) {
+		CloseHandle(mapping);
+	}
+
+	CloseHandle(file);
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path) :
+	data(nullptr),
+	size(0) {
+	int file = open(path.c_str(), O_RDONLY);
+	if (file == -1) {
+		throw MappedFileException(path, "could not open file");
+	}
+
+	struct stat fileStat;
+	if (fstat(file, &fileStat) == -1) {
+		close(file);
+		throw MappedFileException(path, "could not read file size");
+	}
+
+	size = (size_t) fileStat.st_size;
+
+	// Empty files can't be mapped, they simply have no data
+	if (size > 0) {
+		void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+
+		if (mapped == MAP_FAILED) {
+			close(file);
+			throw MappedFileException(path, "mmap failed");
+		}
+
+		data = static_cast<const unsigned char*>(mapped);
+	}
+
+	// The mapping keeps its own reference to the file
+	close(file);
+}
+
+MappedFile::~MappedFile() {
+	if (data != nullptr) {
+		munmap(const_cast<unsigned char*>(data), size);
+	}
+}
+
+#endif
+
+const unsigned char* MappedFile::GetData(void) const {
+	return data;
+}
+
+size_t MappedFile::GetSize(void) const {
+	return size;
+}
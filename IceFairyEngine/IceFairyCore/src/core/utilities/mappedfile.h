@@ -0,0 +1,45 @@
+#ifndef __ice_fairy_mapped_file_h__
+#define __ice_fairy_mapped_file_h__
+
+#include <string>
+#include <cstddef>
+
+#include "icexception.h"
+
+namespace IceFairy {
+	class MappedFileException : public ICException {
+	public:
+		MappedFileException(const std::string& path, const std::string& message)
+			: ICException("Cannot map file '" + path + "': " + message) {
+		}
+	};
+
+	/*! \brief Read-only memory mapping of a whole file.
+	 *
+	 * The file's contents are paged in by the OS as they are touched rather than read up front.
+	 * The mapping's base is page aligned.
+	 */
+	class MappedFile {
+	public:
+		/*! \throws MappedFileException if the file can't be opened or mapped. */
+		MappedFile(const std::string& path);
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		const unsigned char* GetData(void) const;
+		size_t GetSize(void) const;
+
+	private:
+		const unsigned char* data;
+		size_t size;
+
+#ifdef _WIN32
+		void* file;
+		void* mapping;
+#endif
+	};
+}
+
+#endif /* __ice_fairy_mapped_file_h__ */
@@ -0,0 +1,168 @@
+#ifndef __ice_fairy_mpsc_queue_h__
+#define __ice_fairy_mpsc_queue_h__
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace IceFairy {
+	/*! \brief Bounded, lock-free queue for many producer threads and a single consumer thread.
+	 *
+	 * A ring of cells, each with a sequence number telling producers and the consumer whether
+	 * it is free or full, after Dmitry Vyukov's bounded queue. Producers claim a cell with a
+	 * single compare and swap, and the consumer, being alone, needs no atomic read-modify-write
+	 * at all. Nothing is allocated after construction.\n
+	 * Any number of threads may call \ref TryPush at once, but only one thread at a time may
+	 * call \ref TryPop or \ref ConsumeAll.
+	 */
+	template<typename T>
+	class MPSCQueue {
+	public:
+		/*! \param capacity The number of elements the queue holds, rounded up to a power of two. */
+		MPSCQueue(size_t capacity) :
+			capacity(RoundUpToPowerOfTwo(capacity)),
+			cells(new Cell[this->capacity]),
+			enqueuePosition(0),
+			dequeuePosition(0) {
+			for (size_t i = 0; i < this->capacity; i++) {
+				cells[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+
+		~MPSCQueue() {
+			ConsumeAll([](T&) { });
+		}
+
+		MPSCQueue(const MPSCQueue&) = delete;
+		MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+		/*! \brief Appends \p value, unless the queue is full.
+		 *
+		 * \returns Whether \p value was added. If not, \p value is left untouched.
+		 */
+		template<typename U>
+		bool TryPush(U&& value) {
+			size_t position = enqueuePosition.load(std::memory_order_relaxed);
+			Cell* cell;
+
+			for (;;) {
+				cell = &cells[position & (capacity - 1)];
+				size_t sequence = cell->sequence.load(std::memory_order_acquire);
+				intptr_t difference = (intptr_t) sequence - (intptr_t) position;
+
+				if (difference == 0) {
+					if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+						break;
+					}
+				}
+				else if (difference < 0) {
+					// The consumer hasn't freed this cell since the last lap
+					return false;
+				}
+				else {
+					position = enqueuePosition.load(std::memory_order_relaxed);
+				}
+			}
+
+			new (&cell->storage) T(std::forward<U>(value));
+			cell->sequence.store(position + 1, std::memory_order_release);
+			return true;
+		}
+
+		/*! \brief Moves the oldest element into \p value.
+		 *
+		 * \returns Whether there was an element to pop.
+		 */
+		bool TryPop(T& value) {
+			auto moveOut = [&value](T& element) { value = std::move(element); };
+			return TryConsume(moveOut);
+		}
+
+		/*! \brief Calls \p function with every element pushed before the call, oldest first.
+		 *
+		 * Elements pushed while \p function runs, including by \p function itself, are left for
+		 * the next call.
+		 *
+		 * \returns The number of elements consumed.
+		 */
+		template<typename F>
+		size_t ConsumeAll(F&& function) {
+			size_t end = enqueuePosition.load(std::memory_order_acquire);
+			size_t numConsumed = 0;
+
+			// Stops early at a cell a producer has claimed but not yet written
+			while (dequeuePosition != end && TryConsume(function)) {
+				numConsumed++;
+			}
+
+			return numConsumed;
+		}
+
+		size_t GetCapacity(void) const {
+			return capacity;
+		}
+
+		/*! \returns Whether the queue was empty at some point during the call. Only for the consumer thread. */
+		bool IsEmpty(void) const {
+			return enqueuePosition.load(std::memory_order_acquire) == dequeuePosition;
+		}
+
+	private:
+		struct Cell {
+			std::atomic<size_t> sequence;
+			typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+		};
+
+		template<typename F>
+		bool TryConsume(F& function) {
+			Cell& cell = cells[dequeuePosition & (capacity - 1)];
+			size_t sequence = cell.sequence.load(std::memory_order_acquire);
+
+			if ((intptr_t) sequence - (intptr_t) (dequeuePosition + 1) < 0) {
+				return false;
+			}
+
+			T* element = std::launder(reinterpret_cast<T*>(&cell.storage));
+
+			// Frees the cell even if function throws, so the element isn't consumed twice
+			struct CellRelease {
+				~CellRelease() {
+					element->~T();
+					cell.sequence.store(position + capacity, std::memory_order_release);
+				}
+
+				T* element;
+				Cell& cell;
+				size_t position;
+				size_t capacity;
+			} release { element, cell, dequeuePosition, capacity };
+
+			dequeuePosition++;
+			function(*element);
+			return true;
+		}
+
+		static size_t RoundUpToPowerOfTwo(size_t value) {
+			size_t result = 2;
+
+			while (result < value) {
+				result <<= 1;
+			}
+
+			return result;
+		}
+
+		const size_t capacity;
+		std::unique_ptr<Cell[]> cells;
+
+		//! Kept on separate cache lines so producers and the consumer don't contend
+		alignas(64) std::atomic<size_t> enqueuePosition;
+		alignas(64) size_t dequeuePosition;
+	};
+}
+
+#endif /* __ice_fairy_mpsc_queue_h__ */
@@ -0,0 +1,172 @@
+#include "threadpool.h"
+
+#include <algorithm>
+
+using namespace IceFairy;
+
+namespace {
+	thread_local const ThreadPool* currentPool = nullptr;
+	thread_local int currentWorkerIndex = -1;
+}
+
+ThreadPool::ThreadPool(unsigned int numWorkers) :
+	pendingTasks(0),
+	stopping(false) {
+	// One queue per worker, plus a shared queue for batches started from outside the pool
+	for (unsigned int i = 0; i < numWorkers + 1; i++) {
+		queues.push_back(std::make_unique<WorkQueue>());
+	}
+
+	for (unsigned int i = 0; i < numWorkers; i++) {
+		workers.emplace_back(&ThreadPool::WorkerLoop, this, i);
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(wakeMutex);
+		stopping = true;
+	}
+	wakeCondition.notify_all();
+
+	for (auto& worker : workers) {
+		worker.join();
+	}
+}
+
+void ThreadPool::ParallelFor(size_t count, size_t chunkSize, const RangeJob& job) {
+	if (count == 0) {
+		return;
+	}
+
+	if (chunkSize == 0) {
+		chunkSize = 1;
+	}
+
+	size_t numChunks = (count + chunkSize - 1) / chunkSize;
+
+	if (workers.empty() || numChunks == 1) {
+		for (size_t begin = 0; begin < count; begin += chunkSize) {
+			job(begin, std::min(begin + chunkSize, count));
+		}
+		return;
+	}
+
+	unsigned int owner = currentPool == this ? (unsigned int) currentWorkerIndex : (unsigned int) workers.size();
+
+	Batch batch;
+	batch.remaining = numChunks;
+
+	pendingTasks += numChunks;
+	{
+		std::lock_guard<std::mutex> lock(queues[owner]->mutex);
+		for (size_t begin = 0; begin < count; begin += chunkSize) {
+			queues[owner]->tasks.push_back(Task { &job, &batch, begin, std::min(begin + chunkSize, count) });
+		}
+	}
+	{
+		// Workers test pendingTasks under this mutex, taking it here means none can miss the notify
+		std::lock_guard<std::mutex> lock(wakeMutex);
+	}
+	wakeCondition.notify_all();
+
+	// Help out rather than block, this also keeps nested ParallelFor calls from deadlocking
+	while (batch.remaining.load(std::memory_order_acquire) > 0) {
+		Task task;
+
+		if (PopTask(owner, task) || StealTask(owner, task)) {
+			RunTask(task);
+		}
+		else {
+			std::this_thread::yield();
+		}
+	}
+
+	if (batch.exception) {
+		std::rethrow_exception(batch.exception);
+	}
+}
+
+unsigned int ThreadPool::GetNumWorkers(void) const {
+	return (unsigned int) workers.size();
+}
+
+int ThreadPool::GetCurrentWorkerIndex(void) {
+	return currentWorkerIndex;
+}
+
+const ThreadPool* ThreadPool::GetCurrentPool(void) {
+	return currentPool;
+}
+
+unsigned int ThreadPool::GetDefaultWorkerCount(void) {
+	unsigned int hardwareThreads = std::thread::hardware_concurrency();
+	return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+}
+
+void ThreadPool::WorkerLoop(unsigned int index) {
+	currentPool = this;
+	currentWorkerIndex = (int) index;
+
+	while (true) {
+		Task task;
+
+		if (PopTask(index, task) || StealTask(index, task)) {
+			RunTask(task);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(wakeMutex);
+		wakeCondition.wait(lock, [this] { return stopping || pendingTasks.load() > 0; });
+
+		if (stopping && pendingTasks.load() == 0) {
+			return;
+		}
+	}
+}
+
+bool ThreadPool::PopTask(unsigned int index, Task& task) {
+	std::lock_guard<std::mutex> lock(queues[index]->mutex);
+
+	if (queues[index]->tasks.empty()) {
+		return false;
+	}
+
+	task = queues[index]->tasks.back();
+	queues[index]->tasks.pop_back();
+	pendingTasks--;
+
+	return true;
+}
+
+bool ThreadPool::StealTask(unsigned int index, Task& task) {
+	for (size_t i = 1; i < queues.size(); i++) {
+		auto& queue = queues[(index + i) % queues.size()];
+		std::lock_guard<std::mutex> lock(queue->mutex);
+
+		if (!queue->tasks.empty()) {
+			task = queue->tasks.front();
+			queue->tasks.pop_front();
+			pendingTasks--;
+
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void ThreadPool::RunTask(Task& task) {
+	try {
+		(*task.job)(task.begin, task.end);
+	}
+	catch (...) {
+		std::lock_guard<std::mutex> lock(task.batch->exceptionMutex);
+		if (!task.batch->exception) {
+			task.batch->exception = std::current_exception();
+		}
+	}
+
+	// Must be the last access to the batch, the caller may return as soon as this hits 0
+	task.batch->remaining.fetch_sub(1, std::memory_order_release);
+}
@@ -0,0 +1,95 @@
+#ifndef __ice_fairy_thread_pool_h__
+#define __ice_fairy_thread_pool_h__
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+#include <memory>
+
+namespace IceFairy {
+	/*! \brief Work-stealing thread pool for splitting loops across cores.
+	 *
+	 * Every worker owns a queue. Workers pop from the back of their own queue and, when it runs
+	 * dry, steal from the front of the other workers' queues. The thread calling \ref ParallelFor
+	 * helps out until its batch is finished, so a pool with no workers simply runs the batch
+	 * serially on the calling thread.
+	 *
+	 * Sample usage:
+	 * \code{.cpp}
+	 * IceFairy::ThreadPool pool(4);
+	 * pool.ParallelFor(positions.size(), 256, [&](size_t begin, size_t end) {
+	 *     for (size_t i = begin; i < end; i++) positions[i] += velocities[i];
+	 * });
+	 * \endcode
+	 */
+	class ThreadPool {
+	public:
+		typedef std::function<void(size_t begin, size_t end)> RangeJob;
+
+		/*! \brief Creates the pool.
+		 *
+		 * \param numWorkers The number of worker threads to spawn. 0 runs everything on the calling thread.
+		 */
+		ThreadPool(unsigned int numWorkers = GetDefaultWorkerCount());
+		~ThreadPool();
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool& operator=(const ThreadPool&) = delete;
+
+		/*! \brief Runs \p job over [0, \p count) split into chunks of \p chunkSize and waits for it to finish.
+		 *
+		 * If any chunk throws, the first exception is rethrown on the calling thread once every
+		 * chunk has finished.
+		 */
+		void ParallelFor(size_t count, size_t chunkSize, const RangeJob& job);
+
+		/*! \returns The number of worker threads, not counting the calling thread. */
+		unsigned int GetNumWorkers(void) const;
+
+		/*! \returns The index of the worker running the current thread, or -1 if it isn't a worker. */
+		static int GetCurrentWorkerIndex(void);
+		/*! \returns The pool the current thread is a worker of, or nullptr if it isn't a worker. */
+		static const ThreadPool* GetCurrentPool(void);
+		/*! \returns One less than the number of hardware threads, as the calling thread also does work. */
+		static unsigned int GetDefaultWorkerCount(void);
+
+	private:
+		struct Batch {
+			std::atomic<size_t> remaining;
+			std::mutex exceptionMutex;
+			std::exception_ptr exception;
+		};
+
+		struct Task {
+			const RangeJob* job;
+			Batch* batch;
+			size_t begin;
+			size_t end;
+		};
+
+		struct WorkQueue {
+			std::mutex mutex;
+			std::deque<Task> tasks;
+		};
+
+		void WorkerLoop(unsigned int index);
+		bool PopTask(unsigned int index, Task& task);
+		bool StealTask(unsigned int index, Task& task);
+		void RunTask(Task& task);
+
+		std::vector<std::unique_ptr<WorkQueue>> queues;
+		std::vector<std::thread> workers;
+
+		std::mutex wakeMutex;
+		std::condition_variable wakeCondition;
+		std::atomic<size_t> pendingTasks;
+		bool stopping;
+	};
+}
+
+#endif /* __ice_fairy_thread_pool_h__ */
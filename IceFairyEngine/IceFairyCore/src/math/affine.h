@@ -0,0 +1,265 @@
+#ifndef __ice_fairy_affine_h__
+#define __ice_fairy_affine_h__
+
+#include <string>
+#include <sstream>
+
+#include "vector.h"
+#include "matrix.h"
+#include "quaternion.h"
+
+namespace IceFairy {
+	// Affine transform (rotation, scale, shear and translation) stored as the top three rows
+	// of a 4x4 matrix, the bottom row always being (0, 0, 0, 1). Products and inverses skip
+	// all the work on that row, and the inverse only needs the 3x3 linear part inverting.
+	// Use Matrix4::IsAffine to check whether a matrix can be held as one.
+	// Sample usage:
+	//		Affine3f model = Affine3f::Translate(1, 2, 3) * Affine3f::Rotate(90.0f, 0, 1, 0);
+	//		Affine3f view = Affine3f(camera.GetViewMatrix()).Inverse();
+	//		Matrix4f mvp = projection * (view * model).ToMatrix4();
+	template <class T>
+	class Affine3 {
+	public:
+		// Creates the identity transform.
+		constexpr Affine3()
+			: v() {
+			v[0] = v[4] = v[8] = 1;
+		}
+
+		// Takes the top three rows of an affine matrix, the bottom row is dropped.
+		explicit constexpr Affine3(const Matrix4<T>& m)
+			: v() {
+			for (int i = 0; i < 4; i++) {
+				for (int j = 0; j < 3; j++) {
+					Val(i, j) = m.Val(i, j);
+				}
+			}
+		}
+
+		constexpr Affine3(
+			T a1, T a2, T a3, T a4,
+			T b1, T b2, T b3, T b4,
+			T c1, T c2, T c3, T c4
+		) : v() {
+			v[0] = a1;
+			v[1] = b1;
+			v[2] = c1;
+
+			v[3] = a2;
+			v[4] = b2;
+			v[5] = c2;
+
+			v[6] = a3;
+			v[7] = b3;
+			v[8] = c3;
+
+			v[9] = a4;
+			v[10] = b4;
+			v[11] = c4;
+		}
+
+		// Returns the identity transform.
+		static constexpr Affine3 Identity(void) {
+			return Affine3();
+		}
+
+		// Returns a scale transform given by the parameters x, y and z.
+		static constexpr Affine3 Scale(T x, T y, T z) {
+			Affine3 a;
+
+			a.Val(0, 0) = x;
+			a.Val(1, 1) = y;
+			a.Val(2, 2) = z;
+
+			return a;
+		}
+
+		// Returns a translation transform given by the parameters x, y and z.
+		static constexpr Affine3 Translate(T x, T y, T z) {
+			Affine3 a;
+
+			a.Val(3, 0) = x;
+			a.Val(3, 1) = y;
+			a.Val(3, 2) = z;
+
+			return a;
+		}
+
+		// Returns a rotation transform, as Matrix4::Rotate.
+		static Affine3 Rotate(T degrees, T x, T y, T z) {
+			return Affine3(Matrix4<T>::Rotate(degrees, x, y, z));
+		}
+
+		// Returns a scale transform given by a vector.
+		static constexpr Affine3 Scale(const Vector3<T>& scale) {
+			return Affine3::Scale(scale.x, scale.y, scale.z);
+		}
+
+		// Returns a translation transform given by a vector.
+		static constexpr Affine3 Translate(const Vector3<T>& translate) {
+			return Affine3::Translate(translate.x, translate.y, translate.z);
+		}
+
+		// Returns a rotation transform, similar to above but using a Vector3 axis in place of
+		// x, y, z parameters.
+		static Affine3 Rotate(T degrees, const Vector3<T>& rotate) {
+			return Affine3::Rotate(degrees, rotate.x, rotate.y, rotate.z);
+		}
+
+		// Returns a rotation transform using a unit quaternion.
+		static constexpr Affine3 Rotate(const Quaternion<T>& rotation) {
+			return Affine3(rotation.ToMatrix4());
+		}
+
+		// Returns the inverse of this transform.
+		// Throws MatrixNoInverseExistsException if the transform flattens space, e.g. a 0 scale.
+		constexpr Affine3 Inverse(void) const {
+			T a00 = Val(0, 0), a01 = Val(1, 0), a02 = Val(2, 0);
+			T a10 = Val(0, 1), a11 = Val(1, 1), a12 = Val(2, 1);
+			T a20 = Val(0, 2), a21 = Val(1, 2), a22 = Val(2, 2);
+
+			T c00 = a11 * a22 - a12 * a21;
+			T c01 = a12 * a20 - a10 * a22;
+			T c02 = a10 * a21 - a11 * a20;
+			T det = a00 * c00 + a01 * c01 + a02 * c02;
+
+			if (det == 0) {
+				throw MatrixNoInverseExistsException();
+			}
+
+			T invDet = 1 / det;
+
+			return FromLinear(
+				c00 * invDet, (a02 * a21 - a01 * a22) * invDet, (a01 * a12 - a02 * a11) * invDet,
+				c01 * invDet, (a00 * a22 - a02 * a20) * invDet, (a02 * a10 - a00 * a12) * invDet,
+				c02 * invDet, (a01 * a20 - a00 * a21) * invDet, (a00 * a11 - a01 * a10) * invDet);
+		}
+
+		// Returns the inverse of a rigid transform, one made only of rotations and translations,
+		// by transposing the rotation. The result is wrong for anything scaled or sheared.
+		constexpr Affine3 RigidInverse(void) const {
+			return FromLinear(
+				Val(0, 0), Val(0, 1), Val(0, 2),
+				Val(1, 0), Val(1, 1), Val(1, 2),
+				Val(2, 0), Val(2, 1), Val(2, 2));
+		}
+
+		// Returns the point p moved by this transform.
+		constexpr Vector3<T> TransformPoint(const Vector3<T>& p) const {
+			return TransformDirection(p) + GetTranslation();
+		}
+
+		// Returns the direction d moved by this transform, ignoring translation.
+		constexpr Vector3<T> TransformDirection(const Vector3<T>& d) const {
+			return Vector3<T>(
+				Val(0, 0) * d.x + Val(1, 0) * d.y + Val(2, 0) * d.z,
+				Val(0, 1) * d.x + Val(1, 1) * d.y + Val(2, 1) * d.z,
+				Val(0, 2) * d.x + Val(1, 2) * d.y + Val(2, 2) * d.z);
+		}
+
+		constexpr Vector3<T> GetTranslation(void) const {
+			return Vector3<T>(Val(3, 0), Val(3, 1), Val(3, 2));
+		}
+
+		// Returns this transform as a full 4x4 matrix.
+		constexpr Matrix4<T> ToMatrix4(void) const {
+			Matrix4<T> m;
+
+			for (int i = 0; i < 4; i++) {
+				for (int j = 0; j < 3; j++) {
+					m.Val(i, j) = Val(i, j);
+				}
+			}
+			m.Val(3, 3) = 1;
+
+			return m;
+		}
+
+		// Returns the value at a point in the matrix e.g (1, 2), with the same column then row
+		// order as Matrix4. Rows only go up to 2.
+		constexpr const T& Val(int x, int y) const {
+			return v[x * 3 + y];
+		}
+
+		constexpr T& Val(int x, int y) {
+			return v[x * 3 + y];
+		}
+
+		// Returns a string representation of this transform for debugging.
+		std::string Str(void) const {
+			std::stringstream out;
+
+			for (int i = 0; i < 3; i++) {
+				for (int j = 0; j < 4; j++) {
+					out << Val(j, i) << ", ";
+				}
+				out << '\n';
+			}
+
+			return out.str();
+		}
+
+		constexpr Vector4<T> operator*(const Vector4<T>& rhs) const {
+			Vector3<T> xyz = TransformDirection(Vector3<T>(rhs.x, rhs.y, rhs.z)) + GetTranslation() * rhs.w;
+			return Vector4<T>(xyz, rhs.w);
+		}
+
+		constexpr Affine3 operator*=(const Affine3& rhs) {
+			*this = *this * rhs;
+			return *this;
+		}
+
+		constexpr bool operator==(const Affine3& other) const {
+			for (int i = 0; i < 12; i++) {
+				if (v[i] != other.v[i]) {
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		constexpr bool operator!=(const Affine3& other) const {
+			return !(*this == other);
+		}
+
+		T v[12];
+
+	private:
+		// Returns the transform with the given (row by row) linear part, and the translation
+		// that undoes this transform's translation after it.
+		constexpr Affine3 FromLinear(T a00, T a01, T a02, T a10, T a11, T a12, T a20, T a21, T a22) const {
+			T x = Val(3, 0), y = Val(3, 1), z = Val(3, 2);
+
+			return Affine3(
+				a00, a01, a02, -(a00 * x + a01 * y + a02 * z),
+				a10, a11, a12, -(a10 * x + a11 * y + a12 * z),
+				a20, a21, a22, -(a20 * x + a21 * y + a22 * z));
+		}
+	};
+
+	// Returns the transform of rhs followed by lhs, as with matrices.
+	template <class T>
+	constexpr Affine3<T> operator*(const Affine3<T>& lhs, const Affine3<T>& rhs) {
+		Affine3<T> a;
+
+		for (int i = 0; i < 4; i++) {
+			for (int j = 0; j < 3; j++) {
+				T sum = i == 3 ? lhs.Val(3, j) : 0;
+
+				for (int k = 0; k < 3; k++) {
+					sum += lhs.Val(k, j) * rhs.Val(i, k);
+				}
+
+				a.Val(i, j) = sum;
+			}
+		}
+
+		return a;
+	}
+
+	typedef Affine3<float>  Affine3f;
+	typedef Affine3<double> Affine3d;
+}
+
+#endif /* __ice_fairy_affine_h__ */
@@ -0,0 +1,337 @@
+#ifndef __ice_fairy_batch_h__
+#define __ice_fairy_batch_h__
+
+#include <cstddef>
+#include <math.h>
+
+#include "vector.h"
+#include "matrix.h"
+#include "simd.h"
+
+namespace IceFairy {
+	// Bulk operations on arrays of float vectors and matrices, for code such as skinning,
+	// particles and culling that would otherwise go through Matrix4 one vector at a time.
+	// Every function takes either packed (AoS) arrays of Vector3f/Vector4f or separate
+	// component (SoA) arrays, and works through them Simd::LANE_COUNT elements at a time, with
+	// the remainder done in scalar code. Outputs may be the same arrays as the inputs.
+	// Sample usage:
+	//		Batch::TransformPoints(modelMatrix, particles.data(), worldPositions.data(), particles.size());
+	namespace Batch {
+		static_assert(sizeof(Vector3f) == 3 * sizeof(float), "Vector3f must be packed to be batched");
+		static_assert(sizeof(Vector4f) == 4 * sizeof(float), "Vector4f must be packed to be batched");
+
+		// Separate x, y and z arrays, each 'count' long.
+		struct Vector3fSoA {
+			float* x;
+			float* y;
+			float* z;
+		};
+
+		struct ConstVector3fSoA {
+			ConstVector3fSoA(const float* x, const float* y, const float* z)
+				: x(x),
+				y(y),
+				z(z) {
+			}
+
+			ConstVector3fSoA(const Vector3fSoA& other)
+				: x(other.x),
+				y(other.y),
+				z(other.z) {
+			}
+
+			const float* x;
+			const float* y;
+			const float* z;
+		};
+
+		// Separate x, y, z and w arrays, each 'count' long.
+		struct Vector4fSoA {
+			float* x;
+			float* y;
+			float* z;
+			float* w;
+		};
+
+		struct ConstVector4fSoA {
+			ConstVector4fSoA(const float* x, const float* y, const float* z, const float* w)
+				: x(x),
+				y(y),
+				z(z),
+				w(w) {
+			}
+
+			ConstVector4fSoA(const Vector4fSoA& other)
+				: x(other.x),
+				y(other.y),
+				z(other.z),
+				w(other.w) {
+			}
+
+			const float* x;
+			const float* y;
+			const float* z;
+			const float* w;
+		};
+
+		namespace Detail {
+			// Multiplies (x, y, z, w) by the column-major matrix m in the same order as
+			// Matrix4::operator*, so the scalar remainder matches the SIMD lanes.
+			inline void Transform(const float* m, float x, float y, float z, float w, float* out) {
+				for (int i = 0; i < 4; i++) {
+					out[i] = m[i] * x + m[4 + i] * y + m[8 + i] * z + m[12 + i] * w;
+				}
+			}
+
+			inline void Transform3(const float* m, float x, float y, float z, float w, float* out) {
+				for (int i = 0; i < 3; i++) {
+					out[i] = m[i] * x + m[4 + i] * y + m[8 + i] * z + m[12 + i] * w;
+				}
+			}
+
+#if defined(ICE_FAIRY_SIMD_LANES)
+			// A matrix with every element splatted across its own register.
+			struct MatrixLanes {
+				MatrixLanes(const Matrix4f& m) {
+					for (int i = 0; i < 16; i++) {
+						v[i] = Simd::Splat(m.v[i]);
+					}
+				}
+
+				// Component 'row' of the matrix times (x, y, z, w).
+				Simd::Lanes Row(int row, Simd::Lanes x, Simd::Lanes y, Simd::Lanes z, Simd::Lanes w) const {
+					Simd::Lanes sum = Simd::Mul(v[row], x);
+					sum = Simd::Add(sum, Simd::Mul(v[4 + row], y));
+					sum = Simd::Add(sum, Simd::Mul(v[8 + row], z));
+					return Simd::Add(sum, Simd::Mul(v[12 + row], w));
+				}
+
+				Simd::Lanes v[16];
+			};
+
+			inline Simd::Lanes Dot(Simd::Lanes ax, Simd::Lanes ay, Simd::Lanes az, Simd::Lanes bx, Simd::Lanes by, Simd::Lanes bz) {
+				Simd::Lanes sum = Simd::Mul(ax, bx);
+				sum = Simd::Add(sum, Simd::Mul(ay, by));
+				return Simd::Add(sum, Simd::Mul(az, bz));
+			}
+#endif
+
+			inline void TransformVector3(const Matrix4f& matrix, float w, const Vector3f* in, Vector3f* out, size_t count) {
+				const float* source = reinterpret_cast<const float*>(in);
+				float* destination = reinterpret_cast<float*>(out);
+				size_t i = 0;
+
+#if defined(ICE_FAIRY_SIMD_LANES)
+				MatrixLanes m(matrix);
+				Simd::Lanes lw = Simd::Splat(w);
+
+				for (; i + Simd::LANE_COUNT <= count; i += Simd::LANE_COUNT) {
+					Simd::Lanes x, y, z;
+					Simd::LoadVector3(source + i * 3, x, y, z);
+					Simd::StoreVector3(destination + i * 3, m.Row(0, x, y, z, lw), m.Row(1, x, y, z, lw), m.Row(2, x, y, z, lw));
+				}
+#endif
+
+				for (; i < count; i++) {
+					float result[3];
+					Transform3(matrix.v, source[i * 3], source[i * 3 + 1], source[i * 3 + 2], w, result);
+					destination[i * 3] = result[0];
+					destination[i * 3 + 1] = result[1];
+					destination[i * 3 + 2] = result[2];
+				}
+			}
+
+			inline void TransformVector3(const Matrix4f& matrix, float w, ConstVector3fSoA in, Vector3fSoA out, size_t count) {
+				size_t i = 0;
+
+#if defined(ICE_FAIRY_SIMD_LANES)
+				MatrixLanes m(matrix);
+				Simd::Lanes lw = Simd::Splat(w);
+
+				for (; i + Simd::LANE_COUNT <= count; i += Simd::LANE_COUNT) {
+					Simd::Lanes x = Simd::Load(in.x + i);
+					Simd::Lanes y = Simd::Load(in.y + i);
+					Simd::Lanes z = Simd::Load(in.z + i);
+					Simd::Store(out.x + i, m.Row(0, x, y, z, lw));
+					Simd::Store(out.y + i, m.Row(1, x, y, z, lw));
+					Simd::Store(out.z + i, m.Row(2, x, y, z, lw));
+				}
+#endif
+
+				for (; i < count; i++) {
+					float result[3];
+					Transform3(matrix.v, in.x[i], in.y[i], in.z[i], w, result);
+					out.x[i] = result[0];
+					out.y[i] = result[1];
+					out.z[i] = result[2];
+				}
+			}
+		}
+
+		// out[i] = matrix * (in[i], 1), i.e. the points moved by the matrix's translation.
+		inline void TransformPoints(const Matrix4f& matrix, const Vector3f* in, Vector3f* out, size_t count) {
+			Detail::TransformVector3(matrix, 1.0f, in, out, count);
+		}
+
+		inline void TransformPoints(const Matrix4f& matrix, ConstVector3fSoA in, Vector3fSoA out, size_t count) {
+			Detail::TransformVector3(matrix, 1.0f, in, out, count);
+		}
+
+		// out[i] = matrix * (in[i], 0), ignoring translation, as Matrix4::operator*(Vector3) does.
+		inline void TransformDirections(const Matrix4f& matrix, const Vector3f* in, Vector3f* out, size_t count) {
+			Detail::TransformVector3(matrix, 0.0f, in, out, count);
+		}
+
+		inline void TransformDirections(const Matrix4f& matrix, ConstVector3fSoA in, Vector3fSoA out, size_t count) {
+			Detail::TransformVector3(matrix, 0.0f, in, out, count);
+		}
+
+		// out[i] = matrix * in[i]
+		inline void Transform(const Matrix4f& matrix, const Vector4f* in, Vector4f* out, size_t count) {
+			const float* source = reinterpret_cast<const float*>(in);
+			float* destination = reinterpret_cast<float*>(out);
+			size_t i = 0;
+
+#if defined(ICE_FAIRY_SIMD_LANES)
+			Detail::MatrixLanes m(matrix);
+
+			for (; i + Simd::LANE_COUNT <= count; i += Simd::LANE_COUNT) {
+				Simd::Lanes x, y, z, w;
+				Simd::LoadVector4(source + i * 4, x, y, z, w);
+				Simd::StoreVector4(destination + i * 4, m.Row(0, x, y, z, w), m.Row(1, x, y, z, w), m.Row(2, x, y, z, w), m.Row(3, x, y, z, w));
+			}
+#endif
+
+			for (; i < count; i++) {
+				float result[4];
+				Detail::Transform(matrix.v, source[i * 4], source[i * 4 + 1], source[i * 4 + 2], source[i * 4 + 3], result);
+				for (int j = 0; j < 4; j++) {
+					destination[i * 4 + j] = result[j];
+				}
+			}
+		}
+
+		inline void Transform(const Matrix4f& matrix, ConstVector4fSoA in, Vector4fSoA out, size_t count) {
+			size_t i = 0;
+
+#if defined(ICE_FAIRY_SIMD_LANES)
+			Detail::MatrixLanes m(matrix);
+
+			for (; i + Simd::LANE_COUNT <= count; i += Simd::LANE_COUNT) {
+				Simd::Lanes x = Simd::Load(in.x + i);
+				Simd::Lanes y = Simd::Load(in.y + i);
+				Simd::Lanes z = Simd::Load(in.z + i);
+				Simd::Lanes w = Simd::Load(in.w + i);
+				Simd::Store(out.x + i, m.Row(0, x, y, z, w));
+				Simd::Store(out.y + i, m.Row(1, x, y, z, w));
+				Simd::Store(out.z + i, m.Row(2, x, y, z, w));
+				Simd::Store(out.w + i, m.Row(3, x, y, z, w));
+			}
+#endif
+
+			for (; i < count; i++) {
+				float result[4];
+				Detail::Transform(matrix.v, in.x[i], in.y[i], in.z[i], in.w[i], result);
+				out.x[i] = result[0];
+				out.y[i] = result[1];
+				out.z[i] = result[2];
+				out.w[i] = result[3];
+			}
+		}
+
+		// out[i] = lhs[i] * rhs[i]. Each product is a single SIMD kernel call, so this mostly
+		// saves the per-call copies of Matrix4's operators.
+		inline void Multiply(const Matrix4f* lhs, const Matrix4f* rhs, Matrix4f* out, size_t count) {
+			for (size_t i = 0; i < count; i++) {
+#if defined(ICE_FAIRY_SIMD)
+				Simd::MultiplyMatrix4(lhs[i].v, rhs[i].v, out[i].v);
+#else
+				out[i] = lhs[i] * rhs[i];
+#endif
+			}
+		}
+
+		// out[i] = a[i].Dot(b[i])
+		inline void Dot(const Vector3f* a, const Vector3f* b, float* out, size_t count) {
+			const float* lhs = reinterpret_cast<const float*>(a);
+			const float* rhs = reinterpret_cast<const float*>(b);
+			size_t i = 0;
+
+#if defined(ICE_FAIRY_SIMD_LANES)
+			for (; i + Simd::LANE_COUNT <= count; i += Simd::LANE_COUNT) {
+				Simd::Lanes ax, ay, az, bx, by, bz;
+				Simd::LoadVector3(lhs + i * 3, ax, ay, az);
+				Simd::LoadVector3(rhs + i * 3, bx, by, bz);
+				Simd::Store(out + i, Detail::Dot(ax, ay, az, bx, by, bz));
+			}
+#endif
+
+			for (; i < count; i++) {
+				out[i] = a[i].Dot(b[i]);
+			}
+		}
+
+		inline void Dot(ConstVector3fSoA a, ConstVector3fSoA b, float* out, size_t count) {
+			size_t i = 0;
+
+#if defined(ICE_FAIRY_SIMD_LANES)
+			for (; i + Simd::LANE_COUNT <= count; i += Simd::LANE_COUNT) {
+				Simd::Store(out + i, Detail::Dot(
+					Simd::Load(a.x + i), Simd::Load(a.y + i), Simd::Load(a.z + i),
+					Simd::Load(b.x + i), Simd::Load(b.y + i), Simd::Load(b.z + i)));
+			}
+#endif
+
+			for (; i < count; i++) {
+				out[i] = a.x[i] * b.x[i] + a.y[i] * b.y[i] + a.z[i] * b.z[i];
+			}
+		}
+
+		// out[i] = in[i] normalised. Zero vectors are left as zero, like Vector3::Normalise.
+		inline void Normalise(const Vector3f* in, Vector3f* out, size_t count) {
+			const float* source = reinterpret_cast<const float*>(in);
+			float* destination = reinterpret_cast<float*>(out);
+			size_t i = 0;
+
+#if defined(ICE_FAIRY_SIMD_LANES)
+			for (; i + Simd::LANE_COUNT <= count; i += Simd::LANE_COUNT) {
+				Simd::Lanes x, y, z;
+				Simd::LoadVector3(source + i * 3, x, y, z);
+				Simd::Lanes length = Simd::Sqrt(Detail::Dot(x, y, z, x, y, z));
+				Simd::StoreVector3(destination + i * 3, Simd::DivNonZero(x, length), Simd::DivNonZero(y, length), Simd::DivNonZero(z, length));
+			}
+#endif
+
+			for (; i < count; i++) {
+				Vector3f v = in[i];
+				out[i] = v.Normalise();
+			}
+		}
+
+		inline void Normalise(ConstVector3fSoA in, Vector3fSoA out, size_t count) {
+			size_t i = 0;
+
+#if defined(ICE_FAIRY_SIMD_LANES)
+			for (; i + Simd::LANE_COUNT <= count; i += Simd::LANE_COUNT) {
+				Simd::Lanes x = Simd::Load(in.x + i);
+				Simd::Lanes y = Simd::Load(in.y + i);
+				Simd::Lanes z = Simd::Load(in.z + i);
+				Simd::Lanes length = Simd::Sqrt(Detail::Dot(x, y, z, x, y, z));
+				Simd::Store(out.x + i, Simd::DivNonZero(x, length));
+				Simd::Store(out.y + i, Simd::DivNonZero(y, length));
+				Simd::Store(out.z + i, Simd::DivNonZero(z, length));
+			}
+#endif
+
+			for (; i < count; i++) {
+				Vector3f v(in.x[i], in.y[i], in.z[i]);
+				v.Normalise();
+				out.x[i] = v.x;
+				out.y[i] = v.y;
+				out.z[i] = v.z;
+			}
+		}
+	}
+}
+
+#endif /* __ice_fairy_batch_h__ */
@@ -27,49 +27,40 @@ namespace IceFairy {
 	public:
 		T r, g, b;
 
-		Colour3()
+		constexpr Colour3()
 			: r(0),
 			g(0),
 			b(0) {
 		}
 
-		Colour3(T r, T g, T b)
+		constexpr Colour3(T r, T g, T b)
 			: r(r),
 			g(g),
 			b(b) {
 		}
 
-		Colour3 operator*(float scale) {
+		constexpr Colour3 operator*(float scale) const {
 			return Colour3(r * scale, g * scale, b * scale);
 		}
 
-		Colour3 operator*(const Colour3& other) {
+		constexpr Colour3 operator*(const Colour3& other) const {
 			return Colour3(r * other.r, g * other.g, b * other.b);
 		}
 
-		Colour3 operator+(const Colour3& other) {
+		constexpr Colour3 operator+(const Colour3& other) const {
 			return Colour3(r + other.r, g + other.g, b + other.b);
 		}
 
-		Colour3 operator=(const Colour3& other) {
-			if (this != &other) {
-				r = other.r;
-				g = other.g;
-				b = other.b;
-			}
-			return *this;
-		}
-
-		bool operator==(const Colour3& other) {
+		constexpr bool operator==(const Colour3& other) const {
 			return r == other.r && g == other.g && b == other.b;
 		}
 
-		bool operator!=(const Colour3& other) {
+		constexpr bool operator!=(const Colour3& other) const {
 			return !(*this == other);
 		}
 
 		// Returns the colour at the value interpolated between another colour.
-		Colour3 Interpolate(Colour3 other, T t) {
+		constexpr Colour3 Interpolate(Colour3 other, T t) const {
 			if (t >= 1) return other;
 			else if (t <= 0) return *this;
 			else return (*this * (1 - t)) + (other * t);
@@ -124,7 +115,7 @@ namespace IceFairy {
 	typedef Colour3<double> Colour3d;
 
 	template <class T>
-	bool operator==(const Colour3<T>& lhs, const Colour3<T>& rhs) {
+	constexpr bool operator==(const Colour3<T>& lhs, const Colour3<T>& rhs) {
 		return lhs.r == rhs.r && lhs.g == rhs.g && lhs.b == rhs.b;
 	}
 
@@ -139,70 +130,60 @@ namespace IceFairy {
 	public:
 		T r, g, b, a;
 
-		Colour4()
+		constexpr Colour4()
 			: r(1),
 			g(1),
 			b(1),
 			a(1) {
 		}
 
-		Colour4(Colour3<T> c, T alpha)
+		constexpr Colour4(Colour3<T> c, T alpha)
 			: r(c.r),
 			g(c.g),
 			b(c.b),
 			a(alpha) {
 		}
 
-		Colour4(T r, T g, T b)
+		constexpr Colour4(T r, T g, T b)
 			: r(r),
 			g(g),
 			b(b),
 			a(1) {
 		}
 
-		Colour4(T r, T g, T b, T a)
+		constexpr Colour4(T r, T g, T b, T a)
 			: r(r),
 			g(g),
 			b(b),
 			a(a) {
 		}
 
-		Colour4 operator*(T scale) {
+		constexpr Colour4 operator*(T scale) const {
 			return Colour4(r * scale, g * scale, b * scale, a * scale);
 		}
 
-		Colour4 operator*(const Colour4& other) {
+		constexpr Colour4 operator*(const Colour4& other) const {
 			return Colour4(r * other.r, g * other.g, b * other.b, a * other.a);
 		}
 
-		Colour4 operator+(const Colour4& other) {
+		constexpr Colour4 operator+(const Colour4& other) const {
 			return Colour4(r + other.r, g + other.g, b + other.b, a + other.a);
 		}
 
-		Colour4 operator=(const Colour4& other) {
-			if (this != &other) {
-				r = other.r;
-				g = other.g;
-				b = other.b;
-				a = other.a;
-			}
-			return *this;
-		}
-
-		bool operator==(const Colour4& other) {
+		constexpr bool operator==(const Colour4& other) const {
 			return r == other.r && g == other.g && b == other.b && a == other.a;
 		}
 
-		bool operator!=(const Colour4& other) {
+		constexpr bool operator!=(const Colour4& other) const {
 			return !(*this == other);
 		}
 
-		Colour3<T> ToColour3(void) {
+		constexpr Colour3<T> ToColour3(void) const {
 			return Colour3<T>(r, g, b);
 		}
 
 		// Returns the colour at the value interpolated between another colour.
-		Colour4 Interpolate(Colour4 other, T t) {
+		constexpr Colour4 Interpolate(Colour4 other, T t) const {
 			if (t >= 1) return other;
 			else if (t <= 0) return *this;
 			else return (*this * (1 - t)) + (other * t);
@@ -214,7 +195,7 @@ namespace IceFairy {
 	typedef Colour4<double> Colour4d;
 
 	template <class T>
-	bool operator==(const Colour4<T>& lhs, const Colour4<T>& rhs) {
+	constexpr bool operator==(const Colour4<T>& lhs, const Colour4<T>& rhs) {
 		return lhs.r == rhs.r && lhs.g == rhs.g && lhs.b == rhs.b && lhs.a == rhs.a;
 	}
 }
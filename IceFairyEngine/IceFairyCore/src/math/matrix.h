@@ -6,13 +6,18 @@
 #include <string>
 #include <sstream>
 #include <math.h>
+#include <type_traits>
 
 #include "vector.h"
+#include "simd.h"
 #include "../core/utilities/icexception.h"
 
 // TODO: Move to a separate github and use glm instead (makes sense right?)
 
 namespace IceFairy {
+	template<class T>
+	class Quaternion;
+
 	class MatrixNoInverseExistsException : public ICException {
 	public:
 		MatrixNoInverseExistsException()
@@ -29,19 +34,20 @@ namespace IceFairy {
 	class Matrix3 {
 	public:
 		// Creates a 3x3 0'd matrix
-		Matrix3() {
-			for (int i = 0; i < 9; i++) v[i] = 0.0f;
+		constexpr Matrix3()
+			: v() {
 		}
 
-		Matrix3(const T vals[9]) {
+		constexpr Matrix3(const T vals[9])
+			: v() {
 			for (int i = 0; i < 9; i++) v[i] = vals[i];
 		}
 
-		Matrix3(
+		constexpr Matrix3(
 			T a1, T a2, T a3,
 			T b1, T b2, T b3,
 			T c1, T c2, T c3
-		) {
+		) : v() {
 			v[0] = a1;
 			v[1] = a2;
 			v[2] = a3;
@@ -54,14 +60,14 @@ namespace IceFairy {
 		}
 
 		// Returns the 3x3 identity matrix.
-		static Matrix3 Identity(void) {
+		static constexpr Matrix3 Identity(void) {
 			Matrix3 m;
 			m.Val(0, 0) = m.Val(1, 1) = m.Val(2, 2) = 1.0f;
 			return m;
 		}
 
 		// Returns the inverse of this matrix.
-		Matrix3 Inverse(void) {
+		constexpr Matrix3 Inverse(void) const {
 			T det = Val(0, 0) * (Val(1, 1) * Val(2, 2) - Val(2, 1) * Val(1, 2)) -
 				Val(0, 1) * (Val(1, 0) * Val(2, 2) - Val(1, 2) * Val(2, 0)) +
 				Val(0, 2) * (Val(1, 0) * Val(2, 1) - Val(1, 1) * Val(2, 0));
@@ -87,7 +93,7 @@ namespace IceFairy {
 		}
 
 		// Returns the transpose of this index.
-		Matrix3 Transpose(void) {
+		constexpr Matrix3 Transpose(void) const {
 			Matrix3 m;
 
 			for (int i = 0; i < 3; i++) {
@@ -102,7 +108,7 @@ namespace IceFairy {
 
 		// Returns the dot product of this matrixes row given by rowIndex
 		// with a vector 'v'.
-		T Dot(int rowIndex, Vector3<T> v) {
+		constexpr T Dot(int rowIndex, Vector3<T> v) const {
 			T finalVal = 0;
 
 			for (int i = 0; i < 3; i++)
@@ -112,11 +118,11 @@ namespace IceFairy {
 		}
 
 		// Returns the value at a point in the matrix e.g (1, 2)
-		const T& Val(int x, int y) const {
+		constexpr const T& Val(int x, int y) const {
 			return v[y * 3 + x];
 		}
 
-		T& Val(int x, int y) {
+		constexpr T& Val(int x, int y) {
 			return v[y * 3 + x];
 		}
 
@@ -134,15 +140,7 @@ namespace IceFairy {
 			return out.str();
 		}
 
-		Matrix3 operator=(const Matrix3& rhs) {
-			if (this != &rhs) {
-				for (int i = 0; i < 9; i++) v[i] = rhs.v[i];
-			}
-
-			return *this;
-		}
-
-		Matrix3 operator+(const Matrix3& rhs) {
+		constexpr Matrix3 operator+(const Matrix3& rhs) const {
 			Matrix3 m;
 
 			for (int i = 0; i < 9; i++) {
@@ -152,7 +150,7 @@ namespace IceFairy {
 			return m;
 		}
 
-		Vector3<T> operator*(const Vector3<T>& rhs) {
+		constexpr Vector3<T> operator*(const Vector3<T>& rhs) const {
 			Vector3<T> product;
 
 			product.x = Val(0, 0) * rhs.x + Val(1, 0) * rhs.y + Val(2, 0) * rhs.z;
@@ -162,7 +160,7 @@ namespace IceFairy {
 			return product;
 		}
 
-		T operator[](unsigned int i) {
+		constexpr T operator[](unsigned int i) const {
 			return v[i];
 		}
 
@@ -170,7 +168,7 @@ namespace IceFairy {
 	};
 
 	template <class T>
-	Matrix3<T> operator*(const Matrix3<T>& lhs, const Matrix3<T>& rhs) {
+	constexpr Matrix3<T> operator*(const Matrix3<T>& lhs, const Matrix3<T>& rhs) {
 		Matrix3<T> m;
 
 		for (int i = 0; i < 3; i++) {
@@ -206,20 +204,21 @@ namespace IceFairy {
 	class Matrix4 {
 	public:
 		// Create a 4x4 0'd matrix
-		Matrix4() {
-			for (int i = 0; i < 16; i++) v[i] = 0.0f;
+		constexpr Matrix4()
+			: v() {
 		}
 
-		Matrix4(const T vals[16]) {
+		constexpr Matrix4(const T vals[16])
+			: v() {
 			for (int i = 0; i < 16; i++) v[i] = vals[i];
 		}
 
-		Matrix4(
+		constexpr Matrix4(
 			T a1, T a2, T a3, T a4,
 			T b1, T b2, T b3, T b4,
 			T c1, T c2, T c3, T c4,
 			T d1, T d2, T d3, T d4
-		) {
+		) : v() {
 			v[0] = a1;
 			v[1] = b1;
 			v[2] = c1;
@@ -242,14 +241,14 @@ namespace IceFairy {
 		}
 
 		// Returns the 4x4 identity matrix.
-		static Matrix4 Identity(void) {
+		static constexpr Matrix4 Identity(void) {
 			Matrix4 m;
 			m.Val(0, 0) = m.Val(1, 1) = m.Val(2, 2) = m.Val(3, 3) = 1.0f;
 			return m;
 		}
 
 		// Returns the orthogrpahic projection matrix given by the listed parameters.
-		static Matrix4<float> Ortho(float l, float r, float b, float t, float n, float f) {
+		static constexpr Matrix4<float> Ortho(float l, float r, float b, float t, float n, float f) {
 			return Matrix4<float>(
 				2 / (r - l), 0.0f, 0.0f, -(r + l) / (r - l),
 				0.0f, 2.0f / (t - b), 0.0f, -(t + b) / (t - b),
@@ -258,7 +257,7 @@ namespace IceFairy {
 		}
 
 		// Returns the frustum projection matrix given by the listed parameters.
-		static Matrix4<float> Frustum(float left, float right, float bottom, float top, float n, float f) {
+		static constexpr Matrix4<float> Frustum(float left, float right, float bottom, float top, float n, float f) {
 			Matrix4<float> m;
 
 			m.Val(0, 0) = (2.0f * n) / (right - left);
@@ -374,7 +373,7 @@ namespace IceFairy {
 		}
 
 		// Returns a scale transformation matrix given by the parameters x, y and z.
-		static Matrix4 Scale(T x, T y, T z) {
+		static constexpr Matrix4 Scale(T x, T y, T z) {
 			Matrix4 m = Identity();
 
 			m.Val(0, 0) = x;
@@ -385,7 +384,7 @@ namespace IceFairy {
 		}
 
 		// Returns a translation transformation matrix given by the parameters x, y and z.
-		static Matrix4 Translate(T x, T y, T z) {
+		static constexpr Matrix4 Translate(T x, T y, T z) {
 			Matrix4 m = Identity();
 
 			m.Val(3, 0) = x;
@@ -421,12 +420,12 @@ namespace IceFairy {
 		}
 
 		// Returns a scale transformation matrix given by a vector.
-		static Matrix4 Scale(const Vector3<T>& scale) {
+		static constexpr Matrix4 Scale(const Vector3<T>& scale) {
 			return Matrix4::Scale(scale.x, scale.y, scale.z);
 		}
 
 		// Returns a translation transformation matrix given by a vector.
-		static Matrix4 Translate(const Vector3<T>& translate) {
+		static constexpr Matrix4 Translate(const Vector3<T>& translate) {
 			return Matrix4::Translate(translate.x, translate.y, translate.z);
 		}
 
@@ -436,13 +435,36 @@ namespace IceFairy {
 			return Matrix4::Rotate(degrees, rotate.x, rotate.y, rotate.z);
 		}
 
-		// Returns a rotation transformation matrix using a quaternion.
-		// TODO
-		//static Matrix4 QuarternionRotate(btQuaternion& quaternion);
+		// Returns a rotation transformation matrix using a quaternion, see quaternion.h.
+		static constexpr Matrix4 Rotate(const Quaternion<T>& rotation) {
+			return rotation.ToMatrix4();
+		}
+
+		// Returns whether the bottom row is (0, 0, 0, 1), i.e. this is a rotation, scale, shear or
+		// translation with no projection. Affine matrices can be held as an Affine3, which
+		// multiplies and inverts in far fewer operations, see affine.h.
+		constexpr bool IsAffine(void) const {
+			return Val(0, 3) == 0 && Val(1, 3) == 0 && Val(2, 3) == 0 && Val(3, 3) == 1;
+		}
 
 		// Returns the inverse of this matrix.
-		Matrix4 Inverse(void) {
-			T inv[16], invOut[16], det;
+		constexpr Matrix4 Inverse(void) const {
+#if defined(ICE_FAIRY_SIMD_INVERSE)
+			if constexpr (std::is_same<T, float>::value) {
+				if (!ICE_FAIRY_IS_CONSTANT_EVALUATED()) {
+					Matrix4 m;
+
+					if (!Simd::InverseMatrix4(v, m.v)) {
+						throw MatrixNoInverseExistsException();
+					}
+
+					return m;
+				}
+			}
+#endif
+
+			T inv[16] = {}, invOut[16] = {};
+			T det = 0;
 
 			inv[0] = v[5] * v[10] * v[15] -
 				v[5] * v[11] * v[14] -
@@ -571,7 +593,7 @@ namespace IceFairy {
 		}
 
 		// Returns the transpose of this matrix.
-		Matrix4 Transpose(void) {
+		constexpr Matrix4 Transpose(void) const {
 			Matrix4 m;
 
 			for (int i = 0; i < 4; i++) {
@@ -586,7 +608,7 @@ namespace IceFairy {
 
 		// Returns the dot product of this matrixes row given by rowIndex
 		// with a vector 'v'.
-		T Dot(int rowIndex, const Vector4<T>& v) {
+		constexpr T Dot(int rowIndex, const Vector4<T>& v) const {
 			T finalVal = 0.0f;
 
 			for (int i = 0; i < 4; i++)
@@ -596,11 +618,11 @@ namespace IceFairy {
 		}
 
 		// Returns the value at a point in the matrix e.g (1, 2)
-		const T& Val(int x, int y) const {
+		constexpr const T& Val(int x, int y) const {
 			return v[x * 4 + y];
 		}
 
-		T& Val(int x, int y) {
+		constexpr T& Val(int x, int y) {
 			return v[x * 4 + y];
 		}
 
@@ -622,19 +644,12 @@ namespace IceFairy {
 			return out.str();
 		}
 
-		Matrix4 operator=(const Matrix4& rhs) {
-			if (this != &rhs) {
-				for (int i = 0; i < 16; i++) v[i] = rhs.v[i];
-			}
-			return *this;
-		}
-
-		Matrix4 operator*=(const Matrix4& rhs) {
+		constexpr Matrix4 operator*=(const Matrix4& rhs) {
 			*this = *this * rhs;
 			return *this;
 		}
 
-		Matrix4 operator+(const Matrix4& rhs) {
+		constexpr Matrix4 operator+(const Matrix4& rhs) const {
 			Matrix4 m;
 
 			for (int i = 0; i < 16; i++) {
@@ -651,7 +666,7 @@ namespace IceFairy {
 			return *this;
 		}
 
-		Vector3<T> operator*(const Vector3<T>& rhs) {
+		constexpr Vector3<T> operator*(const Vector3<T>& rhs) const {
 			Vector3<T> product;
 
 			product.x = Val(0, 0) * rhs.x + Val(1, 0) * rhs.y + Val(2, 0) * rhs.z;
@@ -661,7 +676,7 @@ namespace IceFairy {
 			return product;
 		}
 
-		Vector4<T> operator*(const Vector4<T>& rhs) {
+		constexpr Vector4<T> operator*(const Vector4<T>& rhs) const {
 			T x = Val(0, 0) * rhs[0] + Val(1, 0) * rhs[1] + Val(2, 0) * rhs[2] + Val(3, 0) * rhs[3];
 			T y = Val(0, 1) * rhs[0] + Val(1, 1) * rhs[1] + Val(2, 1) * rhs[2] + Val(3, 1) * rhs[3];
 			T z = Val(0, 2) * rhs[0] + Val(1, 2) * rhs[1] + Val(2, 2) * rhs[2] + Val(3, 2) * rhs[3];
@@ -670,7 +685,7 @@ namespace IceFairy {
 			return Vector4<T>(x, y, z, w);
 		}
 
-		T operator[](unsigned int i) {
+		constexpr T operator[](unsigned int i) const {
 			return v[i];
 		}
 
@@ -678,7 +693,7 @@ namespace IceFairy {
 	};
 
 	template <class T>
-	Matrix4<T> operator*(const Matrix4<T>& lhs, const Matrix4<T>& rhs) {
+	constexpr Matrix4<T> operator*(const Matrix4<T>& lhs, const Matrix4<T>& rhs) {
 		Matrix4<T> m;
 
 		for (int i = 0; i < 4; i++) {
@@ -692,6 +707,20 @@ namespace IceFairy {
 		return m;
 	}
 
+#if defined(ICE_FAIRY_SIMD)
+	// Float matrices are multiplied a column at a time with SIMD instead, outside of
+	// constant expressions.
+	inline ICE_FAIRY_SIMD_CONSTEXPR Matrix4<float> operator*(const Matrix4<float>& lhs, const Matrix4<float>& rhs) {
+		if (ICE_FAIRY_IS_CONSTANT_EVALUATED()) {
+			return operator*<float>(lhs, rhs);
+		}
+
+		Matrix4<float> m;
+		Simd::MultiplyMatrix4(lhs.v, rhs.v, m.v);
+		return m;
+	}
+#endif
+
 	template <class T>
 	Matrix4<T> operator==(const Matrix4<T>& lhs, const Matrix4<T>& rhs) {
 		for (unsigned int i = 0; i < 16; i++) {
@@ -0,0 +1,277 @@
+#ifndef __ice_fairy_quaternion_h__
+#define __ice_fairy_quaternion_h__
+
+#include <string>
+#include <sstream>
+#include <math.h>
+
+#include "vector.h"
+#include "matrix.h"
+#include "simd.h"
+
+namespace IceFairy {
+	// Rotation stored as a quaternion (x, y, z, w), for composing and blending rotations
+	// without building a matrix for each one. Rotations turn the same way as Matrix4::Rotate,
+	// so either can be swapped for the other.
+	// Sample usage:
+	//		Quaternionf q = Quaternionf::AxisAngle(90.0f, 1, 0, 0) * Quaternionf::AxisAngle(45.0f, 0, 1, 0);
+	//		Matrix4f m = q.ToMatrix4();
+	//		Quaternionf halfway = Quaternionf::Slerp(Quaternionf::Identity(), q, 0.5f);
+	template <class T>
+	class Quaternion {
+	public:
+		// Creates the identity rotation.
+		constexpr Quaternion()
+			: x(0),
+			y(0),
+			z(0),
+			w(1) {
+		}
+
+		constexpr Quaternion(T x, T y, T z, T w)
+			: x(x),
+			y(y),
+			z(z),
+			w(w) {
+		}
+
+		constexpr Quaternion(const Vector3<T>& xyz, T w)
+			: x(xyz.x),
+			y(xyz.y),
+			z(xyz.z),
+			w(w) {
+		}
+
+		// Returns the identity rotation.
+		static constexpr Quaternion Identity(void) {
+			return Quaternion();
+		}
+
+		// Returns a rotation of 'degrees' around the unit axis (x, y, z).
+		// Example, rotate around the y axis by 90 degrees:
+		//		Quaternionf rot = Quaternionf::AxisAngle(90.0f, 0, 1, 0);
+		static Quaternion AxisAngle(T degrees, T x, T y, T z) {
+			// Matrix4::Rotate turns clockwise looking down the axis, hence the negated angle
+			T halfRadians = -degrees * (T) (M_PI / 360.0);
+			T s = sin(halfRadians);
+
+			return Quaternion(x * s, y * s, z * s, cos(halfRadians));
+		}
+
+		// Returns a rotation, similar to above but using a Vector3 axis.
+		static Quaternion AxisAngle(T degrees, const Vector3<T>& axis) {
+			return Quaternion::AxisAngle(degrees, axis.x, axis.y, axis.z);
+		}
+
+		// Returns the rotation of a pure rotation matrix.
+		static Quaternion FromMatrix(const Matrix3<T>& m) {
+			return FromRotation(
+				m.Val(0, 0), m.Val(1, 0), m.Val(2, 0),
+				m.Val(0, 1), m.Val(1, 1), m.Val(2, 1),
+				m.Val(0, 2), m.Val(1, 2), m.Val(2, 2));
+		}
+
+		// Returns the rotation of the upper 3x3 of a matrix, which must be a pure rotation.
+		// Any translation is ignored.
+		static Quaternion FromMatrix(const Matrix4<T>& m) {
+			return FromRotation(
+				m.Val(0, 0), m.Val(1, 0), m.Val(2, 0),
+				m.Val(0, 1), m.Val(1, 1), m.Val(2, 1),
+				m.Val(0, 2), m.Val(1, 2), m.Val(2, 2));
+		}
+
+		// Returns the normalised linear interpolation between two rotations at 't'. Much
+		// cheaper than Slerp, at the cost of a slightly uneven speed through the blend.
+		static Quaternion Nlerp(const Quaternion& a, const Quaternion& b, T t) {
+			// Take the shortest way round
+			Quaternion end = a.Dot(b) < 0 ? -b : b;
+			Quaternion q = a * (1 - t) + end * t;
+
+			return q.Normalise();
+		}
+
+		// Returns the spherical linear interpolation between two unit rotations at 't', turning
+		// at a constant speed.
+		static Quaternion Slerp(const Quaternion& a, const Quaternion& b, T t) {
+			T cosTheta = a.Dot(b);
+			Quaternion end = b;
+
+			if (cosTheta < 0) {
+				end = -b;
+				cosTheta = -cosTheta;
+			}
+
+			// sin(theta) tends to 0 for nearly equal rotations, where Nlerp is just as accurate
+			if (cosTheta > (T) 0.9995) {
+				return Nlerp(a, end, t);
+			}
+
+			T theta = acos(cosTheta);
+			T sinTheta = sin(theta);
+
+			return a * (sin((1 - t) * theta) / sinTheta) + end * (sin(t * theta) / sinTheta);
+		}
+
+		// Returns the dot product of this quaternion and another.
+		constexpr T Dot(const Quaternion& other) const {
+			return x * other.x + y * other.y + z * other.z + w * other.w;
+		}
+
+		// Returns the length of this quaternion, 1 for any rotation.
+		T Length(void) const {
+			return std::sqrt(Dot(*this));
+		}
+
+		// Returns the normalised version of this quaternion (while normalising this
+		// quaternion itself).
+		Quaternion Normalise(void) {
+			T length = Length();
+
+			if (length != 0) {
+				*this = *this * (1 / length);
+			}
+
+			return *this;
+		}
+
+		// Returns the conjugate of this quaternion, which for a unit quaternion is the
+		// opposite rotation.
+		constexpr Quaternion Conjugate(void) const {
+			return Quaternion(-x, -y, -z, w);
+		}
+
+		// Returns the inverse of this quaternion.
+		constexpr Quaternion Inverse(void) const {
+			return Conjugate() * (1 / Dot(*this));
+		}
+
+		// Returns the vector v rotated by this unit quaternion.
+		constexpr Vector3<T> Rotate(const Vector3<T>& v) const {
+			// v + 2w(q x v) + 2q x (q x v), without building the quaternion products
+			Vector3<T> q(x, y, z);
+			Vector3<T> t = q.Cross(v) * (T) 2;
+
+			return v + t * w + q.Cross(t);
+		}
+
+		// Returns the rotation matrix of this unit quaternion.
+		constexpr Matrix3<T> ToMatrix3(void) const {
+			T xx = x * x, yy = y * y, zz = z * z;
+			T xy = x * y, xz = x * z, yz = y * z;
+			T wx = w * x, wy = w * y, wz = w * z;
+
+			return Matrix3<T>(
+				1 - 2 * (yy + zz), 2 * (xy - wz), 2 * (xz + wy),
+				2 * (xy + wz), 1 - 2 * (xx + zz), 2 * (yz - wx),
+				2 * (xz - wy), 2 * (yz + wx), 1 - 2 * (xx + yy));
+		}
+
+		// Returns the rotation transformation matrix of this unit quaternion.
+		constexpr Matrix4<T> ToMatrix4(void) const {
+			Matrix3<T> r = ToMatrix3();
+
+			return Matrix4<T>(
+				r.Val(0, 0), r.Val(1, 0), r.Val(2, 0), 0,
+				r.Val(0, 1), r.Val(1, 1), r.Val(2, 1), 0,
+				r.Val(0, 2), r.Val(1, 2), r.Val(2, 2), 0,
+				0, 0, 0, 1);
+		}
+
+		// Returns the string format of this quaternion for easy debugging.
+		// Format: Quaternion(0, 0, 0, 1)
+		std::string Str(void) const {
+			std::stringstream out;
+			out << "Quaternion(" << x << ", " << y << ", " << z << ", " << w << ")";
+			return out.str();
+		}
+
+		constexpr Quaternion operator*(const T scale) const {
+			return Quaternion(x * scale, y * scale, z * scale, w * scale);
+		}
+
+		constexpr Quaternion operator+(const Quaternion& other) const {
+			return Quaternion(x + other.x, y + other.y, z + other.z, w + other.w);
+		}
+
+		constexpr Quaternion operator-(void) const {
+			return Quaternion(-x, -y, -z, -w);
+		}
+
+		// Returns the vector rotated by this quaternion, as Rotate.
+		constexpr Vector3<T> operator*(const Vector3<T>& rhs) const {
+			return Rotate(rhs);
+		}
+
+		constexpr Quaternion operator*=(const Quaternion& rhs) {
+			*this = *this * rhs;
+			return *this;
+		}
+
+		constexpr bool operator==(const Quaternion& other) const {
+			return x == other.x && y == other.y && z == other.z && w == other.w;
+		}
+
+		constexpr bool operator!=(const Quaternion& other) const {
+			return !(*this == other);
+		}
+
+		T x;
+		T y;
+		T z;
+		T w;
+
+	private:
+		// Shepperd's method, taking the square root of whichever of w, x, y or z is largest so
+		// the divisions stay well conditioned. r<row><column>.
+		static Quaternion FromRotation(T r00, T r01, T r02, T r10, T r11, T r12, T r20, T r21, T r22) {
+			T trace = r00 + r11 + r22;
+
+			if (trace > 0) {
+				T s = std::sqrt(trace + 1) * 2;
+				return Quaternion((r21 - r12) / s, (r02 - r20) / s, (r10 - r01) / s, s / 4);
+			}
+			else if (r00 > r11 && r00 > r22) {
+				T s = std::sqrt(1 + r00 - r11 - r22) * 2;
+				return Quaternion(s / 4, (r01 + r10) / s, (r02 + r20) / s, (r21 - r12) / s);
+			}
+			else if (r11 > r22) {
+				T s = std::sqrt(1 + r11 - r00 - r22) * 2;
+				return Quaternion((r01 + r10) / s, s / 4, (r12 + r21) / s, (r02 - r20) / s);
+			}
+			else {
+				T s = std::sqrt(1 + r22 - r00 - r11) * 2;
+				return Quaternion((r02 + r20) / s, (r12 + r21) / s, s / 4, (r10 - r01) / s);
+			}
+		}
+	};
+
+	// Returns the rotation of rhs followed by lhs, as with matrices.
+	template <class T>
+	constexpr Quaternion<T> operator*(const Quaternion<T>& lhs, const Quaternion<T>& rhs) {
+		return Quaternion<T>(
+			lhs.w * rhs.x + lhs.x * rhs.w + lhs.y * rhs.z - lhs.z * rhs.y,
+			lhs.w * rhs.y - lhs.x * rhs.z + lhs.y * rhs.w + lhs.z * rhs.x,
+			lhs.w * rhs.z + lhs.x * rhs.y - lhs.y * rhs.x + lhs.z * rhs.w,
+			lhs.w * rhs.w - lhs.x * rhs.x - lhs.y * rhs.y - lhs.z * rhs.z);
+	}
+
+	typedef Quaternion<float>  Quaternionf;
+	typedef Quaternion<double> Quaterniond;
+
+#if defined(ICE_FAIRY_SIMD)
+	static_assert(sizeof(Quaternionf) == 4 * sizeof(float), "Quaternionf must be packed for SIMD");
+
+	// Float quaternions are multiplied with SIMD instead, outside of constant expressions.
+	inline ICE_FAIRY_SIMD_CONSTEXPR Quaternion<float> operator*(const Quaternion<float>& lhs, const Quaternion<float>& rhs) {
+		if (ICE_FAIRY_IS_CONSTANT_EVALUATED()) {
+			return operator*<float>(lhs, rhs);
+		}
+
+		Quaternion<float> q;
+		Simd::MultiplyQuaternion(&lhs.x, &rhs.x, &q.x);
+		return q;
+	}
+#endif
+}
+
+#endif /* __ice_fairy_quaternion_h__ */
@@ -0,0 +1,417 @@
+#ifndef __ice_fairy_simd_h__
+#define __ice_fairy_simd_h__
+
+#include <cstddef>
+
+// Picks the SIMD instruction set the math kernels are built with. Define ICE_FAIRY_NO_SIMD to
+// force the scalar fallbacks, e.g. to compare results against them.
+#ifndef ICE_FAIRY_NO_SIMD
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ICE_FAIRY_SIMD_SSE
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#if defined(__AVX__)
+#define ICE_FAIRY_SIMD_AVX
+#include <immintrin.h>
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define ICE_FAIRY_SIMD_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+#if defined(ICE_FAIRY_SIMD_SSE) || defined(ICE_FAIRY_SIMD_NEON)
+#define ICE_FAIRY_SIMD
+#endif
+
+// Intrinsics can't run in constant expressions, so constexpr code checks this before taking a
+// SIMD path. Compilers without the builtin can't tell, so the SIMD paths aren't constexpr there.
+#if defined(__clang__)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define ICE_FAIRY_HAS_IS_CONSTANT_EVALUATED
+#endif
+#elif (defined(__GNUC__) && __GNUC__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+#define ICE_FAIRY_HAS_IS_CONSTANT_EVALUATED
+#endif
+
+#if defined(ICE_FAIRY_HAS_IS_CONSTANT_EVALUATED)
+#define ICE_FAIRY_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#define ICE_FAIRY_SIMD_CONSTEXPR constexpr
+#else
+#define ICE_FAIRY_IS_CONSTANT_EVALUATED() false
+#define ICE_FAIRY_SIMD_CONSTEXPR
+#endif
+
+namespace IceFairy {
+	// 4x4 float matrix kernels, on the column-major layout of Matrix4, and the lane operations
+	// the batch kernels are written in. Each group is only available when its macro is defined,
+	// callers fall back to scalar code otherwise.
+	namespace Simd {
+#if defined(ICE_FAIRY_SIMD)
+		// out = lhs * rhs. Every column of the result is the columns of lhs weighted by the
+		// matching column of rhs. out may alias lhs or rhs.
+		inline void MultiplyMatrix4(const float* lhs, const float* rhs, float* out) {
+#if defined(ICE_FAIRY_SIMD_AVX)
+			// Each half of a register holds the same lhs column, so two result columns are
+			// built at once
+			__m256 c0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs));
+			__m256 c1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs + 4));
+			__m256 c2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs + 8));
+			__m256 c3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs + 12));
+			__m256 result[2];
+
+			for (int j = 0; j < 2; j++) {
+				const float* r = rhs + j * 8;
+				__m256 sum = _mm256_mul_ps(c0, _mm256_setr_ps(r[0], r[0], r[0], r[0], r[4], r[4], r[4], r[4]));
+				sum = _mm256_add_ps(sum, _mm256_mul_ps(c1, _mm256_setr_ps(r[1], r[1], r[1], r[1], r[5], r[5], r[5], r[5])));
+				sum = _mm256_add_ps(sum, _mm256_mul_ps(c2, _mm256_setr_ps(r[2], r[2], r[2], r[2], r[6], r[6], r[6], r[6])));
+				sum = _mm256_add_ps(sum, _mm256_mul_ps(c3, _mm256_setr_ps(r[3], r[3], r[3], r[3], r[7], r[7], r[7], r[7])));
+				result[j] = sum;
+			}
+
+			_mm256_storeu_ps(out, result[0]);
+			_mm256_storeu_ps(out + 8, result[1]);
+#elif defined(ICE_FAIRY_SIMD_SSE)
+			__m128 c0 = _mm_loadu_ps(lhs);
+			__m128 c1 = _mm_loadu_ps(lhs + 4);
+			__m128 c2 = _mm_loadu_ps(lhs + 8);
+			__m128 c3 = _mm_loadu_ps(lhs + 12);
+			__m128 result[4];
+
+			for (int j = 0; j < 4; j++) {
+				const float* r = rhs + j * 4;
+				__m128 sum = _mm_mul_ps(c0, _mm_set1_ps(r[0]));
+				sum = _mm_add_ps(sum, _mm_mul_ps(c1, _mm_set1_ps(r[1])));
+				sum = _mm_add_ps(sum, _mm_mul_ps(c2, _mm_set1_ps(r[2])));
+				sum = _mm_add_ps(sum, _mm_mul_ps(c3, _mm_set1_ps(r[3])));
+				result[j] = sum;
+			}
+
+			for (int j = 0; j < 4; j++) {
+				_mm_storeu_ps(out + j * 4, result[j]);
+			}
+#elif defined(ICE_FAIRY_SIMD_NEON)
+			float32x4_t c0 = vld1q_f32(lhs);
+			float32x4_t c1 = vld1q_f32(lhs + 4);
+			float32x4_t c2 = vld1q_f32(lhs + 8);
+			float32x4_t c3 = vld1q_f32(lhs + 12);
+			float32x4_t result[4];
+
+			for (int j = 0; j < 4; j++) {
+				const float* r = rhs + j * 4;
+				float32x4_t sum = vmulq_n_f32(c0, r[0]);
+				sum = vmlaq_n_f32(sum, c1, r[1]);
+				sum = vmlaq_n_f32(sum, c2, r[2]);
+				sum = vmlaq_n_f32(sum, c3, r[3]);
+				result[j] = sum;
+			}
+
+			for (int j = 0; j < 4; j++) {
+				vst1q_f32(out + j * 4, result[j]);
+			}
+#endif
+		}
+#endif
+
+#if defined(ICE_FAIRY_SIMD)
+		// out = lhs * rhs for quaternions stored x, y, z, w. Every lane of the result sums each
+		// component of lhs times rhs shuffled and sign-flipped to match. out may alias lhs or rhs.
+		inline void MultiplyQuaternion(const float* lhs, const float* rhs, float* out) {
+#if defined(ICE_FAIRY_SIMD_SSE)
+			__m128 b = _mm_loadu_ps(rhs);
+			__m128 wzyx = _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(0, 1, 2, 3)), _mm_setr_ps(0.0f, -0.0f, 0.0f, -0.0f));
+			__m128 zwxy = _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 3, 2)), _mm_setr_ps(0.0f, 0.0f, -0.0f, -0.0f));
+			__m128 yxwz = _mm_xor_ps(_mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 0, 1)), _mm_setr_ps(-0.0f, 0.0f, 0.0f, -0.0f));
+
+			__m128 result = _mm_mul_ps(_mm_set1_ps(lhs[3]), b);
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(lhs[0]), wzyx));
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(lhs[1]), zwxy));
+			result = _mm_add_ps(result, _mm_mul_ps(_mm_set1_ps(lhs[2]), yxwz));
+
+			_mm_storeu_ps(out, result);
+#elif defined(ICE_FAIRY_SIMD_NEON)
+			static const float wzyxSigns[4] = { 1.0f, -1.0f, 1.0f, -1.0f };
+			static const float zwxySigns[4] = { 1.0f, 1.0f, -1.0f, -1.0f };
+			static const float yxwzSigns[4] = { -1.0f, 1.0f, 1.0f, -1.0f };
+
+			float32x4_t b = vld1q_f32(rhs);
+			float32x4_t zwxy = vextq_f32(b, b, 2);
+			float32x4_t wzyx = vmulq_f32(vrev64q_f32(zwxy), vld1q_f32(wzyxSigns));
+			float32x4_t yxwz = vmulq_f32(vrev64q_f32(b), vld1q_f32(yxwzSigns));
+			zwxy = vmulq_f32(zwxy, vld1q_f32(zwxySigns));
+
+			float32x4_t result = vmulq_n_f32(b, lhs[3]);
+			result = vmlaq_n_f32(result, wzyx, lhs[0]);
+			result = vmlaq_n_f32(result, zwxy, lhs[1]);
+			result = vmlaq_n_f32(result, yxwz, lhs[2]);
+
+			vst1q_f32(out, result);
+#endif
+		}
+#endif
+
+#if defined(ICE_FAIRY_SIMD_SSE)
+#define ICE_FAIRY_SIMD_INVERSE
+		// Writes the inverse of m to out by Cramer's rule, four cofactors at a time. Returns false,
+		// leaving out untouched, if m has no inverse. The transpose of an inverse is the inverse of
+		// the transpose, so this works on either storage order.
+		inline bool InverseMatrix4(const float* m, float* out) {
+			__m128 zero = _mm_setzero_ps();
+			__m128 minor0, minor1, minor2, minor3;
+			__m128 row0, row1, row2, row3;
+			__m128 det, tmp;
+
+			// Transpose while loading, with rows 1 and 3 rotated by two lanes
+			tmp = _mm_loadh_pi(_mm_loadl_pi(zero, reinterpret_cast<const __m64*>(m)), reinterpret_cast<const __m64*>(m + 4));
+			row1 = _mm_loadh_pi(_mm_loadl_pi(zero, reinterpret_cast<const __m64*>(m + 8)), reinterpret_cast<const __m64*>(m + 12));
+			row0 = _mm_shuffle_ps(tmp, row1, 0x88);
+			row1 = _mm_shuffle_ps(row1, tmp, 0xDD);
+			tmp = _mm_loadh_pi(_mm_loadl_pi(zero, reinterpret_cast<const __m64*>(m + 2)), reinterpret_cast<const __m64*>(m + 6));
+			row3 = _mm_loadh_pi(_mm_loadl_pi(zero, reinterpret_cast<const __m64*>(m + 10)), reinterpret_cast<const __m64*>(m + 14));
+			row2 = _mm_shuffle_ps(tmp, row3, 0x88);
+			row3 = _mm_shuffle_ps(row3, tmp, 0xDD);
+
+			tmp = _mm_mul_ps(row2, row3);
+			tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+			minor0 = _mm_mul_ps(row1, tmp);
+			minor1 = _mm_mul_ps(row0, tmp);
+			tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+			minor0 = _mm_sub_ps(_mm_mul_ps(row1, tmp), minor0);
+			minor1 = _mm_sub_ps(_mm_mul_ps(row0, tmp), minor1);
+			minor1 = _mm_shuffle_ps(minor1, minor1, 0x4E);
+
+			tmp = _mm_mul_ps(row1, row2);
+			tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+			minor0 = _mm_add_ps(_mm_mul_ps(row3, tmp), minor0);
+			minor3 = _mm_mul_ps(row0, tmp);
+			tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+			minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row3, tmp));
+			minor3 = _mm_sub_ps(_mm_mul_ps(row0, tmp), minor3);
+			minor3 = _mm_shuffle_ps(minor3, minor3, 0x4E);
+
+			tmp = _mm_mul_ps(_mm_shuffle_ps(row1, row1, 0x4E), row3);
+			tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+			row2 = _mm_shuffle_ps(row2, row2, 0x4E);
+			minor0 = _mm_add_ps(_mm_mul_ps(row2, tmp), minor0);
+			minor2 = _mm_mul_ps(row0, tmp);
+			tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+			minor0 = _mm_sub_ps(minor0, _mm_mul_ps(row2, tmp));
+			minor2 = _mm_sub_ps(_mm_mul_ps(row0, tmp), minor2);
+			minor2 = _mm_shuffle_ps(minor2, minor2, 0x4E);
+
+			tmp = _mm_mul_ps(row0, row1);
+			tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+			minor2 = _mm_add_ps(_mm_mul_ps(row3, tmp), minor2);
+			minor3 = _mm_sub_ps(_mm_mul_ps(row2, tmp), minor3);
+			tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+			minor2 = _mm_sub_ps(_mm_mul_ps(row3, tmp), minor2);
+			minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row2, tmp));
+
+			tmp = _mm_mul_ps(row0, row3);
+			tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+			minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row2, tmp));
+			minor2 = _mm_add_ps(_mm_mul_ps(row1, tmp), minor2);
+			tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+			minor1 = _mm_add_ps(_mm_mul_ps(row2, tmp), minor1);
+			minor2 = _mm_sub_ps(minor2, _mm_mul_ps(row1, tmp));
+
+			tmp = _mm_mul_ps(row0, row2);
+			tmp = _mm_shuffle_ps(tmp, tmp, 0xB1);
+			minor1 = _mm_add_ps(_mm_mul_ps(row3, tmp), minor1);
+			minor3 = _mm_sub_ps(minor3, _mm_mul_ps(row1, tmp));
+			tmp = _mm_shuffle_ps(tmp, tmp, 0x4E);
+			minor1 = _mm_sub_ps(minor1, _mm_mul_ps(row3, tmp));
+			minor3 = _mm_add_ps(_mm_mul_ps(row1, tmp), minor3);
+
+			// The determinant is the first row dotted with its cofactors
+			det = _mm_mul_ps(row0, minor0);
+			det = _mm_add_ps(_mm_shuffle_ps(det, det, 0x4E), det);
+			det = _mm_add_ss(_mm_shuffle_ps(det, det, 0xB1), det);
+
+			if (_mm_cvtss_f32(det) == 0.0f) {
+				return false;
+			}
+
+			// A full divide rather than _mm_rcp_ps, to match the scalar path's precision
+			det = _mm_div_ss(_mm_set_ss(1.0f), det);
+			det = _mm_shuffle_ps(det, det, 0x00);
+
+			_mm_storeu_ps(out, _mm_mul_ps(det, minor0));
+			_mm_storeu_ps(out + 4, _mm_mul_ps(det, minor1));
+			_mm_storeu_ps(out + 8, _mm_mul_ps(det, minor2));
+			_mm_storeu_ps(out + 12, _mm_mul_ps(det, minor3));
+
+			return true;
+		}
+#endif
+
+#if defined(ICE_FAIRY_SIMD_SSE) || (defined(ICE_FAIRY_SIMD_NEON) && (defined(__aarch64__) || defined(_M_ARM64)))
+#define ICE_FAIRY_SIMD_LANES
+		// A register of floats, worked on one lane per element of a batch. 8 wide under AVX,
+		// 4 wide otherwise. NEON needs AArch64 for its divide and square root.
+#if defined(ICE_FAIRY_SIMD_AVX)
+		typedef __m256 Lanes;
+		const size_t LANE_COUNT = 8;
+#elif defined(ICE_FAIRY_SIMD_SSE)
+		typedef __m128 Lanes;
+		const size_t LANE_COUNT = 4;
+#else
+		typedef float32x4_t Lanes;
+		const size_t LANE_COUNT = 4;
+#endif
+
+#if defined(ICE_FAIRY_SIMD_SSE)
+		// Splits 4 packed xyz vectors into a register per component, and back again.
+		inline void Deinterleave3(const float* p, __m128& x, __m128& y, __m128& z) {
+			__m128 a = _mm_loadu_ps(p);
+			__m128 b = _mm_loadu_ps(p + 4);
+			__m128 c = _mm_loadu_ps(p + 8);
+			__m128 x2y2x3y3 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));
+			__m128 y0z0y1z1 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 0, 2, 1));
+
+			x = _mm_shuffle_ps(a, x2y2x3y3, _MM_SHUFFLE(2, 0, 3, 0));
+			y = _mm_shuffle_ps(y0z0y1z1, x2y2x3y3, _MM_SHUFFLE(3, 1, 2, 0));
+			z = _mm_shuffle_ps(y0z0y1z1, c, _MM_SHUFFLE(3, 0, 3, 1));
+		}
+
+		inline void Interleave3(__m128 x, __m128 y, __m128 z, float* p) {
+			__m128 x0y0x1y1 = _mm_unpacklo_ps(x, y);
+			__m128 x2y2x3y3 = _mm_unpackhi_ps(x, y);
+			__m128 z0z0x1x1 = _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0));
+			__m128 y1y1z1z1 = _mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1));
+			__m128 z2z2x3x3 = _mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2));
+			__m128 y3y3z3z3 = _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3));
+
+			_mm_storeu_ps(p, _mm_shuffle_ps(x0y0x1y1, z0z0x1x1, _MM_SHUFFLE(2, 0, 1, 0)));
+			_mm_storeu_ps(p + 4, _mm_shuffle_ps(y1y1z1z1, x2y2x3y3, _MM_SHUFFLE(1, 0, 2, 0)));
+			_mm_storeu_ps(p + 8, _mm_shuffle_ps(z2z2x3x3, y3y3z3z3, _MM_SHUFFLE(2, 0, 2, 0)));
+		}
+
+		// Splits 4 packed xyzw vectors into a register per component, and back again.
+		inline void Deinterleave4(const float* p, __m128& x, __m128& y, __m128& z, __m128& w) {
+			x = _mm_loadu_ps(p);
+			y = _mm_loadu_ps(p + 4);
+			z = _mm_loadu_ps(p + 8);
+			w = _mm_loadu_ps(p + 12);
+			_MM_TRANSPOSE4_PS(x, y, z, w);
+		}
+
+		inline void Interleave4(__m128 x, __m128 y, __m128 z, __m128 w, float* p) {
+			_MM_TRANSPOSE4_PS(x, y, z, w);
+			_mm_storeu_ps(p, x);
+			_mm_storeu_ps(p + 4, y);
+			_mm_storeu_ps(p + 8, z);
+			_mm_storeu_ps(p + 12, w);
+		}
+#endif
+
+#if defined(ICE_FAIRY_SIMD_AVX)
+		inline Lanes Load(const float* p) { return _mm256_loadu_ps(p); }
+		inline void Store(float* p, Lanes a) { _mm256_storeu_ps(p, a); }
+		inline Lanes Splat(float a) { return _mm256_set1_ps(a); }
+		inline Lanes Add(Lanes a, Lanes b) { return _mm256_add_ps(a, b); }
+		inline Lanes Mul(Lanes a, Lanes b) { return _mm256_mul_ps(a, b); }
+		inline Lanes Div(Lanes a, Lanes b) { return _mm256_div_ps(a, b); }
+		inline Lanes Sqrt(Lanes a) { return _mm256_sqrt_ps(a); }
+
+		// a / b, or a where b is 0.
+		inline Lanes DivNonZero(Lanes a, Lanes b) {
+			return _mm256_blendv_ps(a, _mm256_div_ps(a, b), _mm256_cmp_ps(b, _mm256_setzero_ps(), _CMP_NEQ_OQ));
+		}
+
+		inline Lanes Combine(__m128 low, __m128 high) {
+			return _mm256_insertf128_ps(_mm256_castps128_ps256(low), high, 1);
+		}
+
+		inline void LoadVector3(const float* p, Lanes& x, Lanes& y, Lanes& z) {
+			__m128 x0, y0, z0, x1, y1, z1;
+			Deinterleave3(p, x0, y0, z0);
+			Deinterleave3(p + 12, x1, y1, z1);
+			x = Combine(x0, x1);
+			y = Combine(y0, y1);
+			z = Combine(z0, z1);
+		}
+
+		inline void StoreVector3(float* p, Lanes x, Lanes y, Lanes z) {
+			Interleave3(_mm256_castps256_ps128(x), _mm256_castps256_ps128(y), _mm256_castps256_ps128(z), p);
+			Interleave3(_mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(y, 1), _mm256_extractf128_ps(z, 1), p + 12);
+		}
+
+		inline void LoadVector4(const float* p, Lanes& x, Lanes& y, Lanes& z, Lanes& w) {
+			__m128 x0, y0, z0, w0, x1, y1, z1, w1;
+			Deinterleave4(p, x0, y0, z0, w0);
+			Deinterleave4(p + 16, x1, y1, z1, w1);
+			x = Combine(x0, x1);
+			y = Combine(y0, y1);
+			z = Combine(z0, z1);
+			w = Combine(w0, w1);
+		}
+
+		inline void StoreVector4(float* p, Lanes x, Lanes y, Lanes z, Lanes w) {
+			Interleave4(_mm256_castps256_ps128(x), _mm256_castps256_ps128(y), _mm256_castps256_ps128(z), _mm256_castps256_ps128(w), p);
+			Interleave4(_mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(y, 1), _mm256_extractf128_ps(z, 1), _mm256_extractf128_ps(w, 1), p + 16);
+		}
+#elif defined(ICE_FAIRY_SIMD_SSE)
+		inline Lanes Load(const float* p) { return _mm_loadu_ps(p); }
+		inline void Store(float* p, Lanes a) { _mm_storeu_ps(p, a); }
+		inline Lanes Splat(float a) { return _mm_set1_ps(a); }
+		inline Lanes Add(Lanes a, Lanes b) { return _mm_add_ps(a, b); }
+		inline Lanes Mul(Lanes a, Lanes b) { return _mm_mul_ps(a, b); }
+		inline Lanes Div(Lanes a, Lanes b) { return _mm_div_ps(a, b); }
+		inline Lanes Sqrt(Lanes a) { return _mm_sqrt_ps(a); }
+
+		// a / b, or a where b is 0.
+		inline Lanes DivNonZero(Lanes a, Lanes b) {
+			__m128 nonZero = _mm_cmpneq_ps(b, _mm_setzero_ps());
+			return _mm_or_ps(_mm_and_ps(nonZero, _mm_div_ps(a, b)), _mm_andnot_ps(nonZero, a));
+		}
+
+		inline void LoadVector3(const float* p, Lanes& x, Lanes& y, Lanes& z) { Deinterleave3(p, x, y, z); }
+		inline void StoreVector3(float* p, Lanes x, Lanes y, Lanes z) { Interleave3(x, y, z, p); }
+		inline void LoadVector4(const float* p, Lanes& x, Lanes& y, Lanes& z, Lanes& w) { Deinterleave4(p, x, y, z, w); }
+		inline void StoreVector4(float* p, Lanes x, Lanes y, Lanes z, Lanes w) { Interleave4(x, y, z, w, p); }
+#else
+		inline Lanes Load(const float* p) { return vld1q_f32(p); }
+		inline void Store(float* p, Lanes a) { vst1q_f32(p, a); }
+		inline Lanes Splat(float a) { return vdupq_n_f32(a); }
+		inline Lanes Add(Lanes a, Lanes b) { return vaddq_f32(a, b); }
+		inline Lanes Mul(Lanes a, Lanes b) { return vmulq_f32(a, b); }
+		inline Lanes Div(Lanes a, Lanes b) { return vdivq_f32(a, b); }
+		inline Lanes Sqrt(Lanes a) { return vsqrtq_f32(a); }
+
+		// a / b, or a where b is 0.
+		inline Lanes DivNonZero(Lanes a, Lanes b) {
+			return vbslq_f32(vceqq_f32(b, vdupq_n_f32(0.0f)), a, vdivq_f32(a, b));
+		}
+
+		// NEON loads and stores interleaved components natively
+		inline void LoadVector3(const float* p, Lanes& x, Lanes& y, Lanes& z) {
+			float32x4x3_t v = vld3q_f32(p);
+			x = v.val[0];
+			y = v.val[1];
+			z = v.val[2];
+		}
+
+		inline void StoreVector3(float* p, Lanes x, Lanes y, Lanes z) {
+			float32x4x3_t v = { { x, y, z } };
+			vst3q_f32(p, v);
+		}
+
+		inline void LoadVector4(const float* p, Lanes& x, Lanes& y, Lanes& z, Lanes& w) {
+			float32x4x4_t v = vld4q_f32(p);
+			x = v.val[0];
+			y = v.val[1];
+			z = v.val[2];
+			w = v.val[3];
+		}
+
+		inline void StoreVector4(float* p, Lanes x, Lanes y, Lanes z, Lanes w) {
+			float32x4x4_t v = { { x, y, z, w } };
+			vst4q_f32(p, v);
+		}
+#endif
+#endif
+	}
+}
+
+#endif /* __ice_fairy_simd_h__ */
@@ -36,51 +36,43 @@ namespace IceFairy {
 	template <class T>
 	class Vector2 {
 	public:
-		Vector2()
+		constexpr Vector2()
 			: x(0),
 			y(0) {
 		}
 
-		Vector2(T xy)
+		constexpr Vector2(T xy)
 			: x(xy),
 			y(xy) {
 		}
 
-		Vector2(T x, T y)
+		constexpr Vector2(T x, T y)
 			: x(x),
 			y(y) {
 		}
 
-		Vector2(T vals[2])
+		constexpr Vector2(T vals[2])
 			: x(vals[0]),
 			y(vals[1]) {
 		}
 
-		Vector2 operator=(const Vector2& other) {
-			if (this != &other) {
-				x = other.x;
-				y = other.y;
-			}
-			return *this;
-		}
-
-		Vector2 operator+=(const Vector2& other) {
+		constexpr Vector2 operator+=(const Vector2& other) {
 			x += other.x;
 			y += other.y;
 			return *this;
 		}
 
-		Vector2 operator-=(const Vector2& other) {
+		constexpr Vector2 operator-=(const Vector2& other) {
 			x -= other.x;
 			y -= other.y;
 			return *this;
 		}
 
-		Vector2 operator*(const T scale) const {
+		constexpr Vector2 operator*(const T scale) const {
 			return Vector2(x * scale, y * scale);
 		}
 
-		Vector2 operator*(const Vector2& other) const {
+		constexpr Vector2 operator*(const Vector2& other) const {
 			return Vector2(x * other.x, y * other.y);
 		}
 
@@ -90,38 +82,38 @@ namespace IceFairy {
 			return *this;
 		}
 
-		Vector2 operator/(const T scale) const {
+		constexpr Vector2 operator/(const T scale) const {
 			return Vector2(x / scale, y / scale);
 		}
 
-		Vector2 operator*=(const T scale) {
+		constexpr Vector2 operator*=(const T scale) {
 			x *= scale;
 			y *= scale;
 			return *this;
 		}
 
-		Vector2 operator/=(const T scale) {
+		constexpr Vector2 operator/=(const T scale) {
 			x /= scale;
 			y /= scale;
 			return *this;
 		}
 
-		Vector2 operator-(void) const {
+		constexpr Vector2 operator-(void) const {
 			return Vector2(-x, -y);
 		}
 
-		bool operator==(const Vector2& other) const {
+		constexpr bool operator==(const Vector2& other) const {
 			return x == other.x && y == other.y;
 		}
 
-		bool operator!=(const Vector2& other) const {
+		constexpr bool operator!=(const Vector2& other) const {
 			return !(*this == other);
 		}
 
 		// Returns the x or y element depending on input i.
 		// Only values 0 or 1 may be used for axes x and y respectively.
 		// Throws VectorOutOfBoundsException.
-		T& operator[](int i) {
+		constexpr T& operator[](int i) {
 			if (i == 0)
 				return x;
 			else if (i == 1)
@@ -131,12 +123,12 @@ namespace IceFairy {
 		}
 
 		// Returns the dot product of this vector and another.
-		T Dot(const Vector2& other) const {
+		constexpr T Dot(const Vector2& other) const {
 			return (x * other.x) + (y * other.y);
 		}
 
 		// Returns the perp dot product of this vector and another
-		T DotPerp(const Vector2& other) const {
+		constexpr T DotPerp(const Vector2& other) const {
 			return (x * other.y) - (y * other.x);
 		}
 
@@ -166,7 +158,7 @@ namespace IceFairy {
 		}
 		// Returns a vector which has been interpolated between this vector and
 		// another at a given position 't'.
-		Vector2 Interpolate(const Vector2& other, T t) {
+		constexpr Vector2 Interpolate(const Vector2& other, T t) const {
 			if (t >= 1) return other;
 			else if (t <= 0) return *this;
 			else return (*this * (1 - t)) + (other * t);
@@ -224,65 +216,56 @@ namespace IceFairy {
 	template <class T>
 	class Vector3 {
 	public:
-		Vector3()
+		constexpr Vector3()
 			: x(0),
 			y(0),
 			z(0) {
 		}
 
-		Vector3(T xyz)
+		constexpr Vector3(T xyz)
 			: x(xyz),
 			y(xyz),
 			z(xyz) {
 		}
 
-		Vector3(T x, T y, T z)
+		constexpr Vector3(T x, T y, T z)
 			: x(x),
 			y(y),
 			z(z) {
 		}
 
-		Vector3(T vals[3])
+		constexpr Vector3(T vals[3])
 			: x(vals[0]),
 			y(vals[1]),
 			z(vals[2]) {
 		}
 
-		Vector3(Vector2<T> v2, T z)
+		constexpr Vector3(Vector2<T> v2, T z)
 			: x(v2.x),
 			y(v2.y),
 			z(z) {
 		}
 
 		// Simple operator functions
-		Vector3 operator=(const Vector3& other) {
-			if (this != &other) {
-				x = other.x;
-				y = other.y;
-				z = other.z;
-			}
-			return *this;
-		}
-
-		Vector3 operator+=(const Vector3& other) {
+		constexpr Vector3 operator+=(const Vector3& other) {
 			x += other.x;
 			y += other.y;
 			z += other.z;
 			return *this;
 		}
 
-		Vector3 operator-=(const Vector3& other) {
+		constexpr Vector3 operator-=(const Vector3& other) {
 			x -= other.x;
 			y -= other.y;
 			z -= other.z;
 			return *this;
 		}
 
-		Vector3 operator*(const T scale) const {
+		constexpr Vector3 operator*(const T scale) const {
 			return Vector3(x * scale, y * scale, z * scale);
 		}
 
-		Vector3 operator*(const Vector3& other) const {
+		constexpr Vector3 operator*(const Vector3& other) const {
 			return Vector3(x * other.x, y * other.y, z * other.z);
 		}
 
@@ -293,40 +276,40 @@ namespace IceFairy {
 			return *this;
 		}
 
-		Vector3 operator/(const T scale) const {
+		constexpr Vector3 operator/(const T scale) const {
 			return Vector3(x / scale, y / scale, z / scale);
 		}
 
-		Vector3 operator*=(const T scale) {
+		constexpr Vector3 operator*=(const T scale) {
 			x *= scale;
 			y *= scale;
 			z *= scale;
 			return *this;
 		}
 
-		Vector3 operator/=(const T scale) {
+		constexpr Vector3 operator/=(const T scale) {
 			x /= scale;
 			y /= scale;
 			z /= scale;
 			return *this;
 		}
 
-		Vector3 operator-(void) const {
+		constexpr Vector3 operator-(void) const {
 			return Vector3(-x, -y, -z);
 		}
 
-		bool operator==(const Vector3& other) const {
+		constexpr bool operator==(const Vector3& other) const {
 			return x == other.x && y == other.y && z == other.z;
 		}
 
-		bool operator!=(const Vector3& other) const {
+		constexpr bool operator!=(const Vector3& other) const {
 			return !(*this == other);
 		}
 
 		// Returns the x, y or z element depending on input i.
 		// Only values 0, 1 and 2 may be used for axes x, y and z respectively.
 		// Throws VectorOutOfBoundsException.
-		T& operator[](int i) {
+		constexpr T& operator[](int i) {
 			if (i == 0)
 				return x;
 			else if (i == 1)
@@ -338,12 +321,12 @@ namespace IceFairy {
 		}
 
 		// Returns the dot product of this vector and another.
-		T Dot(const Vector3& other) const {
+		constexpr T Dot(const Vector3& other) const {
 			return (x * other.x) + (y * other.y) + (z * other.z);
 		}
 
 		// Returns the cross product of this vector and another.
-		Vector3 Cross(const Vector3& other) const {
+		constexpr Vector3 Cross(const Vector3& other) const {
 			return Vector3(y * other.z - z * other.y, z * other.x - x * other.z, x * other.y - y * other.x);
 		}
 
@@ -379,7 +362,7 @@ namespace IceFairy {
 
 		// Returns a vector which has been interpolated between this vector and
 		// another at a given position 't'.
-		Vector3 Interpolate(const Vector3& other, T t) {
+		constexpr Vector3 Interpolate(const Vector3& other, T t) const {
 			if (t >= 1) return other;
 			else if (t <= 0) return *this;
 			else return (*this * (1 - t)) + (other * t);
@@ -400,7 +383,7 @@ namespace IceFairy {
 		}
 
 		// Returns this 3D vector as a 2D vector, omitting the z value.
-		Vector2<T> ToVector2(void) {
+		constexpr Vector2<T> ToVector2(void) const {
 			return Vector2<T>(x, y);
 		}
 
@@ -416,7 +399,7 @@ namespace IceFairy {
 		// v3 --- v4
 		// |      |
 		// v1 --- v2
-		static Vector3 BilinearInterpolate(Vector3 v1, Vector3 v2, Vector3 v3, Vector3 v4, T s, T t) {
+		static constexpr Vector3 BilinearInterpolate(Vector3 v1, Vector3 v2, Vector3 v3, Vector3 v4, T s, T t) {
 			Vector3 xlerp1 = v2.Interpolate(v1, s);
 			Vector3 xlerp2 = v4.Interpolate(v3, s);
 
@@ -439,39 +422,39 @@ namespace IceFairy {
 	template <class T>
 	class Vector4 {
 	public:
-		Vector4()
+		constexpr Vector4()
 			: x(0),
 			y(0),
 			z(0),
 			w(0) {
 		}
 
-		Vector4(T xyzw)
+		constexpr Vector4(T xyzw)
 			: x(xyzw),
 			y(xyzw),
 			z(xyzw),
 			w(xyzw) {
 		}
 
-		Vector4(T x, T y, T z, T w)
+		constexpr Vector4(T x, T y, T z, T w)
 			: x(x),
 			y(y),
 			z(z),
 			w(w) {
 		}
 
-		Vector4(Vector3<T> v3, T w)
+		constexpr Vector4(Vector3<T> v3, T w)
 			: x(v3.x),
 			y(v3.y),
 			z(v3.z),
 			w(w) {
 		}
 
-		Vector3<T> ToVector3(void) {
+		constexpr Vector3<T> ToVector3(void) const {
 			return Vector3<T>(x, y, z);
 		}
 
-		T operator[](int i) const {
+		constexpr T operator[](int i) const {
 			if (i == 0)
 				return x;
 			else if (i == 1)
@@ -484,7 +467,7 @@ namespace IceFairy {
 				throw VectorOutOfBoundsException();
 		}
 
-		bool operator==(const Vector4& other) const {
+		constexpr bool operator==(const Vector4& other) const {
 			return x == other.x && y == other.y && z == other.z && w == other.w;
 		}
 
@@ -499,32 +482,32 @@ namespace IceFairy {
 	typedef Vector4<double> Vector4d;
 
 	template <class T>
-	Vector3<T> operator+(const Vector3<T>& lhs, const Vector3<T>& rhs) {
+	constexpr Vector3<T> operator+(const Vector3<T>& lhs, const Vector3<T>& rhs) {
 		return Vector3<T>(lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z);
 	}
 
 	template <class T>
-	Vector3<T> operator-(const Vector3<T>& lhs, const Vector3<T>& rhs) {
+	constexpr Vector3<T> operator-(const Vector3<T>& lhs, const Vector3<T>& rhs) {
 		return Vector3<T>(lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z);
 	}
 
 	template <class T>
-	Vector3<T> operator*(const Vector3<T>& lhs, const Vector3<T>& rhs) {
+	constexpr Vector3<T> operator*(const Vector3<T>& lhs, const Vector3<T>& rhs) {
 		return Vector3<T>(lhs.x * rhs.x, lhs.y * rhs.y, lhs.z * rhs.z);
 	}
 
 	template <class T>
-	Vector2<T> operator+(const Vector2<T>& lhs, const Vector2<T>& rhs) {
+	constexpr Vector2<T> operator+(const Vector2<T>& lhs, const Vector2<T>& rhs) {
 		return Vector2<T>(lhs.x + rhs.x, lhs.y + rhs.y);
 	}
 
 	template <class T>
-	Vector2<T> operator-(const Vector2<T>& lhs, const Vector2<T>& rhs) {
+	constexpr Vector2<T> operator-(const Vector2<T>& lhs, const Vector2<T>& rhs) {
 		return Vector2<T>(lhs.x - rhs.x, lhs.y - rhs.y);
 	}
 
 	template <class T>
-	Vector2<T> operator*(const Vector2<T>& lhs, const Vector2<T>& rhs) {
+	constexpr Vector2<T> operator*(const Vector2<T>& lhs, const Vector2<T>& rhs) {
 		return Vector2<T>(lhs.x * rhs.x, lhs.y * rhs.y);
 	}
 
@@ -1,5 +1,7 @@
 #include "fpscamera.h"
 
+#include "math/quaternion.h"
+
 using namespace IceFairy;
 
 FPSCamera::FPSCamera(const Vector3f& eye, const Vector3f& lookAt, const Vector3f& up, float speed)
@@ -103,8 +105,10 @@ Vector3f FPSCamera::GetMovement(void) const {
 void FPSCamera::Update(long timeSinceLastFrame) {
 	this->position += this->GetMovement() * this->speed;
 
-	this->viewMatrix =
-		Matrix4f::Rotate(pitch, 1.0f, 0.0f, 0.0f) *
-		Matrix4f::Rotate(yaw, 0.0f, 1.0f, 0.0f) *
-		Matrix4f::Translate(-this->position);
+	// Composing the two rotations as quaternions leaves a single 4x4 product
+	Quaternionf rotation =
+		Quaternionf::AxisAngle(pitch, 1.0f, 0.0f, 0.0f) *
+		Quaternionf::AxisAngle(yaw, 0.0f, 1.0f, 0.0f);
+
+	this->viewMatrix = Matrix4f::Rotate(rotation) * Matrix4f::Translate(-this->position);
 }
\ No newline at end of file
@@ -0,0 +1,78 @@
+#include "affineTest.h"
+
+static IceFairy::Matrix4f MakeMatrix(void) {
+    return IceFairy::Matrix4f::Translate(1.5f, -2, 3)
+        * IceFairy::Matrix4f::Rotate(30, 0, 1, 0)
+        * IceFairy::Matrix4f::Scale(2, 0.5f, 4);
+}
+
+static IceFairy::Affine3f MakeAffine(void) {
+    return IceFairy::Affine3f::Translate(1.5f, -2, 3)
+        * IceFairy::Affine3f::Rotate(30, 0, 1, 0)
+        * IceFairy::Affine3f::Scale(2, 0.5f, 4);
+}
+
+TEST(Affine3, MatchesMatrix4) {
+    IceFairy::Vector3f axis = IceFairy::Vector3f(1, 1, 0).Normalise();
+
+    M4_FuzzyMatch(MakeMatrix(), MakeAffine().ToMatrix4());
+    M4_FuzzyMatch(MakeMatrix(), IceFairy::Affine3f(MakeMatrix()).ToMatrix4());
+    M4_FuzzyMatch(
+        IceFairy::Matrix4f::Rotate(75.0f, axis),
+        IceFairy::Affine3f::Rotate(IceFairy::Quaternionf::AxisAngle(75.0f, axis)).ToMatrix4());
+
+    IceFairy::Affine3f composed = IceFairy::Affine3f::Translate(1.5f, -2, 3);
+    composed *= IceFairy::Affine3f::Rotate(30, 0, 1, 0);
+    composed *= IceFairy::Affine3f::Scale(2, 0.5f, 4);
+    M4_FuzzyMatch(MakeMatrix(), composed.ToMatrix4());
+}
+
+TEST(Affine3, TransformVectors) {
+    IceFairy::Matrix4f m = MakeMatrix();
+    IceFairy::Affine3f a = MakeAffine();
+    IceFairy::Vector3f v(1, 2, 3);
+
+    V3M_FuzzyFloatMatch((m * IceFairy::Vector4f(v, 1)).ToVector3(), a.TransformPoint(v));
+    V3M_FuzzyFloatMatch(m * v, a.TransformDirection(v));
+    V3M_FuzzyFloatMatch((m * IceFairy::Vector4f(v, 1)).ToVector3(), (a * IceFairy::Vector4f(v, 1)).ToVector3());
+    V3M_FuzzyFloatMatch(IceFairy::Vector3f(1.5f, -2, 3), a.GetTranslation());
+}
+
+TEST(Affine3, Inverse) {
+    IceFairy::Affine3f a = MakeAffine();
+
+    M4_FuzzyMatch(MakeMatrix().Inverse(), a.Inverse().ToMatrix4());
+    M4_FuzzyMatch(IceFairy::Matrix4f::Identity(), (a * a.Inverse()).ToMatrix4());
+}
+
+TEST(Affine3, RigidInverse) {
+    IceFairy::Affine3f rigid = IceFairy::Affine3f::Translate(1.5f, -2, 3)
+        * IceFairy::Affine3f::Rotate(30, IceFairy::Vector3f(1, 2, 3).Normalise());
+
+    M4_FuzzyMatch(rigid.Inverse().ToMatrix4(), rigid.RigidInverse().ToMatrix4());
+    M4_FuzzyMatch(IceFairy::Matrix4f::Identity(), (rigid.RigidInverse() * rigid).ToMatrix4());
+}
+
+TEST(Affine3, NoInverse) {
+    IceFairy::Affine3f flat = IceFairy::Affine3f::Translate(1, 2, 3) * IceFairy::Affine3f::Scale(1, 0, 1);
+
+    ASSERT_THROW(flat.Inverse(), IceFairy::MatrixNoInverseExistsException);
+}
+
+TEST(Affine3, IsAffine) {
+    EXPECT_TRUE(MakeMatrix().IsAffine());
+    EXPECT_TRUE(IceFairy::Matrix4f::Ortho(0, 800, 0, 600, -1, 1).IsAffine());
+    EXPECT_TRUE(IceFairy::Matrix4f::LookAt(IceFairy::Vector3f(1, 2, 3), IceFairy::Vector3f(0, 0, 0), IceFairy::Vector3f(0, 1, 0)).IsAffine());
+    EXPECT_FALSE(IceFairy::Matrix4f::Perspective(60, 1.5f, 0.1f, 100).IsAffine());
+    EXPECT_FALSE(IceFairy::Matrix4f().IsAffine());
+}
+
+TEST(Affine3, ConstantExpressions) {
+    constexpr IceFairy::Affine3f a = IceFairy::Affine3f::Translate(1, 2, 3) * IceFairy::Affine3f::Scale(2, 2, 2);
+
+    static_assert(a.TransformPoint(IceFairy::Vector3f(1, 1, 1)) == IceFairy::Vector3f(3, 4, 5), "Affine3 products should fold at compile time");
+    static_assert(a.Inverse().TransformPoint(IceFairy::Vector3f(3, 4, 5)) == IceFairy::Vector3f(1, 1, 1), "Affine3 inverses should fold at compile time");
+    static_assert(a.ToMatrix4().IsAffine(), "IsAffine should fold at compile time");
+
+    EXPECT_EQ(IceFairy::Affine3f::Identity(), a * a.Inverse());
+}
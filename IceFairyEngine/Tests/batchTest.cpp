@@ -0,0 +1,172 @@
+#include "batchTest.h"
+
+#include <vector>
+
+// Not a multiple of any lane count, so the scalar remainder is covered too
+static const size_t BATCH_SIZE = 19;
+
+static std::vector<IceFairy::Vector3f> MakeVectors(void) {
+    std::vector<IceFairy::Vector3f> vectors;
+
+    for (size_t i = 0; i < BATCH_SIZE; i++) {
+        float f = (float) i;
+        vectors.push_back(IceFairy::Vector3f(f - 9, f * 0.5f + 1, 3 - f * 0.25f));
+    }
+
+    // Normalise leaves zero vectors alone
+    vectors[5] = IceFairy::Vector3f(0, 0, 0);
+
+    return vectors;
+}
+
+static IceFairy::Matrix4f MakeTransform(void) {
+    return IceFairy::Matrix4f::Translate(1.5f, -2, 3)
+        * IceFairy::Matrix4f::Rotate(30, 0, 1, 0)
+        * IceFairy::Matrix4f::Scale(2, 0.5f, 4);
+}
+
+TEST(Batch, TransformPoints) {
+    IceFairy::Matrix4f m = MakeTransform();
+    std::vector<IceFairy::Vector3f> points = MakeVectors();
+    std::vector<IceFairy::Vector3f> out(BATCH_SIZE);
+
+    IceFairy::Batch::TransformPoints(m, points.data(), out.data(), BATCH_SIZE);
+
+    for (size_t i = 0; i < BATCH_SIZE; i++) {
+        V3M_FuzzyFloatMatch((m * IceFairy::Vector4f(points[i], 1)).ToVector3(), out[i]);
+    }
+}
+
+TEST(Batch, TransformDirectionsInPlace) {
+    IceFairy::Matrix4f m = MakeTransform();
+    std::vector<IceFairy::Vector3f> directions = MakeVectors();
+    std::vector<IceFairy::Vector3f> expected;
+
+    for (auto& direction : directions) {
+        expected.push_back(m * direction);
+    }
+
+    IceFairy::Batch::TransformDirections(m, directions.data(), directions.data(), BATCH_SIZE);
+
+    for (size_t i = 0; i < BATCH_SIZE; i++) {
+        V3M_FuzzyFloatMatch(expected[i], directions[i]);
+    }
+}
+
+TEST(Batch, TransformVector4) {
+    IceFairy::Matrix4f m = MakeTransform();
+    std::vector<IceFairy::Vector4f> vectors;
+    std::vector<IceFairy::Vector4f> out(BATCH_SIZE);
+
+    for (auto& v : MakeVectors()) {
+        vectors.push_back(IceFairy::Vector4f(v, v.x * 0.1f));
+    }
+
+    IceFairy::Batch::Transform(m, vectors.data(), out.data(), BATCH_SIZE);
+
+    for (size_t i = 0; i < BATCH_SIZE; i++) {
+        IceFairy::Vector4f expected = m * vectors[i];
+
+        for (int j = 0; j < 4; j++) {
+            EXPECT_NEAR(expected[j], out[i][j], 1e-5f);
+        }
+    }
+}
+
+TEST(Batch, TransformSoA) {
+    IceFairy::Matrix4f m = MakeTransform();
+    std::vector<IceFairy::Vector3f> points = MakeVectors();
+    std::vector<float> x, y, z, w;
+
+    for (auto& point : points) {
+        x.push_back(point.x);
+        y.push_back(point.y);
+        z.push_back(point.z);
+        w.push_back(1);
+    }
+
+    std::vector<float> outX(BATCH_SIZE), outY(BATCH_SIZE), outZ(BATCH_SIZE), outW(BATCH_SIZE);
+
+    IceFairy::Batch::TransformPoints(m, { x.data(), y.data(), z.data() }, { outX.data(), outY.data(), outZ.data() }, BATCH_SIZE);
+
+    for (size_t i = 0; i < BATCH_SIZE; i++) {
+        V3M_FuzzyFloatMatch((m * IceFairy::Vector4f(points[i], 1)).ToVector3(), IceFairy::Vector3f(outX[i], outY[i], outZ[i]));
+    }
+
+    IceFairy::Batch::Transform(m, { x.data(), y.data(), z.data(), w.data() }, { outX.data(), outY.data(), outZ.data(), outW.data() }, BATCH_SIZE);
+
+    for (size_t i = 0; i < BATCH_SIZE; i++) {
+        V3M_FuzzyFloatMatch((m * IceFairy::Vector4f(points[i], 1)).ToVector3(), IceFairy::Vector3f(outX[i], outY[i], outZ[i]));
+        EXPECT_NEAR(1, outW[i], 1e-5f);
+    }
+}
+
+TEST(Batch, MultiplyPairwise) {
+    std::vector<IceFairy::Matrix4f> lhs, rhs;
+    std::vector<IceFairy::Matrix4f> out(BATCH_SIZE);
+
+    for (size_t i = 0; i < BATCH_SIZE; i++) {
+        lhs.push_back(IceFairy::Matrix4f::Translate((float) i, 2, -1) * IceFairy::Matrix4f::Rotate(10.0f * i, 0, 0, 1));
+        rhs.push_back(IceFairy::Matrix4f::Scale(1, (float) i, 2));
+    }
+
+    IceFairy::Batch::Multiply(lhs.data(), rhs.data(), out.data(), BATCH_SIZE);
+
+    for (size_t i = 0; i < BATCH_SIZE; i++) {
+        M4_Match(lhs[i] * rhs[i], out[i]);
+    }
+}
+
+TEST(Batch, Dot) {
+    std::vector<IceFairy::Vector3f> a = MakeVectors();
+    std::vector<IceFairy::Vector3f> b(a.rbegin(), a.rend());
+    std::vector<float> out(BATCH_SIZE);
+
+    IceFairy::Batch::Dot(a.data(), b.data(), out.data(), BATCH_SIZE);
+
+    for (size_t i = 0; i < BATCH_SIZE; i++) {
+        EXPECT_NEAR(a[i].Dot(b[i]), out[i], 1e-5f);
+    }
+
+    std::vector<float> x, y, z;
+
+    for (auto& v : a) {
+        x.push_back(v.x);
+        y.push_back(v.y);
+        z.push_back(v.z);
+    }
+
+    IceFairy::Batch::Dot({ x.data(), y.data(), z.data() }, { x.data(), y.data(), z.data() }, out.data(), BATCH_SIZE);
+
+    for (size_t i = 0; i < BATCH_SIZE; i++) {
+        EXPECT_NEAR(a[i].Dot(a[i]), out[i], 1e-5f);
+    }
+}
+
+TEST(Batch, Normalise) {
+    std::vector<IceFairy::Vector3f> vectors = MakeVectors();
+    std::vector<IceFairy::Vector3f> out(BATCH_SIZE);
+
+    IceFairy::Batch::Normalise(vectors.data(), out.data(), BATCH_SIZE);
+
+    for (size_t i = 0; i < BATCH_SIZE; i++) {
+        IceFairy::Vector3f expected = vectors[i];
+        V3M_FuzzyFloatMatch(expected.Normalise(), out[i]);
+    }
+
+    EXPECT_EQ(IceFairy::Vector3f(0, 0, 0), out[5]);
+
+    std::vector<float> x, y, z;
+
+    for (auto& v : vectors) {
+        x.push_back(v.x);
+        y.push_back(v.y);
+        z.push_back(v.z);
+    }
+
+    IceFairy::Batch::Normalise({ x.data(), y.data(), z.data() }, { x.data(), y.data(), z.data() }, BATCH_SIZE);
+
+    for (size_t i = 0; i < BATCH_SIZE; i++) {
+        V3M_FuzzyFloatMatch(out[i], IceFairy::Vector3f(x[i], y[i], z[i]));
+    }
+}
@@ -0,0 +1,7 @@
+#ifndef __ice_fairy_tests_batch_test_h__
+#define __ice_fairy_tests_batch_test_h__
+
+#include "common.h"
+#include "math\batch.h"
+
+#endif /* __ice_fairy_tests_batch_test_h__ */
@@ -0,0 +1,68 @@
+#include "chunkAllocatorTest.h"
+
+using IceFairy::ChunkAllocator;
+
+TEST(ChunkAllocator, FreedBlocksAreReused) {
+    ChunkAllocator allocator;
+
+    void* first = allocator.Allocate(1);
+    allocator.Free(first, 1);
+    void* second = allocator.Allocate(1);
+
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(0, (uintptr_t) second % ChunkAllocator::CHUNK_ALIGNMENT);
+
+    auto stats = allocator.GetStats();
+    EXPECT_EQ(1, stats.numChunksInUse);
+    EXPECT_EQ(0, stats.numChunksFree);
+    EXPECT_EQ(1, stats.numSystemAllocations);
+    EXPECT_EQ(1, stats.numReuses);
+
+    allocator.Free(second, 1);
+}
+
+TEST(ChunkAllocator, BlocksAreRoundedToPowersOfTwo) {
+    ChunkAllocator allocator;
+
+    EXPECT_EQ(1, ChunkAllocator::GetChunksFor(1));
+    EXPECT_EQ(1, ChunkAllocator::GetChunksFor(ChunkAllocator::CHUNK_SIZE));
+    EXPECT_EQ(4, ChunkAllocator::GetChunksFor(ChunkAllocator::CHUNK_SIZE * 3));
+
+    void* block = allocator.Allocate(3);
+    EXPECT_EQ(4, allocator.GetStats().numChunksInUse);
+    allocator.Free(block, 4);
+
+    allocator.Trim();
+    EXPECT_EQ(0, allocator.GetStats().numChunksFree);
+}
+
+TEST(ChunkAllocator, RegistryReusesChunksOfEmptiedArchetypes) {
+    IceFairy::EntityRegistry registry;
+    std::vector<IceFairy::Entity> entities;
+
+    for (int i = 0; i < 1000; i++) {
+        entities.push_back(registry.AddEntity());
+        entities.back().AddComponent<PositionComponent>((float) i, 0.0f);
+    }
+
+    auto filled = registry.GetAllocator().GetStats();
+    EXPECT_GT(filled.numChunksInUse, 0);
+    EXPECT_GT(registry.GetOccupancy(), 0.0f);
+    EXPECT_LE(registry.GetOccupancy(), 1.0f);
+
+    for (auto& entity : entities) {
+        entity.Destroy();
+    }
+
+    auto emptied = registry.GetAllocator().GetStats();
+    EXPECT_EQ(0, emptied.numChunksInUse);
+    EXPECT_GE(emptied.numChunksFree, filled.numChunksInUse);
+
+    for (int i = 0; i < 1000; i++) {
+        registry.AddEntity().AddComponent<VelocityComponent>(0.0f, (float) i);
+    }
+
+    // Velocity is the same size as Position, so its column fits in the blocks Position gave back
+    auto refilled = registry.GetAllocator().GetStats();
+    EXPECT_EQ(filled.numSystemAllocations, refilled.numSystemAllocations);
+}
@@ -0,0 +1,11 @@
+#ifndef __ice_fairy_tests_chunk_allocator_test_h__
+#define __ice_fairy_tests_chunk_allocator_test_h__
+
+#include <cstdint>
+
+#include "gtest\gtest.h"
+#include "ecs\chunkallocator.h"
+#include "ecs\entityregistry.h"
+#include "entityRegistryTest.h"
+
+#endif /* __ice_fairy_tests_chunk_allocator_test_h__ */
@@ -1,3 +1,5 @@
+#include <type_traits>
+
 #include "gtest\gtest.h"
 #include "math\colour.h"
 
@@ -35,4 +37,16 @@ TEST(Colour4Math, Interpolate) {
     IceFairy::Colour4f blue(0.0f, 0.0f, 1.0f, 1.0f);
 
     C4M_FuzzyFloatMatch(IceFairy::Colour4f(0.5f, 0.0f, 0.5f, 1.0f), red.Interpolate(blue, 0.5f));
-}
\ No newline at end of file
+}
+
+TEST(Colour4Math, ConstantExpressions) {
+    constexpr IceFairy::Colour4f red(1.0f, 0.0f, 0.0f, 1.0f);
+    constexpr IceFairy::Colour4f blue(IceFairy::Colour3f(0.0f, 0.0f, 1.0f), 1.0f);
+
+    static_assert(red.Interpolate(blue, 0.5f) == IceFairy::Colour4f(0.5f, 0.0f, 0.5f, 1.0f), "Interpolate should fold at compile time");
+    static_assert((red + blue).ToColour3() == IceFairy::Colour3f(1.0f, 0.0f, 1.0f), "Operators should fold at compile time");
+    static_assert(std::is_trivially_copyable<IceFairy::Colour3f>::value, "Colour3 should be trivially copyable");
+    static_assert(std::is_trivially_copyable<IceFairy::Colour4f>::value, "Colour4 should be trivially copyable");
+
+    EXPECT_EQ(IceFairy::Colour3f(1.0f, 0.0f, 0.0f), red.ToColour3());
+}
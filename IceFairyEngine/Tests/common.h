@@ -1,6 +1,8 @@
 #ifndef __ice_fairy_tests_common_h__
 #define __ice_fairy_tests_common_h__
 
+#include <type_traits>
+
 #include "gtest\gtest.h"
 #include "math\vector.h"
 #include "math\matrix.h"
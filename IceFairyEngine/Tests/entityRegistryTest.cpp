@@ -0,0 +1,733 @@
+#include "entityRegistryTest.h"
+
+namespace IceFairy {
+    template <>
+    class JobSystem<PositionComponent, VelocityComponent> {
+    public:
+        void Execute(PositionComponent& position, VelocityComponent& velocity) {
+            position.x += velocity.x;
+            position.y += velocity.y;
+        }
+    };
+
+    template <>
+    class JobSystem<VelocityComponent, const PositionComponent> {
+    public:
+        void Execute(VelocityComponent& velocity, const PositionComponent& position) {
+            velocity.x = position.x;
+            velocity.y = position.y;
+        }
+    };
+
+    // Gives every named entity a copy with a position, either directly or through a command buffer
+    template <>
+    class JobSystem<const NameComponent> {
+    public:
+        JobSystem(EntityRegistry* registry, bool deferred) :
+            registry(registry),
+            deferred(deferred) {
+        }
+
+        void Execute(const NameComponent& name) {
+            if (!deferred) {
+                registry->AddEntity();
+                return;
+            }
+
+            auto& commands = registry->GetCommandBuffer();
+            auto copy = commands.Spawn();
+
+            commands.AddComponent<NameComponent>(copy, name.name + " copy");
+            commands.AddComponent<PositionComponent>(copy, 1.0f, 2.0f);
+        }
+
+    private:
+        EntityRegistry* registry;
+        bool deferred;
+    };
+
+    template <>
+    class JobSystem<const VelocityComponent> {
+    public:
+        void Execute(const VelocityComponent& velocity) {
+            numVisited++;
+        }
+
+        std::atomic<int> numVisited { 0 };
+    };
+}
+
+TEST(EntityRegistry, AddAndGetComponent) {
+    IceFairy::EntityRegistry registry;
+    auto entity = registry.AddEntity();
+
+    entity.AddComponent<PositionComponent>(1.0f, 2.0f);
+
+    EXPECT_TRUE(entity.HasComponent<PositionComponent>());
+    EXPECT_FALSE(entity.HasComponent<VelocityComponent>());
+    EXPECT_EQ(1.0f, entity.GetComponent<PositionComponent>().x);
+    EXPECT_EQ(2.0f, entity.GetComponent<PositionComponent>().y);
+    ASSERT_THROW(entity.GetComponent<VelocityComponent>(), IceFairy::EntityException);
+}
+
+TEST(EntityRegistry, ComponentTypeIdsAreDense) {
+    auto positionId = IceFairy::ComponentTypes::GetId<PositionComponent>();
+    auto velocityId = IceFairy::ComponentTypes::GetId<VelocityComponent>();
+
+    EXPECT_NE(positionId, velocityId);
+    EXPECT_EQ(positionId, IceFairy::ComponentTypes::GetId<PositionComponent>());
+    EXPECT_LT(positionId, IceFairy::ComponentTypes::GetCount());
+    EXPECT_LT(velocityId, IceFairy::ComponentTypes::GetCount());
+    EXPECT_EQ(sizeof(PositionComponent), IceFairy::ComponentTypes::GetInfo(positionId).size);
+}
+
+TEST(EntityRegistry, HasComponents) {
+    IceFairy::EntityRegistry registry;
+    auto entity = registry.AddEntity();
+
+    entity.AddComponent<PositionComponent>(0.0f, 0.0f);
+    entity.AddComponent<VelocityComponent>(0.0f, 0.0f);
+
+    EXPECT_TRUE((entity.HasComponents<PositionComponent, VelocityComponent>()));
+    EXPECT_FALSE((entity.HasComponents<PositionComponent, NameComponent>()));
+    EXPECT_EQ((IceFairy::ComponentTypes::GetMask<PositionComponent, VelocityComponent>()), entity.GetComponentMask());
+}
+
+TEST(EntityRegistry, GetEntity) {
+    IceFairy::EntityRegistry registry;
+    auto entity1 = registry.AddEntity();
+    auto entity2 = registry.AddEntity();
+
+    EXPECT_EQ(entity1.GetId(), registry.GetEntity(entity1.GetId()).GetId());
+    EXPECT_EQ(entity2.GetId(), registry.GetEntity(entity2.GetId()).GetId());
+    ASSERT_THROW(registry.GetEntity(IceFairy::EntityId { 1000, 0 }), IceFairy::EntityRegistryException);
+}
+
+TEST(EntityRegistry, RemovedSlotsAreRecycledWithNewGeneration) {
+    IceFairy::EntityRegistry registry;
+    auto entity1 = registry.AddEntity();
+    auto entity2 = registry.AddEntity();
+
+    entity1.AddComponent<NameComponent>("one");
+    entity2.AddComponent<NameComponent>("two");
+    entity1.Destroy();
+
+    EXPECT_FALSE(entity1.IsAlive());
+    EXPECT_FALSE(registry.IsAlive(entity1.GetId()));
+    EXPECT_EQ(1u, registry.GetEntityCount());
+    EXPECT_EQ("two", entity2.GetComponent<NameComponent>().name);
+    ASSERT_THROW(entity1.GetComponent<NameComponent>(), IceFairy::EntityException);
+    ASSERT_THROW(registry.RemoveEntity(entity1.GetId()), IceFairy::EntityRegistryException);
+
+    auto entity3 = registry.AddEntity();
+
+    EXPECT_EQ(entity1.GetId().index, entity3.GetId().index);
+    EXPECT_NE(entity1.GetId(), entity3.GetId());
+    EXPECT_TRUE(entity3.IsAlive());
+    EXPECT_FALSE(entity1.IsAlive());
+    EXPECT_FALSE(entity3.HasComponent<NameComponent>());
+}
+
+TEST(EntityRegistry, ComponentsSurviveArchetypeMoves) {
+    IceFairy::EntityRegistry registry;
+    auto entity1 = registry.AddEntity();
+    auto entity2 = registry.AddEntity();
+    auto entity3 = registry.AddEntity();
+
+    entity1.AddComponent<NameComponent>("one");
+    entity2.AddComponent<NameComponent>("two");
+    entity3.AddComponent<NameComponent>("three");
+
+    entity1.AddComponent<PositionComponent>(1.0f, 1.0f);
+    entity2.RemoveComponent<NameComponent>();
+
+    EXPECT_EQ("one", entity1.GetComponent<NameComponent>().name);
+    EXPECT_EQ(1.0f, entity1.GetComponent<PositionComponent>().x);
+    EXPECT_FALSE(entity2.HasComponent<NameComponent>());
+    EXPECT_EQ("three", entity3.GetComponent<NameComponent>().name);
+}
+
+TEST(EntityRegistry, ScheduleOnlyVisitsMatchingEntities) {
+    IceFairy::EntityRegistry registry;
+    auto moving = registry.AddEntity();
+    auto stationary = registry.AddEntity();
+    auto named = registry.AddEntity();
+
+    moving.AddComponent<PositionComponent>(0.0f, 0.0f);
+    moving.AddComponent<VelocityComponent>(1.0f, 2.0f);
+    stationary.AddComponent<PositionComponent>(5.0f, 5.0f);
+    named.AddComponent<PositionComponent>(0.0f, 0.0f);
+    named.AddComponent<VelocityComponent>(3.0f, 4.0f);
+    named.AddComponent<NameComponent>("named");
+
+    registry.Schedule(std::make_shared<IceFairy::JobSystem<PositionComponent, VelocityComponent>>());
+
+    EXPECT_EQ(1.0f, moving.GetComponent<PositionComponent>().x);
+    EXPECT_EQ(2.0f, moving.GetComponent<PositionComponent>().y);
+    EXPECT_EQ(5.0f, stationary.GetComponent<PositionComponent>().x);
+    EXPECT_EQ(3.0f, named.GetComponent<PositionComponent>().x);
+    EXPECT_EQ(4.0f, named.GetComponent<PositionComponent>().y);
+}
+
+TEST(EntityRegistry, ParallelScheduleMatchesSerial) {
+    for (unsigned int numWorkers : { 0u, 3u }) {
+        IceFairy::EntityRegistry registry;
+        std::vector<IceFairy::Entity> entities;
+
+        registry.SetWorkerCount(numWorkers);
+        registry.SetChunkSize(100);
+
+        for (int i = 0; i < 5000; i++) {
+            auto entity = registry.AddEntity();
+            entity.AddComponent<PositionComponent>(0.0f, 0.0f);
+            entity.AddComponent<VelocityComponent>((float) i, 1.0f);
+            if (i % 2 == 0) {
+                entity.AddComponent<NameComponent>("even");
+            }
+            entities.push_back(entity);
+        }
+
+        registry.Schedule(std::make_shared<IceFairy::JobSystem<PositionComponent, VelocityComponent>>(),
+            IceFairy::EntityRegistry::EXECUTION_PARALLEL);
+
+        for (int i = 0; i < 5000; i++) {
+            EXPECT_EQ((float) i, entities[i].GetComponent<PositionComponent>().x);
+            EXPECT_EQ(1.0f, entities[i].GetComponent<PositionComponent>().y);
+        }
+    }
+}
+
+TEST(EntityRegistry, ViewIsUpdatedIncrementally) {
+    IceFairy::EntityRegistry registry;
+    auto view = registry.View<PositionComponent, VelocityComponent>();
+    auto entity1 = registry.AddEntity();
+    auto entity2 = registry.AddEntity();
+
+    EXPECT_EQ(0u, view.GetSize());
+
+    entity1.AddComponent<PositionComponent>(0.0f, 0.0f);
+    entity1.AddComponent<VelocityComponent>(1.0f, 1.0f);
+    entity2.AddComponent<PositionComponent>(0.0f, 0.0f);
+
+    ASSERT_EQ(1u, view.GetSize());
+    EXPECT_EQ(entity1.GetId(), view.GetEntities()[0]);
+
+    entity2.AddComponent<VelocityComponent>(2.0f, 2.0f);
+    entity1.AddComponent<NameComponent>("still matches");
+
+    EXPECT_EQ(2u, view.GetSize());
+
+    entity1.RemoveComponent<VelocityComponent>();
+
+    ASSERT_EQ(1u, view.GetSize());
+    EXPECT_EQ(entity2.GetId(), view.GetEntities()[0]);
+
+    entity2.Destroy();
+
+    EXPECT_EQ(0u, view.GetSize());
+}
+
+TEST(EntityRegistry, ViewEachVisitsExistingEntities) {
+    IceFairy::EntityRegistry registry;
+
+    for (int i = 0; i < 10; i++) {
+        auto entity = registry.AddEntity();
+        entity.AddComponent<PositionComponent>((float) i, 0.0f);
+        if (i % 2 == 0) {
+            entity.AddComponent<NameComponent>("even");
+        }
+    }
+
+    auto view = registry.View<PositionComponent>();
+    float sum = 0.0f;
+
+    view.Each([&sum](PositionComponent& position) {
+        sum += position.x;
+    });
+
+    EXPECT_EQ(10u, view.GetSize());
+    EXPECT_EQ(45.0f, sum);
+}
+
+TEST(EntityRegistry, SystemAccessConflicts) {
+    auto move = IceFairy::SystemAccess::Create<PositionComponent, const VelocityComponent>();
+    auto readPosition = IceFairy::SystemAccess::Create<const PositionComponent>();
+    auto readBoth = IceFairy::SystemAccess::Create<const PositionComponent, const VelocityComponent>();
+    auto writeName = IceFairy::SystemAccess::Create<NameComponent>();
+
+    EXPECT_TRUE(move.Conflicts(readPosition));
+    EXPECT_TRUE(readPosition.Conflicts(move));
+    EXPECT_TRUE(move.Conflicts(move));
+    EXPECT_FALSE(readPosition.Conflicts(readBoth));
+    EXPECT_FALSE(move.Conflicts(writeName));
+    EXPECT_EQ(IceFairy::ComponentTypes::GetId<PositionComponent>(), IceFairy::ComponentTypes::GetId<const PositionComponent>());
+}
+
+TEST(EntityRegistry, RunSystemsKeepsOrderOfConflictingSystems) {
+    IceFairy::EntityRegistry registry;
+    registry.SetWorkerCount(4);
+    std::vector<IceFairy::EntityId> ids;
+
+    for (int i = 0; i < 1000; i++) {
+        auto entity = registry.AddEntity();
+        entity.AddComponent<PositionComponent>((float) i, 0.0f);
+        entity.AddComponent<VelocityComponent>(1.0f, 2.0f);
+        ids.push_back(entity.GetId());
+    }
+
+    // Both touch Position and Velocity, so the second must always see the first's writes
+    registry.AddSystem(std::make_shared<IceFairy::JobSystem<PositionComponent, VelocityComponent>>(),
+        IceFairy::EntityRegistry::EXECUTION_PARALLEL);
+    registry.AddSystem(std::make_shared<IceFairy::JobSystem<VelocityComponent, const PositionComponent>>(),
+        IceFairy::EntityRegistry::EXECUTION_PARALLEL);
+
+    registry.RunSystems();
+
+    for (int i = 0; i < 1000; i++) {
+        auto entity = registry.GetEntity(ids[i]);
+        EXPECT_EQ((float) i + 1.0f, entity.GetComponent<PositionComponent>().x);
+        EXPECT_EQ(entity.GetComponent<PositionComponent>().x, entity.GetComponent<VelocityComponent>().x);
+        EXPECT_EQ(2.0f, entity.GetComponent<VelocityComponent>().y);
+    }
+}
+
+TEST(EntityRegistry, CommandBufferDefersStructuralChanges) {
+    IceFairy::EntityRegistry registry;
+    IceFairy::EntityCommandBuffer commands;
+
+    auto kept = registry.AddEntity();
+    auto destroyed = registry.AddEntity();
+    kept.AddComponent<PositionComponent>(1.0f, 1.0f);
+
+    auto spawned = commands.Spawn();
+    commands.AddComponent<NameComponent>(spawned, "spawned");
+    commands.AddComponent<VelocityComponent>(kept.GetId(), 3.0f, 4.0f);
+    commands.RemoveComponent<PositionComponent>(kept.GetId());
+    commands.Destroy(destroyed.GetId());
+    commands.Destroy(destroyed.GetId());
+
+    EXPECT_EQ(6, commands.GetSize());
+    EXPECT_EQ(2, registry.GetEntityCount());
+    EXPECT_TRUE(kept.HasComponent<PositionComponent>());
+    EXPECT_TRUE(destroyed.IsAlive());
+
+    registry.Playback(commands);
+
+    EXPECT_TRUE(commands.IsEmpty());
+    EXPECT_EQ(2, registry.GetEntityCount());
+    EXPECT_FALSE(destroyed.IsAlive());
+    EXPECT_FALSE(kept.HasComponent<PositionComponent>());
+    EXPECT_EQ(4.0f, kept.GetComponent<VelocityComponent>().y);
+
+    auto named = registry.View<NameComponent>();
+    ASSERT_EQ(1, named.GetSize());
+    EXPECT_EQ("spawned", registry.GetEntity(named.GetEntities()[0]).GetComponent<NameComponent>().name);
+}
+
+TEST(EntityRegistry, CommandBufferSpawnsStraightIntoFinalArchetype) {
+    IceFairy::EntityRegistry registry;
+    IceFairy::EntityCommandBuffer commands;
+
+    for (int i = 0; i < 8; i++) {
+        auto spawned = commands.Spawn();
+        commands.AddComponent<PositionComponent>(spawned, 0.0f, 0.0f);
+        commands.AddComponent<NameComponent>(spawned, "temporary");
+        commands.AddComponent<VelocityComponent>(spawned, (float) i, 0.0f);
+        commands.AddComponent<PositionComponent>(spawned, (float) i, 1.0f);
+        commands.RemoveComponent<NameComponent>(spawned);
+    }
+
+    auto destroyed = commands.Spawn();
+    commands.AddComponent<PositionComponent>(destroyed, 0.0f, 0.0f);
+    commands.Destroy(destroyed);
+    commands.AddComponent<NameComponent>(destroyed, "destroyed");
+
+    registry.Playback(commands);
+
+    EXPECT_EQ(8, registry.GetEntityCount());
+    EXPECT_EQ(0, registry.View<NameComponent>().GetSize());
+
+    // Only the final set of components got an archetype, with every spawned entity in order
+    auto view = registry.View<PositionComponent>();
+    ASSERT_EQ(1, view.GetArchetypes().size());
+    ASSERT_EQ(8, view.GetSize());
+
+    for (size_t i = 0; i < 8; i++) {
+        auto entity = registry.GetEntity(view.GetEntities()[i]);
+
+        EXPECT_EQ((float) i, entity.GetComponent<PositionComponent>().x);
+        EXPECT_EQ(1.0f, entity.GetComponent<PositionComponent>().y);
+        EXPECT_EQ((float) i, entity.GetComponent<VelocityComponent>().x);
+    }
+}
+
+TEST(EntityRegistry, StructuralChangesWhileScheduledThrow) {
+    IceFairy::EntityRegistry registry;
+    registry.AddEntity().AddComponent<NameComponent>("original");
+
+    ASSERT_THROW(registry.Schedule(std::make_shared<IceFairy::JobSystem<const NameComponent>>(&registry, false)),
+        IceFairy::EntityRegistryException);
+    EXPECT_EQ(1, registry.GetEntityCount());
+}
+
+TEST(EntityRegistry, RunSystemsPlaysBackPerThreadCommandBuffers) {
+    IceFairy::EntityRegistry registry;
+    registry.SetWorkerCount(4);
+    registry.SetChunkSize(16);
+
+    for (int i = 0; i < 500; i++) {
+        registry.AddEntity().AddComponent<NameComponent>("entity");
+    }
+
+    registry.AddSystem(std::make_shared<IceFairy::JobSystem<const NameComponent>>(&registry, true),
+        IceFairy::EntityRegistry::EXECUTION_PARALLEL);
+    registry.RunSystems();
+
+    EXPECT_EQ(1000, registry.GetEntityCount());
+    EXPECT_EQ(1000, registry.View<NameComponent>().GetSize());
+    auto copies = registry.View<NameComponent, PositionComponent>();
+    EXPECT_EQ(500, copies.GetSize());
+}
+
+TEST(EntityRegistry, ScheduleSkipsUnchangedEntities) {
+    IceFairy::EntityRegistry registry;
+    std::vector<IceFairy::Entity> entities;
+
+    for (int i = 0; i < 100; i++) {
+        entities.push_back(registry.AddEntity());
+        entities.back().AddComponent<VelocityComponent>(1.0f, 1.0f);
+    }
+
+    auto counter = std::make_shared<IceFairy::JobSystem<const VelocityComponent>>();
+    auto lastRun = registry.Schedule(counter, IceFairy::EntityRegistry::EXECUTION_SERIAL, IceFairy::EntityRegistry::FILTER_CHANGED);
+    EXPECT_EQ(100, counter->numVisited);
+
+    counter->numVisited = 0;
+    lastRun = registry.Schedule(counter, IceFairy::EntityRegistry::EXECUTION_PARALLEL, IceFairy::EntityRegistry::FILTER_CHANGED, lastRun);
+    EXPECT_EQ(0, counter->numVisited);
+
+    entities[10].MarkChanged<VelocityComponent>();
+    entities[20].AddComponent<VelocityComponent>(2.0f, 2.0f);
+    registry.AddEntity().AddComponent<VelocityComponent>(3.0f, 3.0f);
+
+    auto addedCounter = std::make_shared<IceFairy::JobSystem<const VelocityComponent>>();
+    registry.Schedule(addedCounter, IceFairy::EntityRegistry::EXECUTION_SERIAL, IceFairy::EntityRegistry::FILTER_ADDED, lastRun);
+    EXPECT_EQ(1, addedCounter->numVisited);
+
+    registry.Schedule(counter, IceFairy::EntityRegistry::EXECUTION_SERIAL, IceFairy::EntityRegistry::FILTER_CHANGED, lastRun);
+    EXPECT_EQ(3, counter->numVisited);
+}
+
+TEST(EntityRegistry, SystemsMarkWrittenComponentsChanged) {
+    IceFairy::EntityRegistry registry;
+    auto entity = registry.AddEntity();
+    entity.AddComponent<PositionComponent>(0.0f, 0.0f);
+    entity.AddComponent<VelocityComponent>(1.0f, 1.0f);
+
+    auto before = registry.AdvanceTick();
+    EXPECT_FALSE(entity.IsChangedSince<PositionComponent>(before));
+
+    // Position is written, Velocity is only read
+    registry.Schedule(std::make_shared<IceFairy::JobSystem<VelocityComponent, const PositionComponent>>());
+    EXPECT_FALSE(entity.IsChangedSince<PositionComponent>(before));
+    EXPECT_TRUE(entity.IsChangedSince<VelocityComponent>(before));
+    EXPECT_FALSE(entity.IsAddedSince<VelocityComponent>(before));
+
+    // Ticks survive the entity moving archetype
+    entity.AddComponent<NameComponent>("moved");
+    EXPECT_TRUE(entity.IsChangedSince<VelocityComponent>(before));
+    EXPECT_FALSE(entity.IsChangedSince<PositionComponent>(before));
+    EXPECT_TRUE(entity.IsAddedSince<NameComponent>(before));
+}
+
+TEST(EntityRegistry, AddedSystemOnlySeesChangesSinceItsLastRun) {
+    IceFairy::EntityRegistry registry;
+    auto counter = std::make_shared<IceFairy::JobSystem<const VelocityComponent>>();
+
+    registry.AddSystem(counter, IceFairy::EntityRegistry::EXECUTION_SERIAL, IceFairy::EntityRegistry::FILTER_ADDED);
+    registry.AddEntity().AddComponent<VelocityComponent>(1.0f, 1.0f);
+
+    registry.RunSystems();
+    registry.RunSystems();
+    EXPECT_EQ(1, counter->numVisited);
+
+    registry.AddEntity().AddComponent<VelocityComponent>(1.0f, 1.0f);
+    registry.RunSystems();
+    EXPECT_EQ(2, counter->numVisited);
+}
+
+TEST(EntityRegistry, ViewEachChangedSince) {
+    IceFairy::EntityRegistry registry;
+
+    for (int i = 0; i < 10; i++) {
+        registry.AddEntity().AddComponent<PositionComponent>((float) i, 0.0f);
+    }
+
+    auto since = registry.AdvanceTick();
+    auto moved = registry.AddEntity();
+    moved.AddComponent<PositionComponent>(100.0f, 0.0f);
+
+    auto view = registry.View<PositionComponent>();
+    int numVisited = 0;
+
+    view.EachChangedSince(since, [&](PositionComponent& position) {
+        EXPECT_EQ(100.0f, position.x);
+        numVisited++;
+    });
+    EXPECT_EQ(1, numVisited);
+
+    numVisited = 0;
+    view.EachAddedSince(registry.AdvanceTick(), [&](PositionComponent& position) { numVisited++; });
+    EXPECT_EQ(0, numVisited);
+}
+
+TEST(EntityRegistry, AddEntitiesFromSpansAndGenerators) {
+    IceFairy::EntityRegistry registry;
+    auto removed = registry.AddEntity();
+    removed.Destroy();
+
+    std::vector<PositionComponent> positions;
+    for (int i = 0; i < 100; i++) {
+        positions.emplace_back((float) i, 0.0f);
+    }
+
+    auto view = registry.View<PositionComponent, NameComponent>();
+    auto ids = registry.AddEntities<PositionComponent, NameComponent>(positions.size(), positions,
+        [](size_t i) { return NameComponent("entity" + std::to_string(i)); });
+
+    ASSERT_EQ(100u, ids.size());
+    EXPECT_EQ(removed.GetId().index, ids[0].index);
+    EXPECT_EQ(100u, registry.GetEntityCount());
+    EXPECT_EQ(100u, view.GetSize());
+
+    for (size_t i = 0; i < ids.size(); i++) {
+        auto entity = registry.GetEntity(ids[i]);
+
+        EXPECT_EQ((float) i, entity.GetComponent<PositionComponent>().x);
+        EXPECT_EQ("entity" + std::to_string(i), entity.GetComponent<NameComponent>().name);
+    }
+}
+
+TEST(EntityRegistry, AddEntitiesFailsWithoutCreatingEntities) {
+    IceFairy::EntityRegistry registry;
+    std::vector<PositionComponent> positions(3, PositionComponent(1.0f, 1.0f));
+
+    ASSERT_THROW(registry.AddEntities<PositionComponent>(4, positions), IceFairy::EntityRegistryException);
+
+    auto throwingNames = [](size_t i) {
+        if (i == 2) {
+            throw std::runtime_error("generator failed");
+        }
+        return NameComponent("name");
+    };
+
+    ASSERT_THROW((registry.AddEntities<PositionComponent, NameComponent>(3, positions.data(), throwingNames)), std::runtime_error);
+    EXPECT_EQ(0u, registry.GetEntityCount());
+    EXPECT_EQ(0u, (registry.View<PositionComponent, NameComponent>().GetSize()));
+
+    auto ids = registry.AddEntities<PositionComponent>(3, positions.data());
+    EXPECT_EQ(3u, registry.GetEntityCount());
+    EXPECT_EQ(1.0f, registry.GetEntity(ids[2]).GetComponent<PositionComponent>().y);
+}
+
+TEST(EntityRegistry, LODSystemsRunEntitiesAtTheirRate) {
+    IceFairy::EntityRegistry registry;
+    std::vector<IceFairy::Entity> entities;
+
+    for (int i = 0; i < 16; i++) {
+        auto entity = registry.AddEntity();
+
+        entity.AddComponent<PositionComponent>(0.0f, 0.0f);
+        entity.AddComponent<VelocityComponent>(1.0f, 0.0f);
+        entity.AddComponent<IceFairy::SimulationLODComponent>(i < 4 ? IceFairy::LOD_FULL : IceFairy::LOD_QUARTER);
+        entities.push_back(entity);
+    }
+
+    auto noLOD = registry.AddEntity();
+    noLOD.AddComponent<PositionComponent>(0.0f, 0.0f);
+    noLOD.AddComponent<VelocityComponent>(1.0f, 0.0f);
+
+    registry.AddSystem(std::make_shared<IceFairy::JobSystem<PositionComponent, VelocityComponent>>(),
+        IceFairy::EntityRegistry::EXECUTION_PARALLEL, IceFairy::EntityRegistry::FILTER_NONE, IceFairy::EntityRegistry::RATE_LOD);
+
+    for (int i = 0; i < 8; i++) {
+        registry.RunSystems();
+    }
+
+    EXPECT_EQ(8u, registry.GetStep());
+    EXPECT_EQ(8.0f, noLOD.GetComponent<PositionComponent>().x);
+
+    for (int i = 0; i < 16; i++) {
+        EXPECT_EQ(i < 4 ? 8.0f : 2.0f, entities[i].GetComponent<PositionComponent>().x);
+    }
+}
+
+TEST(EntityRegistry, LODSpreadsEntitiesEvenlyAcrossSteps) {
+    IceFairy::EntityRegistry registry;
+    auto counter = std::make_shared<IceFairy::JobSystem<const VelocityComponent>>();
+
+    for (int i = 0; i < 64; i++) {
+        auto entity = registry.AddEntity();
+
+        entity.AddComponent<VelocityComponent>(1.0f, 0.0f);
+        entity.AddComponent<IceFairy::SimulationLODComponent>(IceFairy::LOD_EIGHTH);
+    }
+
+    registry.AddSystem(counter, IceFairy::EntityRegistry::EXECUTION_SERIAL, IceFairy::EntityRegistry::FILTER_NONE,
+        IceFairy::EntityRegistry::RATE_LOD);
+
+    for (int i = 0; i < 8; i++) {
+        registry.RunSystems();
+        EXPECT_EQ(8 * (i + 1), counter->numVisited);
+    }
+
+    // Without RATE_LOD the level is ignored
+    counter->numVisited = 0;
+    registry.Schedule(counter);
+    EXPECT_EQ(64, counter->numVisited);
+}
+
+TEST(EntityRegistry, LODCannotBeCombinedWithFilters) {
+    IceFairy::EntityRegistry registry;
+    auto counter = std::make_shared<IceFairy::JobSystem<const VelocityComponent>>();
+
+    ASSERT_THROW(registry.AddSystem(counter, IceFairy::EntityRegistry::EXECUTION_SERIAL, IceFairy::EntityRegistry::FILTER_CHANGED,
+        IceFairy::EntityRegistry::RATE_LOD), IceFairy::EntityRegistryException);
+    ASSERT_THROW(registry.Schedule(counter, IceFairy::EntityRegistry::EXECUTION_SERIAL, IceFairy::EntityRegistry::FILTER_ADDED, 0,
+        IceFairy::EntityRegistry::RATE_LOD), IceFairy::EntityRegistryException);
+}
+
+TEST(EntityRegistry, TagsOnlyLiveInTheMask) {
+    IceFairy::EntityRegistry registry;
+    auto entity = registry.AddEntity();
+
+    entity.AddComponent<PositionComponent>(1.0f, 2.0f);
+    entity.AddComponent<DeadTag>();
+
+    EXPECT_TRUE(IceFairy::IsTagComponent<DeadTag>::value);
+    EXPECT_FALSE(IceFairy::IsTagComponent<PositionComponent>::value);
+    EXPECT_TRUE(entity.HasComponent<DeadTag>());
+    EXPECT_EQ(1.0f, entity.GetComponent<PositionComponent>().x);
+    EXPECT_EQ(IceFairy::ComponentInfo::GetTag<DeadTag>(), &entity.GetComponent<DeadTag>());
+    ASSERT_THROW(entity.IsAddedSince<DeadTag>(0), IceFairy::EntityException);
+
+    auto archetype = registry.View<DeadTag>().GetArchetypes()[0];
+
+    EXPECT_EQ(nullptr, archetype->GetColumn(IceFairy::ComponentTypes::GetId<DeadTag>()));
+    EXPECT_EQ(sizeof(PositionComponent), archetype->GetUsedBytes());
+
+    entity.RemoveComponent<DeadTag>();
+    EXPECT_FALSE(entity.HasComponent<DeadTag>());
+    EXPECT_EQ(2.0f, entity.GetComponent<PositionComponent>().y);
+}
+
+TEST(EntityRegistry, TagsFromCommandBuffersPrefabsAndBulkAdds) {
+    IceFairy::EntityRegistry registry;
+    auto entity = registry.AddEntity();
+
+    auto& commands = registry.GetCommandBuffer();
+    commands.AddComponent<HiddenTag>(entity.GetId());
+    commands.AddComponent<PositionComponent>(commands.Spawn(), 1.0f, 1.0f);
+    registry.FlushCommandBuffers();
+    EXPECT_TRUE(entity.HasComponent<HiddenTag>());
+
+    entity.AddComponent<PositionComponent>(3.0f, 4.0f);
+    auto prefab = registry.CreatePrefab(entity.GetId());
+    EXPECT_TRUE(prefab.Has<HiddenTag>());
+
+    auto copies = registry.Instantiate(prefab, 3);
+    for (auto id : copies) {
+        EXPECT_TRUE(registry.GetEntity(id).HasComponent<HiddenTag>());
+        EXPECT_EQ(4.0f, registry.GetEntity(id).GetComponent<PositionComponent>().y);
+    }
+
+    auto added = registry.AddEntities<PositionComponent, DeadTag>(4, [](size_t i) { return PositionComponent((float) i, 0.0f); }, DeadTag());
+    EXPECT_EQ(3.0f, registry.GetEntity(added[3]).GetComponent<PositionComponent>().x);
+    EXPECT_TRUE(registry.GetEntity(added[3]).HasComponent<DeadTag>());
+    EXPECT_EQ(4, registry.View<DeadTag>().GetSize());
+}
+
+TEST(EntityRegistry, ViewsAndSystemsExcludeComponents) {
+    IceFairy::EntityRegistry registry;
+    std::vector<IceFairy::Entity> entities;
+
+    for (int i = 0; i < 6; i++) {
+        auto entity = registry.AddEntity();
+
+        entity.AddComponent<PositionComponent>(0.0f, 0.0f);
+        entity.AddComponent<VelocityComponent>(1.0f, 0.0f);
+        entities.push_back(entity);
+    }
+
+    entities[0].AddComponent<DeadTag>();
+    entities[1].AddComponent<HiddenTag>();
+
+    auto living = registry.View<PositionComponent>(IceFairy::Without<DeadTag>());
+    auto visible = registry.View<PositionComponent>(IceFairy::Without<DeadTag, HiddenTag>());
+    EXPECT_EQ(5, living.GetSize());
+    EXPECT_EQ(4, visible.GetSize());
+
+    entities[2].AddComponent<DeadTag>();
+    EXPECT_EQ(4, living.GetSize());
+    EXPECT_EQ(3, visible.GetSize());
+
+    int numDead = 0;
+    registry.View<PositionComponent, const DeadTag>().Each([&](PositionComponent& position, const DeadTag& dead) {
+        numDead++;
+    });
+    EXPECT_EQ(2, numDead);
+
+    registry.AddSystem(std::make_shared<IceFairy::JobSystem<PositionComponent, VelocityComponent>>(), IceFairy::Without<DeadTag>(),
+        IceFairy::EntityRegistry::EXECUTION_PARALLEL);
+    registry.RunSystems();
+
+    registry.Schedule(std::make_shared<IceFairy::JobSystem<PositionComponent, VelocityComponent>>(), IceFairy::Without<DeadTag, HiddenTag>());
+
+    EXPECT_EQ(0.0f, entities[0].GetComponent<PositionComponent>().x);
+    EXPECT_EQ(1.0f, entities[1].GetComponent<PositionComponent>().x);
+    EXPECT_EQ(0.0f, entities[2].GetComponent<PositionComponent>().x);
+    EXPECT_EQ(2.0f, entities[3].GetComponent<PositionComponent>().x);
+}
+
+TEST(EntityRegistry, TryGetAndGetDontThrow) {
+    IceFairy::EntityRegistry registry;
+    auto entity = registry.AddEntity();
+
+    entity.AddComponent<PositionComponent>(1.0f, 2.0f);
+    entity.AddComponent<DeadTag>();
+
+    ASSERT_NE(nullptr, entity.TryGet<PositionComponent>());
+    EXPECT_EQ(2.0f, entity.TryGet<PositionComponent>()->y);
+    EXPECT_EQ(nullptr, entity.TryGet<VelocityComponent>());
+    EXPECT_NE(nullptr, entity.TryGet<DeadTag>());
+    EXPECT_EQ(nullptr, entity.TryGet<HiddenTag>());
+
+    entity.Get<PositionComponent>().x = 5.0f;
+    EXPECT_EQ(5.0f, registry.Get<const PositionComponent>(entity.GetId()).x);
+    EXPECT_EQ(&entity.GetComponent<PositionComponent>(), registry.TryGet<PositionComponent>(entity.GetId()));
+
+    auto id = entity.GetId();
+    entity.Destroy();
+    EXPECT_EQ(nullptr, registry.TryGet<PositionComponent>(id));
+    EXPECT_EQ(nullptr, registry.TryGet<PositionComponent>(IceFairy::EntityId { 1000, 0 }));
+}
+
+TEST(EntityRegistry, CommandBufferOutlivesFirstParallelSchedule) {
+    IceFairy::EntityRegistry registry;
+    registry.SetWorkerCount(3);
+
+    auto entity = registry.AddEntity();
+    entity.AddComponent<PositionComponent>(0.0f, 0.0f);
+    entity.AddComponent<VelocityComponent>(1.0f, 1.0f);
+
+    // Creating the pool adds a buffer per worker, which mustn't move the one already handed out
+    auto& commands = registry.GetCommandBuffer();
+    registry.Schedule(std::make_shared<IceFairy::JobSystem<PositionComponent, VelocityComponent>>(),
+        IceFairy::EntityRegistry::EXECUTION_PARALLEL);
+
+    commands.Destroy(entity.GetId());
+    EXPECT_EQ(&commands, &registry.GetCommandBuffer());
+
+    registry.FlushCommandBuffers();
+    EXPECT_FALSE(registry.IsAlive(entity.GetId()));
+}
@@ -0,0 +1,34 @@
+#ifndef __ice_fairy_tests_entity_registry_test_h__
+#define __ice_fairy_tests_entity_registry_test_h__
+
+#include <memory>
+#include <atomic>
+
+#include "gtest\gtest.h"
+#include "ecs\entityregistry.h"
+
+struct PositionComponent : public IceFairy::Component {
+    PositionComponent(float x, float y) : x(x), y(y) { }
+
+    float x;
+    float y;
+};
+
+struct VelocityComponent : public IceFairy::Component {
+    VelocityComponent(float x, float y) : x(x), y(y) { }
+
+    float x;
+    float y;
+};
+
+struct NameComponent : public IceFairy::Component {
+    NameComponent(const std::string& name) : name(name) { }
+
+    std::string name;
+};
+
+struct DeadTag : public IceFairy::Component { };
+
+struct HiddenTag : public IceFairy::Component { };
+
+#endif /* __ice_fairy_tests_entity_registry_test_h__ */
@@ -0,0 +1,162 @@
+#include "eventBusTest.h"
+
+using IceFairy::MPSCQueue;
+using IceFairy::EventBus;
+
+TEST(MPSCQueue, PushAndPopInOrder) {
+    MPSCQueue<int> queue(3);
+
+    EXPECT_EQ(4u, queue.GetCapacity());
+    EXPECT_TRUE(queue.IsEmpty());
+
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(queue.TryPush(i));
+    }
+    EXPECT_FALSE(queue.TryPush(4));
+
+    int value;
+    for (int i = 0; i < 4; i++) {
+        ASSERT_TRUE(queue.TryPop(value));
+        EXPECT_EQ(i, value);
+    }
+    EXPECT_FALSE(queue.TryPop(value));
+    EXPECT_TRUE(queue.IsEmpty());
+}
+
+TEST(MPSCQueue, FailedPushLeavesValue) {
+    MPSCQueue<std::unique_ptr<int>> queue(2);
+    queue.TryPush(std::make_unique<int>(1));
+    queue.TryPush(std::make_unique<int>(2));
+
+    auto value = std::make_unique<int>(3);
+    EXPECT_FALSE(queue.TryPush(std::move(value)));
+    ASSERT_NE(nullptr, value);
+    EXPECT_EQ(3, *value);
+}
+
+TEST(MPSCQueue, ConcurrentProducers) {
+    const int numProducers = 4;
+    const int numPerProducer = 20000;
+    MPSCQueue<std::pair<int, int>> queue(256);
+    std::vector<std::thread> producers;
+
+    for (int producer = 0; producer < numProducers; producer++) {
+        producers.emplace_back([&queue, producer, numPerProducer]() {
+            for (int i = 0; i < numPerProducer; i++) {
+                while (!queue.TryPush(std::make_pair(producer, i))) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::vector<int> nextExpected(numProducers, 0);
+    int numConsumed = 0;
+
+    while (numConsumed < numProducers * numPerProducer) {
+        numConsumed += (int) queue.ConsumeAll([&](std::pair<int, int>& element) {
+            EXPECT_EQ(nextExpected[element.first], element.second);
+            nextExpected[element.first] = element.second + 1;
+        });
+    }
+
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    EXPECT_TRUE(queue.IsEmpty());
+    for (int producer = 0; producer < numProducers; producer++) {
+        EXPECT_EQ(numPerProducer, nextExpected[producer]);
+    }
+}
+
+TEST(EventBus, EmitAndDrainByType) {
+    EventBus events;
+
+    events.Emit(DamageEvent { 1, 10 });
+    events.Emit(SpawnEvent { "orc" });
+    events.Emit(DamageEvent { 2, 20 });
+
+    int totalDamage = 0;
+    EXPECT_EQ(2u, events.Drain<DamageEvent>([&](const DamageEvent& damage) { totalDamage += damage.amount; }));
+    EXPECT_EQ(30, totalDamage);
+    EXPECT_EQ(0u, events.Drain<DamageEvent>([&](const DamageEvent& damage) { totalDamage += damage.amount; }));
+
+    std::vector<std::string> spawned;
+    events.Drain<SpawnEvent>([&](const SpawnEvent& spawn) { spawned.push_back(spawn.name); });
+    ASSERT_EQ(1u, spawned.size());
+    EXPECT_EQ("orc", spawned[0]);
+}
+
+TEST(EventBus, OverflowIsNotDropped) {
+    EventBus events(4);
+
+    for (int i = 0; i < 10; i++) {
+        events.Emit(DamageEvent { i, 1 });
+    }
+
+    std::vector<int> targets;
+    EXPECT_EQ(10u, events.Drain<DamageEvent>([&](const DamageEvent& damage) { targets.push_back(damage.target); }));
+    EXPECT_EQ(6u, events.GetOverflowCount<DamageEvent>());
+
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(i, targets[i]);
+    }
+}
+
+TEST(EventBus, EventsEmittedWhileDrainingWaitForNextDrain) {
+    EventBus events;
+    events.Emit(DamageEvent { 0, 1 });
+
+    auto numDrained = events.Drain<DamageEvent>([&](const DamageEvent& damage) {
+        events.Emit(DamageEvent { damage.target + 1, 1 });
+    });
+
+    EXPECT_EQ(1u, numDrained);
+    EXPECT_EQ(1u, events.Drain<DamageEvent>([](const DamageEvent& damage) { EXPECT_EQ(1, damage.target); }));
+}
+
+TEST(EventBus, RegistryDispatchesEventsFromWorkers) {
+    IceFairy::EntityRegistry registry;
+    IceFairy::ThreadPool pool(4);
+    int totalDamage = 0;
+
+    registry.AddEventHandler<DamageEvent>([&](const DamageEvent& damage) {
+        // Handlers may make structural changes
+        registry.AddEntity();
+        totalDamage += damage.amount;
+    });
+
+    pool.ParallelFor(1000, 16, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            registry.GetEvents().Emit(DamageEvent { (int) i, 2 });
+        }
+    });
+
+    registry.RunSystems();
+    EXPECT_EQ(2000, totalDamage);
+    EXPECT_EQ(1000u, registry.GetEntityCount());
+}
+
+TEST(EventBus, EveryHandlerOfATypeSeesEveryEvent) {
+    IceFairy::EntityRegistry registry;
+    std::vector<std::string> calls;
+
+    registry.AddEventHandler<DamageEvent>([&](const DamageEvent& damage) {
+        calls.push_back("first " + std::to_string(damage.amount));
+    });
+    registry.AddEventHandler<SpawnEvent>([&](const SpawnEvent& spawn) {
+        calls.push_back("spawn " + spawn.name);
+    });
+    registry.AddEventHandler<DamageEvent>([&](const DamageEvent& damage) {
+        calls.push_back("second " + std::to_string(damage.amount));
+    });
+
+    registry.GetEvents().Emit(DamageEvent { 1, 10 });
+    registry.GetEvents().Emit(SpawnEvent { "orc" });
+    registry.GetEvents().Emit(DamageEvent { 2, 20 });
+    registry.DispatchEvents();
+
+    std::vector<std::string> expected { "first 10", "second 10", "first 20", "second 20", "spawn orc" };
+    EXPECT_EQ(expected, calls);
+}
@@ -0,0 +1,25 @@
+#ifndef __ice_fairy_tests_event_bus_test_h__
+#define __ice_fairy_tests_event_bus_test_h__
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest\gtest.h"
+#include "core\utilities\mpscqueue.h"
+#include "core\utilities\threadpool.h"
+#include "ecs\eventbus.h"
+#include "ecs\entityregistry.h"
+
+struct DamageEvent {
+    int target;
+    int amount;
+};
+
+struct SpawnEvent {
+    std::string name;
+};
+
+#endif /* __ice_fairy_tests_event_bus_test_h__ */
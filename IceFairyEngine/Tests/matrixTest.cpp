@@ -199,4 +199,73 @@ TEST(Matrix4, Rotate) {
     IceFairy::Matrix4f m = IceFairy::Matrix4f::Rotate(90.0f, 0, 0, 1);
 
     V3M_FuzzyFloatMatch(IceFairy::Vector3f(1, 0, 0), m * IceFairy::Vector3f(0, 1, 0));
-}
\ No newline at end of file
+}
+
+static IceFairy::Matrix4f ToMatrix4f(const IceFairy::Matrix4d& m) {
+    float vals[16];
+
+    for (int i = 0; i < 16; i++) {
+        vals[i] = (float) m.v[i];
+    }
+
+    return IceFairy::Matrix4f(vals);
+}
+
+TEST(Matrix4, MatrixMultiplicationMatchesDouble) {
+    // Float products take the SIMD path where there is one, doubles always take the scalar one
+    IceFairy::Matrix4d a(
+        1,  -2, 3,  0,
+        4,  5,  -6, 2,
+        7,  8,  7,  3,
+        -9, 2,  3,  1);
+    IceFairy::Matrix4d b(
+        2,  0,  1,  5,
+        -1, 3,  4,  0,
+        6,  -2, 1,  1,
+        0,  7,  -3, 2);
+
+    M4_Match(ToMatrix4f(a * b), ToMatrix4f(a) * ToMatrix4f(b));
+    M4_Match(ToMatrix4f(b * a), ToMatrix4f(b) * ToMatrix4f(a));
+
+    IceFairy::Matrix4d transform = IceFairy::Matrix4d::Translate(1.5, -2, 3)
+        * IceFairy::Matrix4d::Rotate(30, 0, 1, 0)
+        * IceFairy::Matrix4d::Scale(2, 0.5, 4);
+    IceFairy::Matrix4f transformf = IceFairy::Matrix4f::Translate(1.5f, -2, 3)
+        * IceFairy::Matrix4f::Rotate(30, 0, 1, 0)
+        * IceFairy::Matrix4f::Scale(2, 0.5f, 4);
+
+    M4_FuzzyMatch(ToMatrix4f(transform), transformf);
+}
+
+TEST(Matrix4, InverseMatchesDouble) {
+    IceFairy::Matrix4d m(
+        1,  -2, 3,  0,
+        4,  5,  -6, 2,
+        7,  8,  7,  3,
+        -9, 2,  3,  1);
+    IceFairy::Matrix4d transform = IceFairy::Matrix4d::Translate(1.5, -2, 3)
+        * IceFairy::Matrix4d::Rotate(30, 0, 1, 0)
+        * IceFairy::Matrix4d::Scale(2, 0.5, 4);
+
+    M4_FuzzyMatch(ToMatrix4f(m.Inverse()), ToMatrix4f(m).Inverse());
+    M4_FuzzyMatch(ToMatrix4f(transform.Inverse()), ToMatrix4f(transform).Inverse());
+    M4_FuzzyMatch(IceFairy::Matrix4f::Identity(), ToMatrix4f(transform) * ToMatrix4f(transform).Inverse());
+}
+
+TEST(Matrix4, ConstantExpressions) {
+    // Float products and inverses take a SIMD path at runtime, but must still fold
+    constexpr IceFairy::Matrix4f transform = IceFairy::Matrix4f::Translate(1, 2, 3) * IceFairy::Matrix4f::Scale(2, 2, 2);
+    constexpr IceFairy::Matrix4f inverse = transform.Inverse();
+    constexpr IceFairy::Matrix4f ortho = IceFairy::Matrix4f::Ortho(0, 800, 0, 600, -1, 1);
+    constexpr IceFairy::Matrix3d m3 = IceFairy::Matrix3d::Identity() + IceFairy::Matrix3d::Identity();
+
+    static_assert(transform * IceFairy::Vector4f(1, 1, 1, 1) == IceFairy::Vector4f(3, 4, 5, 1), "Matrix4 products should fold at compile time");
+    static_assert(inverse * IceFairy::Vector4f(3, 4, 5, 1) == IceFairy::Vector4f(1, 1, 1, 1), "Matrix4 inverses should fold at compile time");
+    static_assert(ortho * IceFairy::Vector4f(800, 600, 0, 1) == IceFairy::Vector4f(1, 1, 0, 1), "Ortho should fold at compile time");
+    static_assert(m3.Inverse().Val(1, 1) == 0.5, "Matrix3 inverses should fold at compile time");
+    static_assert(std::is_trivially_copyable<IceFairy::Matrix3f>::value, "Matrix3 should be trivially copyable");
+    static_assert(std::is_trivially_copyable<IceFairy::Matrix4f>::value, "Matrix4 should be trivially copyable");
+
+    M4_Match(IceFairy::Matrix4f::Translate(1, 2, 3) * IceFairy::Matrix4f::Scale(2, 2, 2), transform);
+    M4_FuzzyMatch(IceFairy::Matrix4f::Identity(), transform * inverse);
+}
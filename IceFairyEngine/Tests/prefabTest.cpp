@@ -0,0 +1,98 @@
+#include "prefabTest.h"
+
+using IceFairy::Prefab;
+
+namespace {
+    struct UniqueComponent : public IceFairy::Component {
+        std::unique_ptr<int> value;
+    };
+
+    struct FragileComponent : public IceFairy::Component {
+        FragileComponent(void) { }
+
+        FragileComponent(const FragileComponent& other) {
+            if (++numCopies == 3) {
+                throw std::runtime_error("copy failed");
+            }
+        }
+
+        static int numCopies;
+    };
+
+    int FragileComponent::numCopies = 0;
+}
+
+TEST(Prefab, SetAndGet) {
+    Prefab prefab;
+
+    prefab.Set<PositionComponent>(1.0f, 2.0f).Set<NameComponent>("first");
+    prefab.Set<NameComponent>("second");
+
+    EXPECT_TRUE(prefab.Has<PositionComponent>());
+    EXPECT_FALSE(prefab.Has<VelocityComponent>());
+    EXPECT_EQ(2.0f, prefab.Get<PositionComponent>().y);
+    EXPECT_EQ("second", prefab.Get<NameComponent>().name);
+    EXPECT_EQ((IceFairy::ComponentTypes::GetMask<PositionComponent, NameComponent>()), prefab.GetMask());
+
+    prefab.Remove<PositionComponent>();
+    EXPECT_FALSE(prefab.Has<PositionComponent>());
+    ASSERT_THROW(prefab.Get<PositionComponent>(), IceFairy::PrefabException);
+    ASSERT_THROW(prefab.Set<UniqueComponent>(), IceFairy::PrefabException);
+}
+
+TEST(Prefab, InstantiateCopiesEveryComponent) {
+    IceFairy::EntityRegistry registry;
+    Prefab prefab;
+    prefab.Set<PositionComponent>(3.0f, 4.0f).Set<NameComponent>("bullet");
+
+    auto view = registry.View<PositionComponent, NameComponent>();
+    auto ids = registry.Instantiate(prefab, 1000);
+
+    ASSERT_EQ(1000u, ids.size());
+    EXPECT_EQ(1000u, view.GetSize());
+
+    for (auto id : ids) {
+        auto entity = registry.GetEntity(id);
+
+        EXPECT_EQ(3.0f, entity.GetComponent<PositionComponent>().x);
+        EXPECT_EQ(4.0f, entity.GetComponent<PositionComponent>().y);
+        EXPECT_EQ("bullet", entity.GetComponent<NameComponent>().name);
+    }
+
+    // Instances don't share state with each other or the prefab
+    registry.GetEntity(ids[0]).GetComponent<NameComponent>().name = "changed";
+    EXPECT_EQ("bullet", registry.GetEntity(ids[1]).GetComponent<NameComponent>().name);
+    EXPECT_EQ("bullet", prefab.Get<NameComponent>().name);
+}
+
+TEST(Prefab, CreateFromEntity) {
+    IceFairy::EntityRegistry registry;
+    auto entity = registry.AddEntity();
+    entity.AddComponent<PositionComponent>(5.0f, 6.0f);
+    entity.AddComponent<NameComponent>("template");
+
+    auto prefab = registry.CreatePrefab(entity.GetId());
+    EXPECT_EQ(entity.GetComponentMask(), prefab.GetMask());
+    entity.Destroy();
+
+    EXPECT_EQ("template", prefab.Get<NameComponent>().name);
+
+    auto ids = registry.Instantiate(prefab, 2);
+    EXPECT_EQ(5.0f, registry.GetEntity(ids[1]).GetComponent<PositionComponent>().x);
+    ASSERT_THROW(registry.CreatePrefab(entity.GetId()), IceFairy::EntityRegistryException);
+}
+
+TEST(Prefab, FailedInstantiateCreatesNoEntities) {
+    IceFairy::EntityRegistry registry;
+    Prefab prefab;
+    prefab.Set<PositionComponent>(0.0f, 0.0f);
+    prefab.Set<FragileComponent>();
+
+    FragileComponent::numCopies = 0;
+    ASSERT_THROW(registry.Instantiate(prefab, 5), std::runtime_error);
+    EXPECT_EQ(0u, registry.GetEntityCount());
+
+    auto ids = registry.Instantiate(prefab, 2);
+    EXPECT_EQ(2u, registry.GetEntityCount());
+    EXPECT_TRUE(registry.GetEntity(ids[1]).HasComponent<FragileComponent>());
+}
@@ -0,0 +1,12 @@
+#ifndef __ice_fairy_tests_prefab_test_h__
+#define __ice_fairy_tests_prefab_test_h__
+
+#include <memory>
+#include <stdexcept>
+
+#include "gtest\gtest.h"
+#include "ecs\prefab.h"
+#include "ecs\entityregistry.h"
+#include "entityRegistryTest.h"
+
+#endif /* __ice_fairy_tests_prefab_test_h__ */
@@ -0,0 +1,98 @@
+#include "quaternionTest.h"
+
+// q and -q are the same rotation, so compare the rotations rather than the components
+static void Q_RotationMatch(IceFairy::Quaternionf expected, IceFairy::Quaternionf actual) {
+    EXPECT_NEAR(1.0f, std::fabs(expected.Dot(actual)), 1e-5f);
+}
+
+TEST(Quaternion, AxisAngleMatchesMatrixRotate) {
+    IceFairy::Vector3f diagonal = IceFairy::Vector3f(1, 2, -3).Normalise();
+
+    M4_FuzzyMatch(IceFairy::Matrix4f::Rotate(90.0f, 1, 0, 0), IceFairy::Quaternionf::AxisAngle(90.0f, 1, 0, 0).ToMatrix4());
+    M4_FuzzyMatch(IceFairy::Matrix4f::Rotate(-30.0f, 0, 1, 0), IceFairy::Quaternionf::AxisAngle(-30.0f, 0, 1, 0).ToMatrix4());
+    M4_FuzzyMatch(IceFairy::Matrix4f::Rotate(200.0f, diagonal), IceFairy::Quaternionf::AxisAngle(200.0f, diagonal).ToMatrix4());
+    M4_FuzzyMatch(IceFairy::Matrix4f::Rotate(200.0f, diagonal), IceFairy::Matrix4f::Rotate(IceFairy::Quaternionf::AxisAngle(200.0f, diagonal)));
+}
+
+TEST(Quaternion, RotateVector) {
+    IceFairy::Quaternionf q = IceFairy::Quaternionf::AxisAngle(90.0f, 0, 0, 1);
+    IceFairy::Matrix4f m = IceFairy::Matrix4f::Rotate(90.0f, 0, 0, 1);
+
+    V3M_FuzzyFloatMatch(m * IceFairy::Vector3f(0, 1, 0), q.Rotate(IceFairy::Vector3f(0, 1, 0)));
+    V3M_FuzzyFloatMatch(m * IceFairy::Vector3f(1, 2, 3), q * IceFairy::Vector3f(1, 2, 3));
+}
+
+TEST(Quaternion, MultiplicationComposesLikeMatrices) {
+    IceFairy::Vector3f axis = IceFairy::Vector3f(1, 1, 0).Normalise();
+    IceFairy::Quaternionf pitch = IceFairy::Quaternionf::AxisAngle(30.0f, 1, 0, 0);
+    IceFairy::Quaternionf yaw = IceFairy::Quaternionf::AxisAngle(75.0f, axis);
+
+    M4_FuzzyMatch(
+        IceFairy::Matrix4f::Rotate(30.0f, 1, 0, 0) * IceFairy::Matrix4f::Rotate(75.0f, axis),
+        (pitch * yaw).ToMatrix4());
+
+    // Float products take the SIMD path where there is one, doubles always take the scalar one
+    IceFairy::Quaterniond pitchd(pitch.x, pitch.y, pitch.z, pitch.w);
+    IceFairy::Quaterniond yawd(yaw.x, yaw.y, yaw.z, yaw.w);
+    IceFairy::Quaterniond productd = yawd * pitchd;
+    IceFairy::Quaternionf product = yaw * pitch;
+
+    EXPECT_NEAR(productd.x, product.x, 1e-6f);
+    EXPECT_NEAR(productd.y, product.y, 1e-6f);
+    EXPECT_NEAR(productd.z, product.z, 1e-6f);
+    EXPECT_NEAR(productd.w, product.w, 1e-6f);
+
+    IceFairy::Quaternionf composed = pitch;
+    composed *= yaw;
+    Q_RotationMatch(pitch * yaw, composed);
+}
+
+TEST(Quaternion, Inverse) {
+    IceFairy::Quaternionf q = IceFairy::Quaternionf::AxisAngle(123.0f, IceFairy::Vector3f(3, -1, 2).Normalise());
+
+    Q_RotationMatch(IceFairy::Quaternionf::Identity(), q * q.Inverse());
+    Q_RotationMatch(q.Conjugate(), q.Inverse());
+}
+
+TEST(Quaternion, FromMatrix) {
+    // Half turns about each axis take every branch of the conversion
+    IceFairy::Quaternionf rotations[] = {
+        IceFairy::Quaternionf::AxisAngle(40.0f, IceFairy::Vector3f(1, 2, 3).Normalise()),
+        IceFairy::Quaternionf::AxisAngle(180.0f, 1, 0, 0),
+        IceFairy::Quaternionf::AxisAngle(180.0f, 0, 1, 0),
+        IceFairy::Quaternionf::AxisAngle(180.0f, 0, 0, 1)
+    };
+
+    for (auto& q : rotations) {
+        Q_RotationMatch(q, IceFairy::Quaternionf::FromMatrix(q.ToMatrix3()));
+        Q_RotationMatch(q, IceFairy::Quaternionf::FromMatrix(q.ToMatrix4() * IceFairy::Matrix4f::Translate(1, 2, 3)));
+    }
+}
+
+TEST(Quaternion, Interpolation) {
+    IceFairy::Quaternionf start = IceFairy::Quaternionf::Identity();
+    IceFairy::Quaternionf end = IceFairy::Quaternionf::AxisAngle(90.0f, 0, 1, 0);
+
+    Q_RotationMatch(start, IceFairy::Quaternionf::Slerp(start, end, 0.0f));
+    Q_RotationMatch(end, IceFairy::Quaternionf::Slerp(start, end, 1.0f));
+    Q_RotationMatch(IceFairy::Quaternionf::AxisAngle(22.5f, 0, 1, 0), IceFairy::Quaternionf::Slerp(start, end, 0.25f));
+    Q_RotationMatch(IceFairy::Quaternionf::AxisAngle(45.0f, 0, 1, 0), IceFairy::Quaternionf::Nlerp(start, end, 0.5f));
+
+    // Both take the shortest way round, whichever sign the end rotation has
+    Q_RotationMatch(IceFairy::Quaternionf::AxisAngle(45.0f, 0, 1, 0), IceFairy::Quaternionf::Slerp(start, -end, 0.5f));
+    Q_RotationMatch(IceFairy::Quaternionf::AxisAngle(45.0f, 0, 1, 0), IceFairy::Quaternionf::Nlerp(start, -end, 0.5f));
+
+    // Nearly equal rotations fall back to Nlerp rather than dividing by sin(theta) ~ 0
+    IceFairy::Quaternionf nearEnd = IceFairy::Quaternionf::AxisAngle(90.01f, 0, 1, 0);
+    EXPECT_NEAR(1.0f, IceFairy::Quaternionf::Slerp(end, nearEnd, 0.5f).Length(), 1e-5f);
+}
+
+TEST(Quaternion, ConstantExpressions) {
+    constexpr IceFairy::Quaternionf i(1, 0, 0, 0);
+    constexpr IceFairy::Quaternionf j(0, 1, 0, 0);
+
+    static_assert(i * j == IceFairy::Quaternionf(0, 0, 1, 0), "Products should fold at compile time");
+    static_assert(i.ToMatrix4().Val(1, 1) == -1, "Matrix conversions should fold at compile time");
+
+    EXPECT_EQ(IceFairy::Quaternionf(0, 0, -1, 0), j * i);
+}
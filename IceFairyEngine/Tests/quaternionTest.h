@@ -0,0 +1,7 @@
+#ifndef __ice_fairy_tests_quaternion_test_h__
+#define __ice_fairy_tests_quaternion_test_h__
+
+#include "common.h"
+#include "math\quaternion.h"
+
+#endif /* __ice_fairy_tests_quaternion_test_h__ */
@@ -0,0 +1,150 @@
+#include "simulationLoopTest.h"
+
+namespace IceFairy {
+    template <>
+    class JobSystem<StepCounterComponent> {
+    public:
+        void Execute(StepCounterComponent& counter) {
+            counter.numSteps++;
+        }
+    };
+}
+
+namespace {
+    struct SimulationLoopFixture : public testing::Test {
+        SimulationLoopFixture() :
+            loop(registry.GetLoop()),
+            counter(registry.AddEntity()) {
+            counter.AddComponent<StepCounterComponent>();
+            registry.AddSystem(std::make_shared<IceFairy::JobSystem<StepCounterComponent>>());
+
+            loop.SetClock([this]() { return now; });
+            loop.SetFixedStep(0.01);
+            loop.SetFrameBudget(0.016);
+        }
+
+        int GetSteps(void) {
+            return counter.GetComponent<StepCounterComponent>().numSteps;
+        }
+
+        IceFairy::EntityRegistry registry;
+        IceFairy::SimulationLoop& loop;
+        IceFairy::Entity counter;
+        double now = 0.0;
+    };
+}
+
+TEST_F(SimulationLoopFixture, RunsWholeFixedSteps) {
+    loop.Frame(0.025);
+    EXPECT_EQ(2, GetSteps());
+    EXPECT_EQ(2u, loop.GetStepsLastFrame());
+    EXPECT_NEAR(0.5, loop.GetAlpha(), 1e-9);
+
+    loop.Frame(0.004);
+    EXPECT_EQ(2, GetSteps());
+    EXPECT_NEAR(0.9, loop.GetAlpha(), 1e-9);
+
+    loop.Frame(0.001);
+    EXPECT_EQ(3, GetSteps());
+    EXPECT_EQ(3u, loop.GetStepCount());
+    EXPECT_NEAR(0.0, loop.GetAlpha(), 1e-9);
+}
+
+TEST_F(SimulationLoopFixture, DropsBacklogBeyondMaxSteps) {
+    loop.SetMaxStepsPerFrame(4);
+    loop.Frame(1.0);
+
+    EXPECT_EQ(4, GetSteps());
+    EXPECT_LT(loop.GetAlpha(), 1.0);
+
+    loop.Frame(0.0);
+    EXPECT_EQ(4, GetSteps());
+}
+
+TEST_F(SimulationLoopFixture, FixedStepStaysPositive) {
+    for (double step : { 0.0, -1.0, std::numeric_limits<double>::quiet_NaN() }) {
+        loop.SetFixedStep(step);
+        EXPECT_EQ(IceFairy::SimulationLoop::MIN_FIXED_STEP, loop.GetFixedStep());
+    }
+
+    loop.Frame(0.001);
+    EXPECT_GE(loop.GetAlpha(), 0.0);
+    EXPECT_LT(loop.GetAlpha(), 1.0);
+}
+
+TEST_F(SimulationLoopFixture, InvalidFrameTimesAreIgnored) {
+    for (double elapsed : { -1.0, std::numeric_limits<double>::quiet_NaN() }) {
+        loop.Frame(elapsed);
+        EXPECT_EQ(0, GetSteps());
+        EXPECT_EQ(0.0, loop.GetAlpha());
+    }
+
+    loop.Frame(0.015);
+    EXPECT_EQ(1, GetSteps());
+    EXPECT_NEAR(0.5, loop.GetAlpha(), 1e-9);
+}
+
+TEST_F(SimulationLoopFixture, SlicedTasksStopAtTheBudget) {
+    int numUnits = 0;
+
+    // Every unit takes 5ms, so a 16ms budget fits 4 before the deadline is checked again
+    loop.AddSlicedTask([&]() {
+        now += 0.005;
+        return ++numUnits < 10;
+    });
+    EXPECT_EQ(1u, loop.GetSlicedTaskCount());
+
+    loop.Frame(0.0);
+    EXPECT_EQ(4, numUnits);
+    EXPECT_EQ(4u, loop.GetSlicesLastFrame());
+
+    loop.Frame(0.0);
+    EXPECT_EQ(8, numUnits);
+
+    loop.Frame(0.0);
+    EXPECT_EQ(10, numUnits);
+    EXPECT_EQ(0u, loop.GetSlicedTaskCount());
+}
+
+TEST_F(SimulationLoopFixture, SlicedTasksTakeTurnsAndAlwaysProgress) {
+    std::vector<int> order;
+
+    loop.AddSlicedTask([&]() {
+        order.push_back(0);
+        return true;
+    });
+    loop.AddSlicedTask([&]() {
+        order.push_back(1);
+        // Adding a task from inside a task is picked up on the next turn
+        if (order.size() == 2) {
+            loop.AddSlicedTask([&]() {
+                order.push_back(2);
+                return false;
+            });
+        }
+        return true;
+    });
+
+    // The budget is already spent, but one unit still runs
+    loop.SetFrameBudget(0.0);
+    loop.Frame(0.0);
+    loop.Frame(0.0);
+    loop.Frame(0.0);
+    loop.Frame(0.0);
+
+    std::vector<int> expected { 0, 1, 2, 0 };
+    EXPECT_EQ(expected, order);
+    EXPECT_EQ(2u, loop.GetSlicedTaskCount());
+}
+
+TEST_F(SimulationLoopFixture, StartEntityLoopRunsUntilStopped) {
+    int numFrames = 0;
+
+    registry.StartEntityLoop([&]() {
+        now += 0.01;
+        return ++numFrames <= 5;
+    });
+
+    // The first frame only starts the clock
+    EXPECT_EQ(4, GetSteps());
+}
@@ -0,0 +1,15 @@
+#ifndef __ice_fairy_tests_simulation_loop_test_h__
+#define __ice_fairy_tests_simulation_loop_test_h__
+
+#include <vector>
+#include <limits>
+
+#include "gtest\gtest.h"
+#include "ecs\simulationloop.h"
+#include "ecs\entityregistry.h"
+
+struct StepCounterComponent : public IceFairy::Component {
+    int numSteps = 0;
+};
+
+#endif /* __ice_fairy_tests_simulation_loop_test_h__ */
@@ -0,0 +1,222 @@
+#include "spatialIndexTest.h"
+
+using IceFairy::AABB;
+using IceFairy::AABBTree;
+using IceFairy::EntityId;
+using IceFairy::SpatialIndex;
+using IceFairy::Vector3f;
+
+namespace {
+    std::vector<EntityId> SpawnRandom(IceFairy::EntityRegistry& registry, size_t count, std::mt19937& random) {
+        std::uniform_real_distribution<float> coordinate(-50.0f, 50.0f);
+        std::uniform_real_distribution<float> extent(0.1f, 2.0f);
+
+        return registry.AddEntities<IceFairy::PositionComponent, IceFairy::BoundsComponent>(count,
+            [&](size_t) { return IceFairy::PositionComponent(Vector3f(coordinate(random), coordinate(random), coordinate(random))); },
+            [&](size_t) { return IceFairy::BoundsComponent(Vector3f(extent(random), extent(random), extent(random))); });
+    }
+
+    AABB GetBounds(IceFairy::EntityRegistry& registry, EntityId id) {
+        auto entity = registry.GetEntity(id);
+
+        return AABB::FromCentre(entity.GetComponent<IceFairy::PositionComponent>().position,
+            entity.GetComponent<IceFairy::BoundsComponent>().halfExtents);
+    }
+
+    std::vector<EntityId> Sorted(std::vector<EntityId> ids) {
+        std::sort(ids.begin(), ids.end(), [](const EntityId& a, const EntityId& b) { return a.index < b.index; });
+        return ids;
+    }
+}
+
+TEST(SpatialIndex, TreeStaysBalanced) {
+    AABBTree tree(0.0f);
+    std::vector<int32_t> leaves;
+
+    // Inserting along a line is the worst case for an unbalanced tree
+    for (uint32_t i = 0; i < 1024; i++) {
+        leaves.push_back(tree.Insert(AABB(Vector3f((float) i), Vector3f((float) i + 0.5f)), i));
+    }
+
+    EXPECT_EQ(1024u, tree.GetLeafCount());
+    EXPECT_LE(tree.GetHeight(), 20);
+
+    for (size_t i = 0; i < leaves.size(); i += 2) {
+        tree.Remove(leaves[i]);
+    }
+
+    std::vector<uint32_t> found;
+    tree.Query(AABB(Vector3f(-1.0f), Vector3f(2000.0f)), [&](uint32_t value) { found.push_back(value); });
+
+    EXPECT_EQ(512u, found.size());
+    for (auto value : found) {
+        EXPECT_EQ(1u, value % 2);
+    }
+}
+
+TEST(SpatialIndex, QueriesMatchBruteForce) {
+    IceFairy::EntityRegistry registry;
+    std::mt19937 random(7);
+    auto ids = SpawnRandom(registry, 2000, random);
+
+    SpatialIndex index(4.0f);
+    index.Update(registry);
+    EXPECT_EQ(ids.size(), index.GetSize());
+
+    std::uniform_real_distribution<float> coordinate(-50.0f, 50.0f);
+
+    for (int query = 0; query < 50; query++) {
+        Vector3f centre(coordinate(random), coordinate(random), coordinate(random));
+        // Small radii use the grid, large ones the tree
+        float radius = query % 2 == 0 ? 3.0f : 40.0f;
+        AABB box = AABB::FromCentre(centre, Vector3f(5.0f, 10.0f, 2.0f));
+
+        std::vector<EntityId> expectedRadius;
+        std::vector<EntityId> expectedBox;
+        for (auto id : ids) {
+            auto bounds = GetBounds(registry, id);
+
+            if (bounds.DistanceSQ(centre) <= radius * radius) {
+                expectedRadius.push_back(id);
+            }
+            if (bounds.Overlaps(box)) {
+                expectedBox.push_back(id);
+            }
+        }
+
+        std::vector<EntityId> foundRadius;
+        std::vector<EntityId> foundBox;
+        index.QueryRadius(centre, radius, foundRadius);
+        index.QueryAABB(box, foundBox);
+
+        EXPECT_EQ(Sorted(expectedRadius), Sorted(foundRadius));
+        EXPECT_EQ(Sorted(expectedBox), Sorted(foundBox));
+    }
+}
+
+TEST(SpatialIndex, HugeRadiiFindEverything) {
+    IceFairy::EntityRegistry registry;
+    std::mt19937 random(11);
+    auto ids = SpawnRandom(registry, 100, random);
+
+    SpatialIndex index(4.0f);
+    index.Update(registry);
+
+    // Too many cells to count in int32_t, so these have to go to the tree
+    for (float radius : { 1e9f, 1e12f, std::numeric_limits<float>::infinity() }) {
+        std::vector<EntityId> found;
+        index.QueryRadius(Vector3f(0.0f), radius, found);
+
+        EXPECT_EQ(Sorted(ids), Sorted(found));
+    }
+}
+
+TEST(SpatialIndex, RaycastFindsClosestHit) {
+    IceFairy::EntityRegistry registry;
+    std::vector<IceFairy::PositionComponent> positions {
+        IceFairy::PositionComponent(Vector3f(10.0f, 0.0f, 0.0f)),
+        IceFairy::PositionComponent(Vector3f(5.0f, 0.0f, 0.0f)),
+        IceFairy::PositionComponent(Vector3f(5.0f, 5.0f, 0.0f))
+    };
+    auto ids = registry.AddEntities<IceFairy::PositionComponent, IceFairy::BoundsComponent>(positions.size(), positions,
+        [](size_t) { return IceFairy::BoundsComponent(Vector3f(1.0f)); });
+
+    SpatialIndex index;
+    index.Update(registry);
+
+    SpatialIndex::RayHit hit;
+    ASSERT_TRUE(index.Raycast(IceFairy::Ray3f(Vector3f(0.0f), Vector3f(1.0f, 0.0f, 0.0f)), 100.0f, hit));
+    EXPECT_EQ(ids[1], hit.entity);
+    EXPECT_FLOAT_EQ(4.0f, hit.distance);
+
+    EXPECT_FALSE(index.Raycast(IceFairy::Ray3f(Vector3f(0.0f), Vector3f(1.0f, 0.0f, 0.0f)), 3.0f, hit));
+    EXPECT_FALSE(index.Raycast(IceFairy::Ray3f(Vector3f(0.0f), Vector3f(-1.0f, 0.0f, 0.0f)), 100.0f, hit));
+}
+
+TEST(SpatialIndex, UpdateIsIncremental) {
+    IceFairy::EntityRegistry registry;
+    auto mover = registry.AddEntity();
+    mover.AddComponent<IceFairy::PositionComponent>(Vector3f(0.0f));
+    mover.AddComponent<IceFairy::BoundsComponent>(Vector3f(0.5f));
+    auto removed = registry.AddEntity();
+    removed.AddComponent<IceFairy::PositionComponent>(Vector3f(20.0f));
+    removed.AddComponent<IceFairy::BoundsComponent>(Vector3f(0.5f));
+    auto stripped = registry.AddEntity();
+    stripped.AddComponent<IceFairy::PositionComponent>(Vector3f(-20.0f));
+    stripped.AddComponent<IceFairy::BoundsComponent>(Vector3f(0.5f));
+
+    SpatialIndex index;
+    index.Update(registry);
+    EXPECT_EQ(3u, index.GetSize());
+
+    // Changed without marking it, so the index doesn't see it
+    mover.GetComponent<IceFairy::PositionComponent>().position = Vector3f(100.0f);
+    index.Update(registry);
+
+    std::vector<EntityId> found;
+    index.QueryRadius(Vector3f(100.0f), 1.0f, found);
+    EXPECT_TRUE(found.empty());
+
+    mover.MarkChanged<IceFairy::PositionComponent>();
+    removed.Destroy();
+    stripped.RemoveComponent<IceFairy::BoundsComponent>();
+    index.Update(registry);
+
+    index.QueryRadius(Vector3f(100.0f), 1.0f, found);
+    ASSERT_EQ(1u, found.size());
+    EXPECT_EQ(mover.GetId(), found[0]);
+    EXPECT_EQ(1u, index.GetSize());
+    EXPECT_FALSE(index.Contains(removed.GetId()));
+    EXPECT_FALSE(index.Contains(stripped.GetId()));
+
+    found.clear();
+    index.QueryRadius(Vector3f(0.0f), 1.0f, found);
+    EXPECT_TRUE(found.empty());
+
+    // Leaving the view and coming back between updates keeps the entity in the index
+    mover.RemoveComponent<IceFairy::BoundsComponent>();
+    mover.AddComponent<IceFairy::BoundsComponent>(Vector3f(0.5f));
+    stripped.AddComponent<IceFairy::BoundsComponent>(Vector3f(0.5f));
+    index.Update(registry);
+
+    EXPECT_EQ(2u, index.GetSize());
+    EXPECT_TRUE(index.Contains(mover.GetId()));
+    EXPECT_TRUE(index.Contains(stripped.GetId()));
+}
+
+TEST(SpatialIndex, BatchedQueriesMatchSingleQueries) {
+    IceFairy::EntityRegistry registry;
+    std::mt19937 random(11);
+    SpawnRandom(registry, 1000, random);
+
+    SpatialIndex index(4.0f);
+    index.Update(registry);
+
+    std::uniform_real_distribution<float> coordinate(-50.0f, 50.0f);
+    std::vector<SpatialIndex::RadiusQuery> queries;
+    std::vector<IceFairy::Ray3f> rays;
+    for (int i = 0; i < 500; i++) {
+        queries.push_back({ Vector3f(coordinate(random), coordinate(random), coordinate(random)), 5.0f });
+        rays.emplace_back(queries.back().centre, Vector3f(coordinate(random), coordinate(random), coordinate(random)));
+    }
+
+    IceFairy::ThreadPool pool(4);
+    SpatialIndex::QueryResults results;
+    std::vector<SpatialIndex::RayHit> hits;
+    index.QueryRadius(queries, results, &pool);
+    index.Raycast(rays, 30.0f, hits, &pool);
+
+    for (size_t i = 0; i < queries.size(); i++) {
+        std::vector<EntityId> expected;
+        index.QueryRadius(queries[i].centre, queries[i].radius, expected);
+
+        std::vector<EntityId> batched(results.GetEntities(i), results.GetEntities(i) + results.GetCount(i));
+        EXPECT_EQ(expected, batched);
+
+        SpatialIndex::RayHit hit;
+        EXPECT_EQ(index.Raycast(rays[i], 30.0f, hit), hits[i].IsHit());
+        if (hit.IsHit()) {
+            EXPECT_EQ(hit.entity, hits[i].entity);
+        }
+    }
+}
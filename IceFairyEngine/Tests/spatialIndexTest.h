@@ -0,0 +1,14 @@
+#ifndef __ice_fairy_tests_spatial_index_test_h__
+#define __ice_fairy_tests_spatial_index_test_h__
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gtest\gtest.h"
+#include "ecs\spatialindex.h"
+#include "ecs\entityregistry.h"
+
+#endif /* __ice_fairy_tests_spatial_index_test_h__ */
@@ -0,0 +1,53 @@
+#include "threadPoolTest.h"
+
+TEST(ThreadPool, ParallelForVisitsEveryIndexOnce) {
+    IceFairy::ThreadPool pool(4);
+    std::vector<std::atomic<int>> visits(10000);
+
+    pool.ParallelFor(visits.size(), 64, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            visits[i]++;
+        }
+    });
+
+    for (auto& visit : visits) {
+        EXPECT_EQ(1, visit.load());
+    }
+}
+
+TEST(ThreadPool, SerialFallback) {
+    IceFairy::ThreadPool pool(0);
+    int sum = 0;
+
+    pool.ParallelFor(100, 7, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            sum += (int) i;
+        }
+    });
+
+    EXPECT_EQ(0u, pool.GetNumWorkers());
+    EXPECT_EQ(4950, sum);
+}
+
+TEST(ThreadPool, NestedParallelFor) {
+    IceFairy::ThreadPool pool(2);
+    std::atomic<int> count(0);
+
+    pool.ParallelFor(8, 1, [&](size_t, size_t) {
+        pool.ParallelFor(8, 1, [&](size_t, size_t) {
+            count++;
+        });
+    });
+
+    EXPECT_EQ(64, count.load());
+}
+
+TEST(ThreadPool, RethrowsJobException) {
+    IceFairy::ThreadPool pool(2);
+
+    ASSERT_THROW(pool.ParallelFor(100, 1, [](size_t begin, size_t) {
+        if (begin == 50) {
+            throw std::runtime_error("failed");
+        }
+    }), std::runtime_error);
+}
@@ -0,0 +1,11 @@
+#ifndef __ice_fairy_tests_thread_pool_test_h__
+#define __ice_fairy_tests_thread_pool_test_h__
+
+#include <atomic>
+#include <vector>
+#include <stdexcept>
+
+#include "gtest\gtest.h"
+#include "core\utilities\threadpool.h"
+
+#endif /* __ice_fairy_tests_thread_pool_test_h__ */
@@ -0,0 +1,137 @@
+#include "transformHierarchyTest.h"
+
+using IceFairy::EntityId;
+using IceFairy::Matrix4f;
+
+namespace {
+    void ExpectTranslation(const Matrix4f& m, float x, float y, float z) {
+        EXPECT_FLOAT_EQ(x, m.v[12]);
+        EXPECT_FLOAT_EQ(y, m.v[13]);
+        EXPECT_FLOAT_EQ(z, m.v[14]);
+    }
+}
+
+TEST(TransformHierarchy, WorldTransformsFollowParents) {
+    IceFairy::TransformHierarchy transforms;
+    EntityId root { 0, 0 }, child { 1, 0 }, grandchild { 2, 0 };
+
+    // Added children first, so the hierarchy has to sort them behind their parents
+    transforms.Add(grandchild, Matrix4f::Translate(0.0f, 0.0f, 3.0f));
+    transforms.Add(child, Matrix4f::Translate(0.0f, 2.0f, 0.0f));
+    transforms.Add(root, Matrix4f::Translate(1.0f, 0.0f, 0.0f));
+    transforms.SetParent(grandchild, child);
+    transforms.SetParent(child, root);
+
+    transforms.Update();
+
+    EXPECT_EQ(3, transforms.GetNumLevels());
+    ExpectTranslation(transforms.GetWorld(root), 1.0f, 0.0f, 0.0f);
+    ExpectTranslation(transforms.GetWorld(child), 1.0f, 2.0f, 0.0f);
+    ExpectTranslation(transforms.GetWorld(grandchild), 1.0f, 2.0f, 3.0f);
+    EXPECT_EQ(root, transforms.GetParent(child));
+    EXPECT_FALSE(transforms.HasParent(root));
+
+    transforms.SetLocal(root, Matrix4f::Translate(5.0f, 0.0f, 0.0f));
+    transforms.Update();
+
+    ExpectTranslation(transforms.GetWorld(grandchild), 5.0f, 2.0f, 3.0f);
+}
+
+TEST(TransformHierarchy, OnlyChangedSubtreesAreRecomputed) {
+    IceFairy::TransformHierarchy transforms;
+    EntityId left { 0, 0 }, right { 1, 0 }, leftChild { 2, 0 }, rightChild { 3, 0 };
+
+    transforms.Add(left, Matrix4f::Translate(1.0f, 0.0f, 0.0f));
+    transforms.Add(right, Matrix4f::Translate(2.0f, 0.0f, 0.0f));
+    transforms.Add(leftChild, Matrix4f::Translate(0.0f, 1.0f, 0.0f));
+    transforms.Add(rightChild, Matrix4f::Translate(0.0f, 1.0f, 0.0f));
+    transforms.SetParent(leftChild, left);
+    transforms.SetParent(rightChild, right);
+    transforms.Update();
+
+    transforms.SetLocal(left, Matrix4f::Translate(3.0f, 0.0f, 0.0f));
+    transforms.Update();
+
+    ExpectTranslation(transforms.GetWorld(leftChild), 3.0f, 1.0f, 0.0f);
+    ExpectTranslation(transforms.GetWorld(rightChild), 2.0f, 1.0f, 0.0f);
+}
+
+TEST(TransformHierarchy, ReparentingAndRemoval) {
+    IceFairy::TransformHierarchy transforms;
+    EntityId a { 0, 0 }, b { 1, 0 }, c { 2, 0 };
+
+    transforms.Add(a, Matrix4f::Translate(1.0f, 0.0f, 0.0f));
+    transforms.Add(b, Matrix4f::Translate(0.0f, 1.0f, 0.0f));
+    transforms.Add(c, Matrix4f::Translate(0.0f, 0.0f, 1.0f));
+    transforms.SetParent(b, a);
+    transforms.SetParent(c, b);
+
+    ASSERT_THROW(transforms.SetParent(a, c), IceFairy::TransformHierarchyException);
+    ASSERT_THROW(transforms.SetParent(a, a), IceFairy::TransformHierarchyException);
+
+    transforms.ClearParent(c);
+    transforms.SetParent(c, a);
+    transforms.Update();
+
+    EXPECT_EQ(2, transforms.GetChildren(a).size());
+    ExpectTranslation(transforms.GetWorld(c), 1.0f, 0.0f, 1.0f);
+
+    transforms.Remove(a);
+    EXPECT_EQ(0, transforms.GetSize());
+    EXPECT_FALSE(transforms.Contains(b));
+
+    // A recycled slot with a new generation is a different entity
+    EntityId recycled { 1, 1 };
+    transforms.Add(recycled, Matrix4f::Translate(4.0f, 0.0f, 0.0f));
+    transforms.Update();
+
+    EXPECT_FALSE(transforms.Contains(b));
+    ExpectTranslation(transforms.GetWorld(recycled), 4.0f, 0.0f, 0.0f);
+}
+
+TEST(TransformHierarchy, ParallelUpdateMatchesSerial) {
+    IceFairy::TransformHierarchy serial, parallel;
+    IceFairy::ThreadPool pool(4);
+
+    // A wide tree, every node i is parented to node i / 4
+    for (uint32_t i = 0; i < 5000; i++) {
+        auto local = Matrix4f::Translate((float) (i % 7), 1.0f, (float) (i % 3));
+
+        serial.Add({ i, 0 }, local);
+        parallel.Add({ i, 0 }, local);
+
+        if (i > 0) {
+            serial.SetParent({ i, 0 }, { i / 4, 0 });
+            parallel.SetParent({ i, 0 }, { i / 4, 0 });
+        }
+    }
+
+    serial.Update();
+    parallel.Update(&pool, 64);
+
+    for (uint32_t i = 0; i < 5000; i++) {
+        for (int j = 0; j < 16; j++) {
+            EXPECT_EQ(serial.GetWorld({ i, 0 }).v[j], parallel.GetWorld({ i, 0 }).v[j]);
+        }
+    }
+}
+
+TEST(TransformHierarchy, RemovingAnEntityRemovesItsChildren) {
+    IceFairy::EntityRegistry registry;
+    auto parent = registry.AddEntity();
+    auto child = registry.AddEntity();
+    auto other = registry.AddEntity();
+
+    auto& transforms = registry.GetTransforms();
+    transforms.Add(parent.GetId());
+    transforms.Add(child.GetId(), Matrix4f::Translate(0.0f, 1.0f, 0.0f));
+    transforms.Add(other.GetId());
+    transforms.SetParent(child.GetId(), parent.GetId());
+    registry.UpdateTransforms();
+
+    parent.Destroy();
+
+    EXPECT_FALSE(child.IsAlive());
+    EXPECT_TRUE(other.IsAlive());
+    EXPECT_EQ(1, transforms.GetSize());
+}
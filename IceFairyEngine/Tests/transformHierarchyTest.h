@@ -0,0 +1,10 @@
+#ifndef __ice_fairy_tests_transform_hierarchy_test_h__
+#define __ice_fairy_tests_transform_hierarchy_test_h__
+
+#include <vector>
+
+#include "gtest\gtest.h"
+#include "ecs\entityregistry.h"
+#include "ecs\transformhierarchy.h"
+
+#endif /* __ice_fairy_tests_transform_hierarchy_test_h__ */
@@ -164,6 +164,24 @@ TEST(Vector3Math, BilinearInterpolate) {
     V3M_FuzzyFloatMatch(IceFairy::Vector3f(1.0f, 0.5f, 0.0f), result);
 }
 
+TEST(Vector3Math, ConstantExpressions) {
+    constexpr IceFairy::Vector3f x(1.0f, 0.0f, 0.0f);
+    constexpr IceFairy::Vector3f y(0.0f, 1.0f, 0.0f);
+    constexpr IceFairy::Vector3f z = x.Cross(y);
+
+    static_assert(z == IceFairy::Vector3f(0.0f, 0.0f, 1.0f), "Cross should fold at compile time");
+    static_assert((x + y * 2.0f).Dot(y) == 2.0f, "Dot should fold at compile time");
+    static_assert(x.Interpolate(y, 0.5f) == IceFairy::Vector3f(0.5f, 0.5f, 0.0f), "Interpolate should fold at compile time");
+    static_assert(IceFairy::Vector4f(z, 1.0f).ToVector3().ToVector2() == IceFairy::Vector2f(0.0f, 0.0f), "Conversions should fold at compile time");
+
+    // Lets components holding vectors be copied with memcpy
+    static_assert(std::is_trivially_copyable<IceFairy::Vector2f>::value, "Vector2 should be trivially copyable");
+    static_assert(std::is_trivially_copyable<IceFairy::Vector3f>::value, "Vector3 should be trivially copyable");
+    static_assert(std::is_trivially_copyable<IceFairy::Vector4f>::value, "Vector4 should be trivially copyable");
+
+    EXPECT_EQ(IceFairy::Vector3f(0.0f, 0.0f, 1.0f), z);
+}
+
 TEST(Ray3Math, Position) {
     IceFairy::Vector3f origin(1.0f, 1.0f, 1.0f);
     IceFairy::Vector3f direction(0.0f, 2.0f, 0.0f);
@@ -0,0 +1,179 @@
+#include "worldSnapshotTest.h"
+
+using IceFairy::Matrix4f;
+
+namespace {
+    std::string GetSnapshotPath(const std::string& name) {
+        return testing::TempDir() + name;
+    }
+
+    void SetNameSerializer(void) {
+        IceFairy::ComponentTypes::SetSerializer<NameComponent>(
+            [](const NameComponent& component, std::vector<unsigned char>& buffer) {
+                buffer.insert(buffer.end(), component.name.begin(), component.name.end());
+            },
+            [](const unsigned char* data, size_t size) {
+                return NameComponent(std::string(reinterpret_cast<const char*>(data), size));
+            });
+    }
+}
+
+TEST(WorldSnapshot, SaveAndLoad) {
+    SetNameSerializer();
+
+    IceFairy::EntityRegistry registry;
+    std::vector<IceFairy::EntityId> ids;
+
+    for (int i = 0; i < 300; i++) {
+        auto entity = registry.AddEntity();
+        entity.AddComponent<PositionComponent>((float) i, (float) -i);
+
+        if (i % 2 == 0) {
+            entity.AddComponent<VelocityComponent>(1.0f, (float) i);
+        }
+
+        if (i % 3 == 0) {
+            entity.AddComponent<NameComponent>("entity " + std::to_string(i));
+        }
+
+        if (i % 5 == 0) {
+            entity.AddComponent<DeadTag>();
+        }
+
+        ids.push_back(entity.GetId());
+    }
+
+    registry.RemoveEntity(ids[7]);
+    registry.AddEntity();
+
+    auto& transforms = registry.GetTransforms();
+    transforms.Add(ids[0], Matrix4f::Translate(1.0f, 0.0f, 0.0f));
+    transforms.Add(ids[1], Matrix4f::Translate(0.0f, 2.0f, 0.0f));
+    transforms.SetParent(ids[1], ids[0]);
+
+    auto path = GetSnapshotPath("snapshot.world");
+    IceFairy::WorldSnapshot::Save(registry, path);
+
+    IceFairy::EntityRegistry loaded;
+    IceFairy::WorldSnapshot::Load(loaded, path);
+
+    EXPECT_EQ(registry.GetEntityCount(), loaded.GetEntityCount());
+    EXPECT_FALSE(loaded.IsAlive(ids[7]));
+
+    for (int i = 0; i < 300; i++) {
+        if (i == 7) {
+            continue;
+        }
+
+        auto entity = loaded.GetEntity(ids[i]);
+        EXPECT_EQ((float) i, entity.GetComponent<PositionComponent>().x);
+        EXPECT_EQ(i % 2 == 0, entity.HasComponent<VelocityComponent>());
+        EXPECT_EQ(i % 5 == 0, entity.HasComponent<DeadTag>());
+
+        if (i % 3 == 0) {
+            EXPECT_EQ("entity " + std::to_string(i), entity.GetComponent<NameComponent>().name);
+        }
+    }
+
+    auto movers = loaded.View<PositionComponent, VelocityComponent>();
+    EXPECT_EQ(150, movers.GetSize());
+
+    loaded.UpdateTransforms();
+    EXPECT_EQ(ids[0], loaded.GetTransforms().GetParent(ids[1]));
+    EXPECT_FLOAT_EQ(1.0f, loaded.GetTransforms().GetWorld(ids[1]).v[12]);
+    EXPECT_FLOAT_EQ(2.0f, loaded.GetTransforms().GetWorld(ids[1]).v[13]);
+
+    // Freed slots are reused in the same order as in the original registry
+    EXPECT_EQ(registry.AddEntity().GetId(), loaded.AddEntity().GetId());
+}
+
+TEST(WorldSnapshot, EngineComponentsAreCopiedDirectly) {
+    // Hold math types, which must stay trivially copyable for the snapshot to blit them
+    static_assert(std::is_trivially_copyable<IceFairy::PositionComponent>::value, "PositionComponent should be trivially copyable");
+    static_assert(std::is_trivially_copyable<IceFairy::BoundsComponent>::value, "BoundsComponent should be trivially copyable");
+
+    IceFairy::EntityRegistry registry;
+    std::vector<IceFairy::EntityId> ids;
+
+    for (int i = 0; i < 100; i++) {
+        auto entity = registry.AddEntity();
+        entity.AddComponent<IceFairy::PositionComponent>(IceFairy::Vector3f((float) i, 1.0f, -2.0f));
+        entity.AddComponent<IceFairy::BoundsComponent>(IceFairy::Vector3f(0.5f * i));
+        ids.push_back(entity.GetId());
+    }
+
+    auto path = GetSnapshotPath("engine_components.world");
+    IceFairy::WorldSnapshot::Save(registry, path);
+
+    IceFairy::EntityRegistry loaded;
+    IceFairy::WorldSnapshot::Load(loaded, path);
+
+    for (int i = 0; i < 100; i++) {
+        auto entity = loaded.GetEntity(ids[i]);
+        EXPECT_EQ(IceFairy::Vector3f((float) i, 1.0f, -2.0f), entity.GetComponent<IceFairy::PositionComponent>().position);
+        EXPECT_EQ(IceFairy::Vector3f(0.5f * i), entity.GetComponent<IceFairy::BoundsComponent>().halfExtents);
+    }
+}
+
+TEST(WorldSnapshot, RejectsInvalidFiles) {
+    IceFairy::EntityRegistry registry;
+    auto path = GetSnapshotPath("invalid.world");
+
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "definitely not a snapshot, but long enough to hold a header";
+    }
+
+    ASSERT_THROW(IceFairy::WorldSnapshot::Load(registry, path), IceFairy::WorldSnapshotException);
+    ASSERT_THROW(IceFairy::WorldSnapshot::Load(registry, GetSnapshotPath("missing.world")), IceFairy::ICException);
+
+    registry.AddEntity();
+    IceFairy::WorldSnapshot::Save(registry, path);
+    ASSERT_THROW(IceFairy::WorldSnapshot::Load(registry, path), IceFairy::WorldSnapshotException);
+}
+
+TEST(WorldSnapshot, ComponentsWithoutSerializersCantBeSaved) {
+    IceFairy::EntityRegistry registry;
+    registry.AddEntity().AddComponent<WaypointsComponent>(std::vector<int> { 1, 2, 3 });
+
+    ASSERT_THROW(IceFairy::WorldSnapshot::Save(registry, GetSnapshotPath("waypoints.world")),
+        IceFairy::WorldSnapshotException);
+}
+
+TEST(WorldSnapshot, TruncatedFilesLeaveTheRegistryEmpty) {
+    IceFairy::EntityRegistry registry;
+    IceFairy::EntityId last { 0, 0 };
+
+    for (int i = 0; i < 1000; i++) {
+        auto entity = registry.AddEntity();
+        entity.AddComponent<PositionComponent>((float) i, 0.0f);
+        last = entity.GetId();
+    }
+
+    auto path = GetSnapshotPath("truncated.world");
+    IceFairy::WorldSnapshot::Save(registry, path);
+
+    std::vector<char> bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+
+    IceFairy::EntityRegistry loaded;
+    auto truncatedPath = GetSnapshotPath("truncated_part.world");
+
+    // Cut at every block of the file, including part way through the position column
+    for (size_t size = 1; size < bytes.size(); size += 997) {
+        {
+            std::ofstream out(truncatedPath, std::ios::binary | std::ios::trunc);
+            out.write(bytes.data(), size);
+        }
+
+        ASSERT_THROW(IceFairy::WorldSnapshot::Load(loaded, truncatedPath), IceFairy::WorldSnapshotException);
+        ASSERT_EQ(0, loaded.GetEntityCount());
+    }
+
+    IceFairy::WorldSnapshot::Load(loaded, path);
+    ASSERT_EQ(1000, loaded.GetEntityCount());
+    EXPECT_EQ(999.0f, loaded.GetEntity(last).GetComponent<PositionComponent>().x);
+}
@@ -0,0 +1,22 @@
+#ifndef __ice_fairy_tests_world_snapshot_test_h__
+#define __ice_fairy_tests_world_snapshot_test_h__
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <type_traits>
+
+#include "gtest\gtest.h"
+#include "ecs\entityregistry.h"
+#include "ecs\worldsnapshot.h"
+#include "ecs\components\positioncomponent.h"
+#include "ecs\components\boundscomponent.h"
+#include "entityRegistryTest.h"
+
+struct WaypointsComponent : public IceFairy::Component {
+    WaypointsComponent(const std::vector<int>& waypoints) : waypoints(waypoints) { }
+
+    std::vector<int> waypoints;
+};
+
+#endif /* __ice_fairy_tests_world_snapshot_test_h__ */
@@ -64,44 +64,36 @@ public:
 		module->SetWindowWidth(800);
 		module->SetWindowHeight(600);
 
-		auto entity1 = this->GetEntityRegistry()->AddEntity();
-		auto entity2 = this->GetEntityRegistry()->AddEntity();
-
-		entity1->AddComponent<IceFairy::VertexObjectComponent>(
-			std::vector<unsigned int> {
-			0, 1, 2, 2, 3, 0,
-				4, 5, 6, 6, 7, 4
-		},
-			std::vector<IceFairy::Vertex> {
-				{ {-0.5f, -0.5f, 0.0f}, { 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f }},
-				{ {0.5f, -0.5f, 0.0f}, {0.0f, 1.0f, 0.0f}, {1.0f, 0.0f} },
-				{ {0.5f, 0.5f, 0.0f}, {0.0f, 0.0f, 1.0f}, {1.0f, 1.0f} },
-				{ {-0.5f, 0.5f, 0.0f}, {1.0f, 1.0f, 1.0f}, {0.0f, 1.0f} },
-
-				{ {-0.5f, -0.5f, -0.5f}, {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f} },
-				{ {0.5f, -0.5f, -0.5f}, {0.0f, 1.0f, 0.0f}, {1.0f, 0.0f} },
-				{ {0.5f, 0.5f, -0.5f}, {0.0f, 0.0f, 1.0f}, {1.0f, 1.0f} },
-				{ {-0.5f, 0.5f, -0.5f}, {1.0f, 1.0f, 1.0f}, {0.0f, 1.0f} }
-			}
-			);
-
-		entity2->AddComponent<IceFairy::VertexObjectComponent>(
-			std::vector<unsigned int> {
+		std::vector<unsigned int> indices {
 			0, 1, 2, 2, 3, 0,
-				4, 5, 6, 6, 7, 4
-		},
-			std::vector<IceFairy::Vertex> {
-				{ {-0.5f, -0.5f, 0.5f}, { 1.0f, 0.0f, 0.0f }, { 0.0f, 0.0f }},
-				{ {0.5f, -0.5f, 0.5f}, {0.0f, 1.0f, 0.0f}, {1.0f, 0.0f} },
-				{ {0.5f, 0.5f, 0.5f}, {0.0f, 0.0f, 1.0f}, {1.0f, 1.0f} },
-				{ {-0.5f, 0.5f, 0.5f}, {1.0f, 1.0f, 1.0f}, {0.0f, 1.0f} },
-
-				{ {-0.5f, -0.5f, -1.0f}, {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f} },
-				{ {0.5f, -0.5f, -1.0f}, {0.0f, 1.0f, 0.0f}, {1.0f, 0.0f} },
-				{ {0.5f, 0.5f, -1.0f}, {0.0f, 0.0f, 1.0f}, {1.0f, 1.0f} },
-				{ {-0.5f, 0.5f, -1.0f}, {1.0f, 1.0f, 1.0f}, {0.0f, 1.0f} }
-			}
+			4, 5, 6, 6, 7, 4
+		};
+
+		// The front and back z of each entity's pair of quads, so no two quads share a depth
+		const float depths[2][2] = {
+			{ 0.0f, -0.5f },
+			{ 0.5f, -1.0f }
+		};
+
+		this->GetEntityRegistry()->AddEntities<IceFairy::VertexObjectComponent>(2, [&indices, &depths](size_t i) {
+			float front = depths[i][0];
+			float back = depths[i][1];
+
+			return IceFairy::VertexObjectComponent(
+				indices,
+				std::vector<IceFairy::Vertex> {
+					{ {-0.5f, -0.5f, front}, {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f} },
+					{ {0.5f, -0.5f, front}, {0.0f, 1.0f, 0.0f}, {1.0f, 0.0f} },
+					{ {0.5f, 0.5f, front}, {0.0f, 0.0f, 1.0f}, {1.0f, 1.0f} },
+					{ {-0.5f, 0.5f, front}, {1.0f, 1.0f, 1.0f}, {0.0f, 1.0f} },
+
+					{ {-0.5f, -0.5f, back}, {1.0f, 0.0f, 0.0f}, {0.0f, 0.0f} },
+					{ {0.5f, -0.5f, back}, {0.0f, 1.0f, 0.0f}, {1.0f, 0.0f} },
+					{ {0.5f, 0.5f, back}, {0.0f, 0.0f, 1.0f}, {1.0f, 1.0f} },
+					{ {-0.5f, 0.5f, back}, {1.0f, 1.0f, 1.0f}, {0.0f, 1.0f} }
+				}
 			);
+		});
 
 		Application::Initialise();
 